@@ -74,6 +74,25 @@ NBFMOptionsView::NBFMOptionsView(
 	};
 }
 
+/* WFMOptionsView ********************************************************/
+
+WFMOptionsView::WFMOptionsView(
+	const Rect parent_rect, const Style* const style
+) : View { parent_rect }
+{
+	set_style(style);
+
+	add_children({
+		&label_config,
+		&options_config,
+	});
+
+	options_config.set_selected_index(receiver_model.wfm_configuration());
+	options_config.on_change = [this](size_t n, OptionsField::value_t) {
+		receiver_model.set_wfm_configuration(n);
+	};
+}
+
 /* AnalogAudioView *******************************************************/
 
 AnalogAudioView::AnalogAudioView(
@@ -245,6 +264,10 @@ void AnalogAudioView::on_show_options_modulation() {
 		widget = std::make_unique<NBFMOptionsView>(options_view_rect, &style_options_group);
 		break;
 
+	case ReceiverModel::Mode::WidebandFMAudio:
+		widget = std::make_unique<WFMOptionsView>(options_view_rect, &style_options_group);
+		break;
+
 	default:
 		break;
 	}
@@ -80,6 +80,26 @@ private:
 	};
 };
 
+class WFMOptionsView : public View {
+public:
+	WFMOptionsView(const Rect parent_rect, const Style* const style);
+
+private:
+	Text label_config {
+		{ 0 * 8, 0 * 16, 8 * 8, 1 * 16 },
+		"Spectrum",
+	};
+
+	OptionsField options_config {
+		{ 9 * 8, 0 * 16 },
+		4,
+		{
+			{ "RF  ", 0 },
+			{ "MPX ", 0 },
+		}
+	};
+};
+
 class AnalogAudioView : public View {
 public:
 	AnalogAudioView(NavigationView& nav);
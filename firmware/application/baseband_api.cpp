@@ -30,12 +30,53 @@
 
 namespace baseband {
 
-static void send_message(const Message* const message) {
-	// If message is only sent by this function via one thread, no need to check if
-	// another message is present before setting new message.
-	shared_memory.baseband_message = message;
-	creg::m0apptxevent::assert();
-	while(shared_memory.baseband_message);
+/* Signalled (reset) from the M4 interrupt whenever the baseband has made
+ * progress. Waiters recheck what they're waiting for each time.
+ */
+static SEMAPHORE_DECL(sem_progress, 0);
+
+void progress_isr() {
+	if( chSemGetCounterI(&sem_progress) < 0 ) {
+		chSemResetI(&sem_progress, 0);
+	}
+}
+
+template<typename Predicate>
+static void wait_until(Predicate done) {
+	chSysLock();
+	while( !done() ) {
+		chSemWaitS(&sem_progress);
+	}
+	chSysUnlock();
+}
+
+/* Queues a copy of the message and returns without waiting for the
+ * baseband, unless the queue is full. Returns the queue position to pass to
+ * wait_for_message().
+ */
+template<typename T>
+static size_t send_message(const T& message) {
+	chSysLock();
+	while( !shared_memory.baseband_queue.pushS(message) ) {
+		chSemWaitS(&sem_progress);
+	}
+	const auto position = shared_memory.baseband_queue.position();
+	chSysUnlock();
+	return position;
+}
+
+static void wait_for_message(const size_t position) {
+	wait_until([position]() {
+		return shared_memory.baseband_queue.is_handled(position);
+	});
+}
+
+/* For messages pointing at something the baseband must be done with, or
+ * must have filled in, before the caller carries on.
+ */
+template<typename T>
+static void send_message_and_wait(const T& message) {
+	wait_for_message(send_message(message));
 }
 
 void AMConfig::apply() const {
@@ -47,7 +88,7 @@ void AMConfig::apply() const {
 		modulation,
 		audio_12k_hpf_300hz_config
 	};
-	send_message(&message);
+	send_message(message);
 	audio::set_rate(audio::Rate::Hz_12000);
 }
 
@@ -61,7 +102,7 @@ void NBFMConfig::apply() const {
 		audio_24k_hpf_300hz_config,
 		audio_24k_deemph_300_6_config
 	};
-	send_message(&message);
+	send_message(message);
 	audio::set_rate(audio::Rate::Hz_24000);
 }
 
@@ -72,14 +113,33 @@ void WFMConfig::apply() const {
 		taps_64_lp_156_198,
 		75000,
 		audio_48k_hpf_30hz_config,
-		audio_48k_deemph_2122_6_config
+		audio_48k_deemph_2122_6_config,
+		spectrum
 	};
-	send_message(&message);
+	send_message(message);
 	audio::set_rate(audio::Rate::Hz_48000);
 }
 
+void WidebandSpectrumConfig::apply() const {
+	const WidebandSpectrumConfigMessage message {
+		overlap,
+		averaging
+	};
+	send_message(message);
+}
+
 static bool baseband_image_running = false;
 
+/* Packet decoders can deliver bursts faster than a busy UI takes them. */
+static size_t application_queue_k(const portapack::spi_flash::image_tag_t image_tag) {
+	if( (image_tag == portapack::spi_flash::image_tag_ais) ||
+		(image_tag == portapack::spi_flash::image_tag_ert) ||
+		(image_tag == portapack::spi_flash::image_tag_tpms) ) {
+		return SharedMemory::application_queue_k_max;
+	}
+	return SharedMemory::application_queue_k;
+}
+
 void run_image(const portapack::spi_flash::image_tag_t image_tag) {
 	if( baseband_image_running ) {
 		chDbgPanic("BBRunning");
@@ -87,6 +147,10 @@ void run_image(const portapack::spi_flash::image_tag_t image_tag) {
 
 	creg::m4txevent::clear();
 
+	shared_memory.application_queue.reset(application_queue_k(image_tag));
+	shared_memory.baseband_queue.reset(SharedMemory::baseband_queue_k);
+	shared_memory.m4_halted = false;
+
 	m4_init(image_tag, portapack::memory::map::m4_code);
 	baseband_image_running = true;
 
@@ -98,10 +162,13 @@ void shutdown() {
 		return;
 	}
 
-	creg::m4txevent::disable();
-
 	ShutdownMessage message;
-	send_message(&message);
+	send_message(message);
+	wait_until([]() {
+		return shared_memory.m4_halted;
+	});
+
+	creg::m4txevent::disable();
 
 	shared_memory.application_queue.reset();
 	
@@ -112,24 +179,44 @@ void spectrum_streaming_start() {
 	SpectrumStreamingConfigMessage message {
 		SpectrumStreamingConfigMessage::Mode::Running
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void spectrum_streaming_stop() {
 	SpectrumStreamingConfigMessage message {
 		SpectrumStreamingConfigMessage::Mode::Stopped
 	};
-	send_message(&message);
+	send_message(message);
 }
 
 void capture_start(CaptureConfig* const config) {
 	CaptureConfigMessage message { config };
-	send_message(&message);
+	send_message_and_wait(message);
 }
 
 void capture_stop() {
 	CaptureConfigMessage message { nullptr };
-	send_message(&message);
+	send_message_and_wait(message);
+}
+
+void replay_start(ReplayConfig* const config) {
+	ReplayConfigMessage message { config };
+	send_message_and_wait(message);
+}
+
+void replay_stop() {
+	ReplayConfigMessage message { nullptr };
+	send_message_and_wait(message);
+}
+
+void stage_statistics_start() {
+	StageStatisticsConfigMessage message { true };
+	send_message(message);
+}
+
+void stage_statistics_stop() {
+	StageStatisticsConfigMessage message { false };
+	send_message(message);
 }
 
 } /* namespace baseband */
@@ -49,18 +49,36 @@ struct NBFMConfig {
 };
 
 struct WFMConfig {
+	const WFMConfigureMessage::Spectrum spectrum;
+
+	void apply() const;
+};
+
+struct WidebandSpectrumConfig {
+	const WidebandSpectrumConfigMessage::Overlap overlap;
+	const WidebandSpectrumConfigMessage::Averaging averaging;
+
 	void apply() const;
 };
 
 void run_image(const portapack::spi_flash::image_tag_t image_tag);
 void shutdown();
 
+/* Call from the M4 core interrupt, with the system locked. */
+void progress_isr();
+
 void spectrum_streaming_start();
 void spectrum_streaming_stop();
 
 void capture_start(CaptureConfig* const config);
 void capture_stop();
 
+void replay_start(ReplayConfig* const config);
+void replay_stop();
+
+void stage_statistics_start();
+void stage_statistics_stop();
+
 } /* namespace baseband */
 
 #endif/*__BASEBAND_API_H__*/
@@ -43,6 +43,7 @@ CaptureAppView::CaptureAppView(NavigationView& nav) {
 		&field_lna,
 		&field_vga,
 		&record_view,
+		&options_format,
 		&waterfall,
 	});
 
@@ -66,17 +67,26 @@ CaptureAppView::CaptureAppView(NavigationView& nav) {
 		this->field_frequency.set_step(v);
 	};
 
+	const auto& format = formats[format_index];
 	radio::enable({
 		tuning_frequency(),
-		sampling_rate,
-		baseband_bandwidth,
+		format.sampling_rate,
+		format.baseband_bandwidth,
 		rf::Direction::Receive,
 		receiver_model.rf_amp(),
 		static_cast<int8_t>(receiver_model.lna()),
 		static_cast<int8_t>(receiver_model.vga()),
 	});
 
-	record_view.set_sampling_rate(sampling_rate / 8);
+	OptionsField::options_t format_options;
+	for(size_t i=0; i<formats.size(); i++) {
+		format_options.emplace_back(formats[i].name, i);
+	}
+	options_format.set_options(format_options);
+	options_format.on_change = [this](size_t, OptionsField::value_t v) {
+		this->set_capture_format(v);
+	};
+	set_capture_format(0);
 	record_view.on_error = [&nav](std::string message) {
 		nav.display_modal("Error", message);
 	};
@@ -119,8 +129,21 @@ rf::Frequency CaptureAppView::target_frequency() const {
 	return persistent_memory::tuned_frequency();
 }
 
+void CaptureAppView::set_capture_format(const size_t index) {
+	format_index = index;
+	const auto& format = formats[format_index];
+
+	record_view.set_file_type(format.file_type, format.decimation);
+	record_view.set_sampling_rate(format.sampling_rate / format.decimation);
+
+	radio::set_baseband_rate(format.sampling_rate);
+	radio::set_baseband_filter_bandwidth(format.baseband_bandwidth);
+	radio::set_tuning_frequency(tuning_frequency());
+}
+
 rf::Frequency CaptureAppView::tuning_frequency() const {
-	return target_frequency() - (sampling_rate / 4);
+	const auto& format = formats[format_index];
+	return target_frequency() - (format.offset_tuning ? (format.sampling_rate / 4) : 0);
 }
 
 } /* namespace ui */
@@ -30,6 +30,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace ui {
 
@@ -47,10 +48,36 @@ public:
 	std::string title() const override { return "Capture"; };
 
 private:
-	static constexpr ui::Dim header_height = 2 * 16;
+	static constexpr ui::Dim header_height = 3 * 16;
+
+	/* The radio's settings for a capture, and what is recorded. Raw C8 at
+	 * a decoder's rate, bandwidth and tuning replays into that decoder.
+	 */
+	struct Format {
+		std::string name;
+		RecordView::FileType file_type;
+		uint32_t sampling_rate;
+		uint32_t baseband_bandwidth;
+		size_t decimation;
+		/* Tuned fs/4 below the target, as the channel and most decoders
+		 * expect.
+		 */
+		bool offset_tuning;
+	};
+
+	const std::vector<Format> formats {
+		{ "Channel  500k", RecordView::FileType::RawS16,           4000000, 2500000, 8, true  },
+		{ "Chan Z16 500k", RecordView::FileType::RawS16Compressed, 4000000, 2500000, 8, true  },
+		{ "Raw C8     4M", RecordView::FileType::RawS8,            4000000, 2500000, 1, true  },
+		{ "Raw C8     2M", RecordView::FileType::RawS8,            4000000, 2500000, 2, true  },
+		{ "Raw C8     1M", RecordView::FileType::RawS8,            4000000, 2500000, 4, true  },
+		{ "Raw C8   500k", RecordView::FileType::RawS8,            4000000, 2500000, 8, true  },
+		{ "C8 AIS/TPMS",   RecordView::FileType::RawS8,            2457600, 1750000, 1, true  },
+		{ "C8 ERT",        RecordView::FileType::RawS8,            4194304, 2500000, 1, false },
+		{ "C8 NFM",        RecordView::FileType::RawS8,            3072000, 1750000, 1, true  },
+	};
 
-	static constexpr uint32_t sampling_rate = 4000000;
-	static constexpr uint32_t baseband_bandwidth = 2500000;
+	size_t format_index { 0 };
 
 	void on_target_frequency_changed(rf::Frequency f);
 
@@ -59,6 +86,8 @@ private:
 
 	rf::Frequency tuning_frequency() const;
 
+	void set_capture_format(const size_t index);
+
 	RSSI rssi {
 		{ 24 * 8, 0, 6 * 8, 4 },
 	};
@@ -92,6 +121,13 @@ private:
 		u"BBD_????", RecordView::FileType::RawS16, 16384, 3
 	};
 
+	/* Values index formats. */
+	OptionsField options_format {
+		{ 0 * 8, 2 * 16 },
+		13,
+		{ }
+	};
+
 	spectrum::WaterfallWidget waterfall { };
 };
 
@@ -24,6 +24,8 @@
 #include "baseband_api.hpp"
 #include "buffer_exchange.hpp"
 
+#include "hal.h"
+
 struct BasebandCapture {
 	BasebandCapture(CaptureConfig* const config) {
 		baseband::capture_start(config);
@@ -38,12 +40,17 @@ struct BasebandCapture {
 
 CaptureThread::CaptureThread(
 	std::unique_ptr<stream::Writer> writer,
+	std::unique_ptr<stream::Writer> index_writer,
 	size_t write_size,
 	size_t buffer_count,
+	CaptureConfig::Format format,
+	size_t decimation,
+	uint32_t sampling_rate,
 	std::function<void()> success_callback,
 	std::function<void(File::Error)> error_callback
-) : config { write_size, buffer_count },
+) : config { write_size, buffer_count, format, decimation, sampling_rate },
 	writer { std::move(writer) },
+	index_writer { std::move(index_writer) },
 	success_callback { std::move(success_callback) },
 	error_callback { std::move(error_callback) }
 {
@@ -73,18 +80,55 @@ msg_t CaptureThread::static_fn(void* arg) {
 }
 
 Optional<File::Error> CaptureThread::run() {
-	BasebandCapture capture { &config };
-	BufferExchange buffers { &config };
-
-	while( !chThdShouldTerminate() ) {
-		auto buffer = buffers.get();
-		auto write_result = writer->write(buffer->data(), buffer->size());
-		if( write_result.is_error() ) {
-			return write_result.error();
+	capture_index::Tracker index;
+
+	/* Before the baseband starts, so slow setup doesn't drop samples. */
+	const auto prepare_error = writer->prepare();
+	if( prepare_error.is_valid() ) {
+		return prepare_error;
+	}
+
+	{
+		BasebandCapture capture { &config };
+		BufferExchange buffers { &config };
+
+		while( !chThdShouldTerminate() ) {
+			auto buffer = buffers.get();
+
+			const auto timestamp = buffer->timestamp();
+			capture_index::Record record;
+			if( index.buffer(buffer->sequence(), timestamp.tv_date, timestamp.tv_time, buffer->stream_offset(), buffer->size(), record) ) {
+				const auto index_error = write_index_record(record);
+				if( index_error.is_valid() ) {
+					return index_error;
+				}
+			}
+
+			auto write_result = writer->write(buffer->data(), buffer->size());
+			if( write_result.is_error() ) {
+				return write_result.error();
+			}
+			buffer->empty();
+			buffers.put(buffer);
 		}
-		buffer->empty();
-		buffers.put(buffer);
 	}
 
+	/* The baseband has stopped, so the count of bytes it produced is final.
+	 * Those in buffers not written are lost with the capture's end.
+	 */
+	Timestamp now;
+	rtcGetTime(&RTCD1, &now);
+	return write_index_record(index.end(now.tv_date, now.tv_time, config.baseband_bytes_received));
+}
+
+Optional<File::Error> CaptureThread::write_index_record(const capture_index::Record& record) {
+	if( !index_writer ) {
+		return { };
+	}
+
+	auto write_result = index_writer->write(&record, sizeof(record));
+	if( write_result.is_error() ) {
+		return write_result.error();
+	}
 	return { };
 }
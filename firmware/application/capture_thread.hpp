@@ -28,6 +28,7 @@
 
 #include "io.hpp"
 #include "optional.hpp"
+#include "capture_index.hpp"
 
 #include <cstdint>
 #include <cstddef>
@@ -35,10 +36,17 @@
 
 class CaptureThread {
 public:
+	/* index_writer, if given, gets capture_index records saying where
+	 * samples were dropped. Its header is the caller's to write.
+	 */
 	CaptureThread(
 		std::unique_ptr<stream::Writer> writer,
+		std::unique_ptr<stream::Writer> index_writer,
 		size_t write_size,
 		size_t buffer_count,
+		CaptureConfig::Format format,
+		size_t decimation,
+		uint32_t sampling_rate,
 		std::function<void()> success_callback,
 		std::function<void(File::Error)> error_callback
 	);
@@ -56,6 +64,7 @@ public:
 private:
 	CaptureConfig config;
 	std::unique_ptr<stream::Writer> writer;
+	std::unique_ptr<stream::Writer> index_writer;
 	std::function<void()> success_callback;
 	std::function<void(File::Error)> error_callback;
 	Thread* thread { nullptr };
@@ -63,6 +72,7 @@ private:
 	static msg_t static_fn(void* arg);
 
 	Optional<File::Error> run();
+	Optional<File::Error> write_index_record(const capture_index::Record& record);
 };
 
 #endif/*__CAPTURE_THREAD_H__*/
@@ -32,6 +32,7 @@
 #include "irq_controls.hpp"
 
 #include "buffer_exchange.hpp"
+#include "baseband_api.hpp"
 
 #include "ch.h"
 
@@ -50,6 +51,7 @@ CH_IRQ_HANDLER(M4Core_IRQHandler) {
 	chSysLockFromIsr();
 	BufferExchange::handle_isr();
 	EventDispatcher::check_fifo_isr();
+	baseband::progress_isr();
 	chSysUnlockFromIsr();
 
 	creg::m4txevent::clear();
@@ -22,6 +22,7 @@
 #include "file.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <locale>
 #include <codecvt>
 
@@ -119,6 +120,28 @@ Optional<File::Error> File::sync() {
 	}
 }
 
+Optional<File::Error> File::expand(const Size size) {
+	if( size > std::numeric_limits<FSIZE_t>::max() ) {
+		return { FR_INVALID_PARAMETER };
+	}
+
+	const auto result = f_expand(&f, size, 1);
+	if( result == FR_OK ) {
+		return { };
+	} else {
+		return { result };
+	}
+}
+
+Optional<File::Error> File::truncate() {
+	const auto result = f_truncate(&f);
+	if( result == FR_OK ) {
+		return { };
+	} else {
+		return { result };
+	}
+}
+
 static std::filesystem::path find_last_file_matching_pattern(const std::filesystem::path& pattern) {
 	std::filesystem::path last_match;
 	for(const auto& entry : std::filesystem::directory_iterator(u"", pattern)) {
@@ -326,6 +326,15 @@ public:
 	// TODO: Return Result<>.
 	Optional<Error> sync();
 
+	/* Allocates a contiguous run of clusters for size bytes to an empty file,
+	 * so writes into it don't allocate. The file is that long until
+	 * truncate().
+	 */
+	Optional<Error> expand(const Size size);
+
+	/* Ends the file at the current position, freeing any clusters past it. */
+	Optional<Error> truncate();
+
 private:
 	FIL f { };
 
@@ -33,6 +33,13 @@ public:
 
 class Writer {
 public:
+	/* Called once, on the thread that writes, before the first write(). For
+	 * setup too slow to do where the writer is created.
+	 */
+	virtual Optional<File::Error> prepare() {
+		return { };
+	}
+
 	virtual File::Result<File::Size> write(const void* const buffer, const File::Size bytes) = 0;
 	virtual ~Writer() = default;
 };
@@ -28,3 +28,40 @@ File::Result<File::Size> FileWriter::write(const void* const buffer, const File:
 	}
 	return write_result;
 }
+
+RawFileWriter::~RawFileWriter() {
+	if( preallocated_size_ ) {
+		file.truncate();
+	}
+}
+
+Optional<File::Error> RawFileWriter::create(
+	const std::filesystem::path& filename,
+	const File::Size preallocate_size
+) {
+	preallocate_size_ = preallocate_size;
+	return FileWriter::create(filename);
+}
+
+Optional<File::Error> RawFileWriter::prepare() {
+	/* Failing to find a free run isn't an error, the file just grows as
+	 * it's written.
+	 */
+	auto size = preallocate_size_;
+	for(size_t i=0; (i<preallocate_attempts_max) && (size >= preallocate_size_min); i++, size /= 2) {
+		if( !file.expand(size).is_valid() ) {
+			preallocated_size_ = size;
+			break;
+		}
+	}
+
+	return { };
+}
+
+File::Result<File::Size> FileReader::read(void* const buffer, const File::Size bytes) {
+	auto read_result = file.read(buffer, bytes);
+	if( read_result.is_ok() ) {
+		bytes_read += read_result.value();
+	}
+	return read_result;
+}
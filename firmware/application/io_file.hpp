@@ -48,4 +48,65 @@ protected:
 	uint64_t bytes_written { 0 };
 };
 
-using RawFileWriter = FileWriter;
+/* Writes into clusters allocated contiguously when the file is created, so
+ * long captures don't stall on cluster allocation and FAT updates. The file
+ * is cut back to what was written when the writer is destroyed.
+ */
+class RawFileWriter : public FileWriter {
+public:
+	RawFileWriter() = default;
+
+	RawFileWriter(const RawFileWriter&) = delete;
+	RawFileWriter& operator=(const RawFileWriter&) = delete;
+	RawFileWriter(RawFileWriter&&) = delete;
+	RawFileWriter& operator=(RawFileWriter&&) = delete;
+
+	~RawFileWriter();
+
+	/* Creates the file, to be preallocated up to preallocate_size bytes by
+	 * prepare().
+	 */
+	Optional<File::Error> create(
+		const std::filesystem::path& filename,
+		const File::Size preallocate_size
+	);
+
+	/* Preallocates less than asked if the card has no free run that long.
+	 * Each failed attempt scans the whole FAT, which takes seconds on a
+	 * large card. Writes past what was preallocated allocate as usual.
+	 */
+	Optional<File::Error> prepare() override;
+
+	/* Zero until prepare() finds a run. */
+	File::Size preallocated_size() const {
+		return preallocated_size_;
+	}
+
+private:
+	/* Smallest run worth the wait to look for. */
+	static constexpr File::Size preallocate_size_min = 16 * 1024 * 1024;
+	static constexpr size_t preallocate_attempts_max = 3;
+
+	File::Size preallocate_size_ { 0 };
+	File::Size preallocated_size_ { 0 };
+};
+
+class FileReader : public stream::Reader {
+public:
+	FileReader() = default;
+
+	FileReader(const FileReader&) = delete;
+	FileReader& operator=(const FileReader&) = delete;
+	FileReader(FileReader&& file) = delete;
+	FileReader& operator=(FileReader&&) = delete;
+
+	Optional<File::Error> open(const std::filesystem::path& filename) {
+		return file.open(filename);
+	}
+
+	File::Result<File::Size> read(void* const buffer, const File::Size bytes) override;
+
+protected:
+	File file { };
+	uint64_t bytes_read { 0 };
+};
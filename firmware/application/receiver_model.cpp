@@ -47,10 +47,16 @@ static constexpr std::array<baseband::NBFMConfig, 3> nbfm_configs { {
 	{ taps_16k0_decim_0, taps_16k0_decim_1, taps_16k0_channel, 5000 },
 } };
 
-static constexpr std::array<baseband::WFMConfig, 1> wfm_configs { {
-	{ },
+static constexpr std::array<baseband::WFMConfig, 2> wfm_configs { {
+	{ WFMConfigureMessage::Spectrum::Channel },
+	{ WFMConfigureMessage::Spectrum::MPX },
 } };
 
+static constexpr baseband::WidebandSpectrumConfig wideband_spectrum_config {
+	WidebandSpectrumConfigMessage::Overlap::Half,
+	WidebandSpectrumConfigMessage::Averaging::Linear,
+};
+
 } /* namespace */
 
 rf::Frequency ReceiverModel::tuning_frequency() const {
@@ -265,6 +271,7 @@ void ReceiverModel::update_modulation() {
 		break;
 
 	case Mode::SpectrumAnalysis:
+		wideband_spectrum_config.apply();
 		break;
 	}
 }
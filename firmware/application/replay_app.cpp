@@ -0,0 +1,297 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "replay_app.hpp"
+
+#include "baseband_api.hpp"
+#include "audio.hpp"
+
+#include "portapack.hpp"
+using namespace portapack;
+
+#include "io_file.hpp"
+#include "rtc_time.hpp"
+
+#include "string_format.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+
+namespace ui {
+
+ReplayAppView::ReplayAppView(
+	NavigationView& nav
+) : nav_ { nav }
+{
+	add_children({
+		&label_file,
+		&options_file,
+		&label_decoder,
+		&options_decoder,
+		&options_pacing,
+		&button_start,
+		&text_replayed,
+		&text_speed,
+		&text_underruns,
+		&text_packets,
+	});
+
+	find_recordings();
+
+	OptionsField::options_t decoder_options;
+	for(size_t i=0; i<decoders.size(); i++) {
+		decoder_options.emplace_back(decoders[i].name, i);
+	}
+	options_decoder.set_options(decoder_options);
+	options_decoder.on_change = [this](size_t, OptionsField::value_t v) {
+		this->start_decoder(v);
+	};
+
+	options_file.on_change = [this](size_t, OptionsField::value_t) {
+		this->stop();
+	};
+
+	button_start.on_select = [this](Button&) {
+		this->toggle();
+	};
+
+	signal_token_tick_second = rtc_time::signal_tick_second += [this]() {
+		this->on_tick_second();
+	};
+
+	start_decoder(0);
+}
+
+ReplayAppView::~ReplayAppView() {
+	rtc_time::signal_tick_second -= signal_token_tick_second;
+
+	stop();
+	stop_decoder();
+}
+
+void ReplayAppView::focus() {
+	options_file.focus();
+}
+
+void ReplayAppView::find_recordings() {
+	recordings.clear();
+
+	OptionsField::options_t file_options;
+	const std::pair<std::filesystem::path, ReplayConfig::Format> patterns[] {
+		{ u"*.C8", ReplayConfig::Format::C8 },
+		{ u"*.C16", ReplayConfig::Format::C16 },
+	};
+	for(const auto& pattern : patterns) {
+		for(const auto& entry : std::filesystem::directory_iterator(u"", pattern.first)) {
+			if( std::filesystem::is_regular_file(entry.status()) ) {
+				auto name = entry.path().string();
+				name.resize(12, ' ');
+				file_options.emplace_back(name, recordings.size());
+				recordings.push_back({ entry.path(), pattern.second, read_sampling_rate(entry.path()) });
+			}
+		}
+	}
+
+	options_file.set_options(file_options);
+}
+
+/* "sample_rate=" from the .TXT RecordView writes beside a capture, or 0. */
+uint32_t ReplayAppView::read_sampling_rate(std::filesystem::path path) {
+	File file;
+	if( file.open(path.replace_extension(u".TXT")).is_valid() ) {
+		return 0;
+	}
+
+	std::array<char, 128> text;
+	const auto read_result = file.read(text.data(), text.size() - 1);
+	if( read_result.is_error() ) {
+		return 0;
+	}
+	text[read_result.value()] = 0;
+
+	const std::string key { "sample_rate=" };
+	const auto p = std::strstr(text.data(), key.c_str());
+	if( p == nullptr ) {
+		return 0;
+	}
+	return std::strtoul(p + key.size(), nullptr, 10);
+}
+
+void ReplayAppView::start_decoder(const size_t index) {
+	stop();
+	stop_decoder();
+
+	decoder_index = index;
+	const auto& decoder = decoders[decoder_index];
+
+	baseband::run_image(decoder.image_tag);
+
+	// The baseband thread only takes samples from the radio between
+	// replays, but the radio keeps it from blocking on DMA when there are
+	// none.
+	if( decoder.audio ) {
+		receiver_model.set_modulation(ReceiverModel::Mode::NarrowbandFMAudio);
+		receiver_model.set_sampling_rate(decoder.sampling_rate);
+		receiver_model.set_baseband_bandwidth(decoder.baseband_bandwidth);
+		receiver_model.enable();
+		audio::output::start();
+		audio::output::unmute();
+	} else {
+		radio::enable({
+			receiver_model.tuning_frequency(),
+			decoder.sampling_rate,
+			decoder.baseband_bandwidth,
+			rf::Direction::Receive,
+			receiver_model.rf_amp(),
+			static_cast<int8_t>(receiver_model.lna()),
+			static_cast<int8_t>(receiver_model.vga()),
+		});
+	}
+
+	decoder_running = true;
+}
+
+void ReplayAppView::stop_decoder() {
+	if( !decoder_running ) {
+		return;
+	}
+
+	if( decoders[decoder_index].audio ) {
+		audio::output::stop();
+		receiver_model.disable();
+	} else {
+		radio::disable();
+	}
+
+	baseband::shutdown();
+	decoder_running = false;
+}
+
+bool ReplayAppView::is_active() const {
+	return (bool)replay_thread;
+}
+
+void ReplayAppView::toggle() {
+	if( is_active() ) {
+		stop();
+	} else {
+		start();
+	}
+}
+
+void ReplayAppView::start() {
+	stop();
+
+	const auto index = options_file.selected_index();
+	if( index >= recordings.size() ) {
+		return;
+	}
+	const auto& recording = recordings[index];
+
+	const auto& decoder = decoders[decoder_index];
+	if( recording.sampling_rate != decoder.sampling_rate ) {
+		const auto recorded = (recording.sampling_rate == 0)
+			? std::string { "No sample_rate in .TXT" }
+			: ("File is " + to_string_dec_uint(recording.sampling_rate) + "/s");
+		auto name = decoder.name;
+		name.erase(name.find_last_not_of(' ') + 1);
+		nav_.display_modal("Error", recorded + ", " + name + " needs " + to_string_dec_uint(decoder.sampling_rate) + "/s. Record with Capture's " + decoder.capture_format + " format.");
+		return;
+	}
+
+	auto reader = std::make_unique<FileReader>();
+	const auto open_error = reader->open(recording.path);
+	if( open_error.is_valid() ) {
+		nav_.display_modal("Error", open_error.value().what());
+		return;
+	}
+
+	bytes_replayed_last = 0;
+	packets = 0;
+	packets_valid = 0;
+
+	replay_thread = std::make_unique<ReplayThread>(
+		std::move(reader),
+		read_size, buffer_count,
+		recording.format,
+		options_pacing.selected_index() == 0,
+		[]() {
+			ReplayThreadDoneMessage message { };
+			EventDispatcher::send_message(message);
+		},
+		[](File::Error error) {
+			ReplayThreadDoneMessage message { error.code() };
+			EventDispatcher::send_message(message);
+		}
+	);
+
+	button_start.set_text("Stop");
+	update_status_display();
+}
+
+void ReplayAppView::stop() {
+	if( is_active() ) {
+		update_status_display();
+		replay_thread.reset();
+		button_start.set_text("Start");
+	}
+}
+
+void ReplayAppView::on_packet(const bool valid) {
+	packets++;
+	if( valid ) {
+		packets_valid++;
+	}
+}
+
+void ReplayAppView::on_tick_second() {
+	if( is_active() ) {
+		update_status_display();
+	}
+}
+
+void ReplayAppView::update_status_display() {
+	const auto& state = replay_thread->state();
+	const auto& decoder = decoders[decoder_index];
+
+	const uint64_t bytes_replayed = state.baseband_bytes_replayed;
+	const uint32_t bytes_per_second = bytes_replayed - bytes_replayed_last;
+	bytes_replayed_last = bytes_replayed;
+
+	const uint32_t real_time_bytes_per_second = decoder.sampling_rate * state.bytes_per_sample();
+	const uint32_t speed_percent = (uint64_t(bytes_per_second) * 100) / real_time_bytes_per_second;
+
+	text_replayed.set("Replayed  " + to_string_dec_uint(bytes_replayed / 1024) + " KiB");
+	text_speed.set("Speed     " + to_string_dec_uint(speed_percent) + "\% of real time");
+	text_underruns.set("Underruns " + to_string_dec_uint(state.baseband_underruns));
+	text_packets.set("Packets   " + to_string_dec_uint(packets_valid) + "/" + to_string_dec_uint(packets) + " valid");
+}
+
+void ReplayAppView::handle_replay_thread_done(const uint32_t error) {
+	stop();
+	if( error ) {
+		nav_.display_modal("Error", File::Error { error }.what());
+	}
+}
+
+} /* namespace ui */
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __REPLAY_APP_HPP__
+#define __REPLAY_APP_HPP__
+
+#include "ui_widget.hpp"
+#include "ui_navigation.hpp"
+
+#include "replay_thread.hpp"
+#include "signal.hpp"
+
+#include "file.hpp"
+#include "spi_image.hpp"
+
+#include "ais_packet.hpp"
+#include "ert_packet.hpp"
+#include "tpms_packet.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace ui {
+
+/* Feeds a capture file to a decoder's baseband processor in place of the
+ * radio, so old recordings can be decoded by new firmware. The file must be
+ * what the processor takes from the radio, as Capture's decoder formats
+ * record it. The rate comes from the capture's .TXT; files without one, or
+ * at another rate (e.g. channel and survey captures) are refused.
+ */
+class ReplayAppView : public View {
+public:
+	ReplayAppView(NavigationView& nav);
+	~ReplayAppView();
+
+	void focus() override;
+
+	std::string title() const override { return "Replay"; };
+
+private:
+	struct Decoder {
+		std::string name;
+		portapack::spi_flash::image_tag_t image_tag;
+		uint32_t sampling_rate;
+		uint32_t baseband_bandwidth;
+		bool audio;
+		/* The Capture format that records what this decoder takes. */
+		std::string capture_format;
+	};
+
+	struct Recording {
+		std::filesystem::path path;
+		ReplayConfig::Format format;
+		uint32_t sampling_rate;
+	};
+
+	static constexpr size_t read_size = 16384;
+	static constexpr size_t buffer_count = 3;
+
+	NavigationView& nav_;
+
+	const std::vector<Decoder> decoders {
+		{ "AIS ",  portapack::spi_flash::image_tag_ais,       2457600, 1750000, false, "C8 AIS/TPMS" },
+		{ "ERT ",  portapack::spi_flash::image_tag_ert,       4194304, 2500000, false, "C8 ERT" },
+		{ "TPMS",  portapack::spi_flash::image_tag_tpms,      2457600, 1750000, false, "C8 AIS/TPMS" },
+		{ "NFM ",  portapack::spi_flash::image_tag_nfm_audio, 3072000, 1750000, true,  "C8 NFM" },
+	};
+
+	std::vector<Recording> recordings { };
+	size_t decoder_index { 0 };
+	bool decoder_running { false };
+
+	std::unique_ptr<ReplayThread> replay_thread { };
+	uint64_t bytes_replayed_last { 0 };
+	uint32_t packets { 0 };
+	uint32_t packets_valid { 0 };
+	SignalToken signal_token_tick_second { };
+
+	void find_recordings();
+	static uint32_t read_sampling_rate(std::filesystem::path path);
+
+	void start_decoder(const size_t index);
+	void stop_decoder();
+
+	bool is_active() const;
+	void toggle();
+	void start();
+	void stop();
+
+	void on_packet(const bool valid);
+	void on_tick_second();
+	void update_status_display();
+
+	void handle_replay_thread_done(const uint32_t error);
+
+	Text label_file {
+		{ 0 * 8, 0 * 16, 5 * 8, 16 },
+		"File",
+	};
+
+	OptionsField options_file {
+		{ 6 * 8, 0 * 16 },
+		12,
+		{ }
+	};
+
+	Text label_decoder {
+		{ 0 * 8, 1 * 16, 5 * 8, 16 },
+		"Dec",
+	};
+
+	OptionsField options_decoder {
+		{ 6 * 8, 1 * 16 },
+		4,
+		{ }
+	};
+
+	OptionsField options_pacing {
+		{ 12 * 8, 1 * 16 },
+		9,
+		{
+			{ "Real time", 1 },
+			{ "Fast     ", 0 },
+		}
+	};
+
+	Button button_start {
+		{ 0 * 8, 3 * 16, 10 * 8, 2 * 16 },
+		"Start"
+	};
+
+	Text text_replayed {
+		{ 0 * 8, 6 * 16, 30 * 8, 16 },
+		"",
+	};
+
+	Text text_speed {
+		{ 0 * 8, 7 * 16, 30 * 8, 16 },
+		"",
+	};
+
+	Text text_underruns {
+		{ 0 * 8, 8 * 16, 30 * 8, 16 },
+		"",
+	};
+
+	Text text_packets {
+		{ 0 * 8, 9 * 16, 30 * 8, 16 },
+		"",
+	};
+
+	MessageHandlerRegistration message_handler_replay_thread_done {
+		Message::ID::ReplayThreadDone,
+		[this](const Message* const p) {
+			const auto message = *reinterpret_cast<const ReplayThreadDoneMessage*>(p);
+			this->handle_replay_thread_done(message.error);
+		}
+	};
+
+	MessageHandlerRegistration message_handler_ais_packet {
+		Message::ID::AISPacket,
+		[this](Message* const p) {
+			const auto message = static_cast<const AISPacketMessage*>(p);
+			const ais::Packet packet { message->packet };
+			this->on_packet(packet.is_valid());
+		}
+	};
+
+	MessageHandlerRegistration message_handler_ert_packet {
+		Message::ID::ERTPacket,
+		[this](Message* const p) {
+			const auto message = static_cast<const ERTPacketMessage*>(p);
+			const ert::Packet packet { message->type, message->packet };
+			this->on_packet(packet.crc_ok());
+		}
+	};
+
+	MessageHandlerRegistration message_handler_tpms_packet {
+		Message::ID::TPMSPacket,
+		[this](Message* const p) {
+			const auto message = static_cast<const TPMSPacketMessage*>(p);
+			const tpms::Packet packet { message->packet, message->signal_type };
+			this->on_packet(packet.reading().is_valid());
+		}
+	};
+};
+
+} /* namespace ui */
+
+#endif/*__REPLAY_APP_HPP__*/
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "replay_thread.hpp"
+
+#include "baseband_api.hpp"
+#include "buffer_exchange.hpp"
+
+struct BasebandReplay {
+	BasebandReplay(ReplayConfig* const config) {
+		baseband::replay_start(config);
+	}
+
+	~BasebandReplay() {
+		baseband::replay_stop();
+	}
+};
+
+// ReplayThread ///////////////////////////////////////////////////////////
+
+ReplayThread::ReplayThread(
+	std::unique_ptr<stream::Reader> reader,
+	size_t read_size,
+	size_t buffer_count,
+	ReplayConfig::Format format,
+	bool real_time,
+	std::function<void()> success_callback,
+	std::function<void(File::Error)> error_callback
+) : config { read_size, buffer_count, format, real_time },
+	reader { std::move(reader) },
+	success_callback { std::move(success_callback) },
+	error_callback { std::move(error_callback) }
+{
+	// Need significant stack for FATFS
+	thread = chThdCreateFromHeap(NULL, 1024, NORMALPRIO + 10, ReplayThread::static_fn, this);
+}
+
+ReplayThread::~ReplayThread() {
+	if( thread ) {
+		chThdTerminate(thread);
+		chThdWait(thread);
+		thread = nullptr;
+	}
+}
+
+msg_t ReplayThread::static_fn(void* arg) {
+	auto obj = static_cast<ReplayThread*>(arg);
+	const auto error = obj->run();
+	if( error.is_valid() && obj->error_callback ) {
+		obj->error_callback(error.value());
+	} else {
+		if( obj->success_callback ) {
+			obj->success_callback();
+		}
+	}
+	return 0;
+}
+
+Optional<File::Error> ReplayThread::run() {
+	BasebandReplay replay { &config };
+	BufferExchange buffers { &config };
+
+	// Every buffer starts out empty, on the application side. Any more
+	// than that have been handed to the baseband and come back.
+	size_t buffers_taken = 0;
+	size_t buffers_given = 0;
+
+	while( !chThdShouldTerminate() ) {
+		auto buffer = buffers.get();
+		buffers_taken++;
+
+		auto read_result = reader->read(buffer->data(), buffer->capacity());
+		if( read_result.is_error() ) {
+			return read_result.error();
+		}
+		if( read_result.value() == 0 ) {
+			break;
+		}
+
+		buffer->set_size(read_result.value());
+		buffers.put(buffer);
+		buffers_given++;
+	}
+
+	// End of file. Let the baseband drain what it was given before stopping.
+	while( (buffers_taken < (buffers_given + config.buffer_count)) && !chThdShouldTerminate() ) {
+		buffers.get();
+		buffers_taken++;
+	}
+
+	return { };
+}
@@ -59,4 +59,81 @@ void BasebandStatsView::on_statistics_update(const BasebandStatistics& statistic
 	text_stats.set(message);
 }
 
+/* StageStatsView ********************************************************/
+
+static constexpr std::array<const char*, toUType(StageStatistics::Stage::Count)> stage_names { {
+	"decim_0",
+	"decim_1",
+	"channel",
+	"demod  ",
+	"audio  ",
+	"spectrm",
+} };
+
+static std::string cycles_to_kilo_string(const uint32_t cycles) {
+	const uint32_t kilo_x10_clipped = std::min(cycles / 100, static_cast<uint32_t>(9999));
+	return
+		to_string_dec_uint(kilo_x10_clipped / 10, 3) + "." +
+		to_string_dec_uint(kilo_x10_clipped % 10, 1, '0');
+}
+
+static std::string load_string(const uint32_t cycles, const uint32_t block_cycles) {
+	if( block_cycles == 0 ) {
+		return "  --";
+	}
+
+	const uint32_t percent_x10 = (static_cast<uint64_t>(cycles) * 1000) / block_cycles;
+	const uint32_t percent_x10_clipped = std::min(percent_x10, static_cast<uint32_t>(999));
+	return
+		to_string_dec_uint(percent_x10_clipped / 10, 2) + "." +
+		to_string_dec_uint(percent_x10_clipped % 10, 1, '0');
+}
+
+StageStatsView::StageStatsView(
+	const Rect parent_rect
+) : View { parent_rect }
+{
+	add_children({
+		&text_header,
+		&text_total,
+	});
+
+	for(size_t i=0; i<text_stages.size(); i++) {
+		text_stages[i].set_parent_rect({ 0 * 8, static_cast<Coord>((i + 1) * 16), 30 * 8, 1 * 16 });
+		text_stages[i].set(std::string(stage_names[i]) + "     --");
+		add_child(&text_stages[i]);
+	}
+
+	text_total.set_parent_rect({ 0 * 8, static_cast<Coord>((stages_count + 1) * 16), 30 * 8, 1 * 16 });
+}
+
+void StageStatsView::on_statistics_update(const StageStatistics& statistics) {
+	const uint32_t block_cycles = (statistics.sampling_rate > 0)
+		? (static_cast<uint64_t>(base_m4_clk_f) * statistics.block_samples) / statistics.sampling_rate
+		: 0;
+
+	uint32_t total_avg = 0;
+	for(size_t i=0; i<text_stages.size(); i++) {
+		const auto& cycles = statistics.stages[i];
+		if( cycles.count == 0 ) {
+			text_stages[i].set(std::string(stage_names[i]) + "     --");
+			continue;
+		}
+
+		text_stages[i].set(
+			std::string(stage_names[i])
+			+ " " + cycles_to_kilo_string(cycles.min)
+			+ " " + cycles_to_kilo_string(cycles.avg)
+			+ " " + cycles_to_kilo_string(cycles.max)
+			+ " " + load_string(cycles.avg, block_cycles)
+		);
+		total_avg += cycles.avg;
+	}
+
+	text_total.set(
+		"total         " + cycles_to_kilo_string(total_avg)
+		+ "       " + load_string(total_avg, block_cycles)
+	);
+}
+
 } /* namespace ui */
@@ -27,6 +27,9 @@
 #include "event_m0.hpp"
 
 #include "message.hpp"
+#include "utility.hpp"
+
+#include <array>
 
 namespace ui {
 
@@ -50,6 +53,38 @@ private:
 	void on_statistics_update(const BasebandStatistics& statistics);
 };
 
+/* Min/avg/max kilocycles per block for each stage of the running processor,
+ * and average load as a percentage of the time per block. The owner turns
+ * reporting on and off with baseband::stage_statistics_start()/stop().
+ */
+class StageStatsView : public View {
+public:
+	StageStatsView(const Rect parent_rect);
+
+private:
+	using Stage = StageStatistics::Stage;
+
+	static constexpr size_t stages_count = toUType(Stage::Count);
+
+	Text text_header {
+		{ 0 * 8, 0 * 16, 30 * 8, 1 * 16 },
+		"Stage     min   avg   max load",
+	};
+
+	std::array<Text, stages_count> text_stages { };
+
+	Text text_total { };
+
+	MessageHandlerRegistration message_handler_stats {
+		Message::ID::StageStatistics,
+		[this](const Message* const p) {
+			this->on_statistics_update(static_cast<const StageStatisticsMessage*>(p)->statistics);
+		}
+	};
+
+	void on_statistics_update(const StageStatistics& statistics);
+};
+
 } /* namespace ui */
 
 #endif/*__UI_BASEBAND_STATS_VIEW_H__*/
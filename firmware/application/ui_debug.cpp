@@ -24,12 +24,18 @@
 #include "ch.h"
 
 #include "radio.hpp"
+#include "rtc_time.hpp"
 #include "string_format.hpp"
 
 #include "audio.hpp"
+#include "baseband_api.hpp"
 
 #include "ui_sd_card_debug.hpp"
 
+#include "portapack_shared_memory.hpp"
+
+#include <algorithm>
+
 namespace ui {
 
 /* DebugMemoryView *******************************************************/
@@ -148,6 +154,160 @@ void TemperatureView::focus() {
 	button_done.focus();
 }
 
+/* StageCyclesView *******************************************************/
+
+StageCyclesView::StageCyclesView(NavigationView& nav) {
+	add_children({
+		&text_title,
+		&options_modulation,
+		&stage_stats_view,
+		&button_done,
+	});
+
+	const auto modulation = portapack::receiver_model.modulation();
+	options_modulation.set_by_value(toUType(modulation));
+	options_modulation.on_change = [this](size_t, OptionsField::value_t v) {
+		this->update_modulation(static_cast<ReceiverModel::Mode>(v));
+	};
+
+	button_done.on_select = [&nav](Button&){ nav.pop(); };
+
+	audio::output::start();
+
+	update_modulation(modulation);
+}
+
+StageCyclesView::~StageCyclesView() {
+	audio::output::stop();
+
+	portapack::receiver_model.disable();
+
+	baseband::shutdown();
+}
+
+void StageCyclesView::focus() {
+	button_done.focus();
+}
+
+void StageCyclesView::update_modulation(const ReceiverModel::Mode modulation) {
+	audio::output::mute();
+
+	baseband::shutdown();
+
+	portapack::spi_flash::image_tag_t image_tag;
+	switch(modulation) {
+	case ReceiverModel::Mode::AMAudio:				image_tag = portapack::spi_flash::image_tag_am_audio;	break;
+	case ReceiverModel::Mode::NarrowbandFMAudio:	image_tag = portapack::spi_flash::image_tag_nfm_audio;	break;
+	case ReceiverModel::Mode::WidebandFMAudio:		image_tag = portapack::spi_flash::image_tag_wfm_audio;	break;
+	case ReceiverModel::Mode::SpectrumAnalysis:		image_tag = portapack::spi_flash::image_tag_wideband_spectrum;	break;
+	default:
+		return;
+	}
+
+	baseband::run_image(image_tag);
+
+	/* The wideband spectrum reports cycles per frame, not per block. */
+	const auto is_wideband_spectrum_mode = (modulation == ReceiverModel::Mode::SpectrumAnalysis);
+	portapack::receiver_model.set_modulation(modulation);
+	portapack::receiver_model.set_sampling_rate(is_wideband_spectrum_mode ? 20000000 : 3072000);
+	portapack::receiver_model.set_baseband_bandwidth(is_wideband_spectrum_mode ? 12000000 : 1750000);
+	portapack::receiver_model.enable();
+
+	/* A new processor starts with stage accounting off. */
+	baseband::stage_statistics_start();
+
+	audio::output::unmute();
+}
+
+/* MessageQueuesView *****************************************************/
+
+MessageQueuesView::MessageQueuesView(NavigationView& nav) {
+	add_children({
+		&text_title,
+		&options_queue,
+		&text_size,
+		&text_pushes,
+		&text_failures,
+		&text_bytes,
+		&text_depth_max,
+		&text_id_header,
+		&button_done,
+	});
+
+	for(size_t i=0; i<text_ids.size(); i++) {
+		text_ids[i].set_parent_rect({ 0 * 8, static_cast<Coord>((10 + i) * 16), 30 * 8, 1 * 16 });
+		add_child(&text_ids[i]);
+	}
+
+	options_queue.on_change = [this](size_t, OptionsField::value_t) {
+		this->update();
+	};
+
+	button_done.on_select = [&nav](Button&){ nav.pop(); };
+
+	signal_token_tick_second = rtc_time::signal_tick_second += [this]() {
+		this->update();
+	};
+
+	update();
+}
+
+MessageQueuesView::~MessageQueuesView() {
+	rtc_time::signal_tick_second -= signal_token_tick_second;
+}
+
+void MessageQueuesView::focus() {
+	options_queue.focus();
+}
+
+const MessageQueue& MessageQueuesView::queue() const {
+	switch(options_queue.selected_index()) {
+	default:
+	case 0:	return shared_memory.application_queue;
+	case 1:	return shared_memory.baseband_queue;
+	case 2:	return shared_memory.app_local_queue;
+	}
+}
+
+void MessageQueuesView::update() {
+	const auto& q = queue();
+	/* Copied, as the baseband may be updating it. */
+	const MessageQueueStatistics statistics = q.statistics();
+
+	const auto depth_percent = (statistics.depth_max * 100) / q.capacity();
+
+	text_size.set("Size          " + to_string_dec_uint(q.capacity(), 10));
+	text_pushes.set("Pushes        " + to_string_dec_uint(statistics.pushes, 10));
+	text_failures.set("Push failures " + to_string_dec_uint(statistics.push_failures, 10));
+	text_bytes.set("Bytes         " + to_string_dec_uint(statistics.bytes, 10));
+	text_depth_max.set("Max depth     " + to_string_dec_uint(statistics.depth_max, 10) + to_string_dec_uint(depth_percent, 4) + "%");
+
+	/* Busiest IDs first, failures counting before pushes. */
+	std::array<size_t, MessageQueueStatistics::ids_count> ids;
+	for(size_t i=0; i<ids.size(); i++) {
+		ids[i] = i;
+	}
+	std::sort(ids.begin(), ids.end(), [&statistics](const size_t a, const size_t b) {
+		if( statistics.id_push_failures[a] != statistics.id_push_failures[b] ) {
+			return statistics.id_push_failures[a] > statistics.id_push_failures[b];
+		}
+		return statistics.id_pushes[a] > statistics.id_pushes[b];
+	});
+
+	for(size_t i=0; i<text_ids.size(); i++) {
+		const auto id = ids[i];
+		if( (statistics.id_pushes[id] == 0) && (statistics.id_push_failures[id] == 0) ) {
+			text_ids[i].set("");
+			continue;
+		}
+		text_ids[i].set(
+			to_string_dec_uint(id, 2) + " "
+			+ to_string_dec_uint(statistics.id_pushes[id], 10) + " "
+			+ to_string_dec_uint(statistics.id_push_failures[id], 10)
+		);
+	}
+}
+
 /* RegistersWidget *******************************************************/
 
 RegistersWidget::RegistersWidget(
@@ -277,6 +437,8 @@ DebugMenuView::DebugMenuView(NavigationView& nav) {
 		{ "SD Card",     [&nav](){ nav.push<SDCardDebugView>(); } },
 		{ "Peripherals", [&nav](){ nav.push<DebugPeripheralsMenuView>(); } },
 		{ "Temperature", [&nav](){ nav.push<TemperatureView>(); } },
+		{ "Stage Cycles", [&nav](){ nav.push<StageCyclesView>(); } },
+		{ "Queues",      [&nav](){ nav.push<MessageQueuesView>(); } },
 	});
 	on_left = [&nav](){ nav.pop(); };
 }
@@ -27,6 +27,11 @@
 #include "ui_painter.hpp"
 #include "ui_menu.hpp"
 #include "ui_navigation.hpp"
+#include "ui_baseband_stats_view.hpp"
+
+#include "receiver_model.hpp"
+#include "message_queue.hpp"
+#include "signal.hpp"
 
 #include "rffc507x.hpp"
 #include "max2837.hpp"
@@ -34,6 +39,7 @@
 
 #include <functional>
 #include <utility>
+#include <array>
 
 namespace ui {
 
@@ -218,6 +224,111 @@ private:
 	};
 };
 
+/* Runs an audio receiver with the current tuning and shows where the
+ * baseband processor spends its cycles.
+ */
+class StageCyclesView : public View {
+public:
+	explicit StageCyclesView(NavigationView& nav);
+	~StageCyclesView();
+
+	void focus() override;
+
+private:
+	Text text_title {
+		{ 76, 16, 240, 16 },
+		"Stage Cycles",
+	};
+
+	OptionsField options_modulation {
+		{ 0 * 8, 3 * 16 },
+		4,
+		{
+			{ " AM ", toUType(ReceiverModel::Mode::AMAudio) },
+			{ "NFM ", toUType(ReceiverModel::Mode::NarrowbandFMAudio) },
+			{ "WFM ", toUType(ReceiverModel::Mode::WidebandFMAudio) },
+			{ "SPEC", toUType(ReceiverModel::Mode::SpectrumAnalysis) },
+		}
+	};
+
+	StageStatsView stage_stats_view {
+		{ 0 * 8, 5 * 16, 30 * 8, 8 * 16 },
+	};
+
+	Button button_done {
+		{ 72, 264, 96, 24 },
+		"Done"
+	};
+
+	void update_modulation(const ReceiverModel::Mode modulation);
+};
+
+/* Telemetry for the message queues in shared memory. The application queue
+ * and the baseband queue restart with each baseband image.
+ */
+class MessageQueuesView : public View {
+public:
+	explicit MessageQueuesView(NavigationView& nav);
+	~MessageQueuesView();
+
+	void focus() override;
+
+private:
+	static constexpr size_t id_rows_count = 6;
+
+	Text text_title {
+		{ 64, 16, 240, 16 },
+		"Message Queues",
+	};
+
+	OptionsField options_queue {
+		{ 0 * 8, 2 * 16 },
+		16,
+		{
+			{ "Baseband -> App ", 0 },
+			{ "App -> Baseband ", 1 },
+			{ "App local       ", 2 },
+		}
+	};
+
+	Text text_size {
+		{ 0 * 8, 3 * 16, 30 * 8, 16 },
+	};
+
+	Text text_pushes {
+		{ 0 * 8, 4 * 16, 30 * 8, 16 },
+	};
+
+	Text text_failures {
+		{ 0 * 8, 5 * 16, 30 * 8, 16 },
+	};
+
+	Text text_bytes {
+		{ 0 * 8, 6 * 16, 30 * 8, 16 },
+	};
+
+	Text text_depth_max {
+		{ 0 * 8, 7 * 16, 30 * 8, 16 },
+	};
+
+	Text text_id_header {
+		{ 0 * 8, 9 * 16, 30 * 8, 16 },
+		"ID     pushes   failures",
+	};
+
+	std::array<Text, id_rows_count> text_ids { };
+
+	Button button_done {
+		{ 72, 264, 96, 24 },
+		"Done"
+	};
+
+	SignalToken signal_token_tick_second { };
+
+	const MessageQueue& queue() const;
+	void update();
+};
+
 class DebugPeripheralsMenuView : public MenuView {
 public:
 	DebugPeripheralsMenuView(NavigationView& nav);
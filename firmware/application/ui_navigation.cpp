@@ -32,6 +32,7 @@
 #include "ert_app.hpp"
 #include "tpms_app.hpp"
 #include "capture_app.hpp"
+#include "replay_app.hpp"
 
 #include "core_control.hpp"
 
@@ -194,6 +195,7 @@ SystemMenuView::SystemMenuView(NavigationView& nav) {
 	add_items({
 		{ "Receiver", [&nav](){ nav.push<ReceiverMenuView>(); } },
 		{ "Capture",  [&nav](){ nav.push<CaptureAppView>(); } },
+		{ "Replay",   [&nav](){ nav.push<ReplayAppView>(); } },
 		{ "Analyze",  [&nav](){ nav.push<NotImplementedView>(); } },
 		{ "Setup",    [&nav](){ nav.push<SetupMenuView>(); } },
 		{ "About",    [&nav](){ nav.push<AboutView>(); } },
@@ -26,6 +26,8 @@ using namespace portapack;
 
 #include "io_file.hpp"
 #include "io_wave.hpp"
+#include "capture_index.hpp"
+#include "iq_compress.hpp"
 
 #include "rtc_time.hpp"
 
@@ -75,6 +77,15 @@ void RecordView::focus() {
 	button_record.focus();
 }
 
+void RecordView::set_file_type(const FileType new_file_type, const size_t new_decimation) {
+	if( (new_file_type != file_type) || (new_decimation != decimation) ) {
+		stop();
+		file_type = new_file_type;
+		decimation = new_decimation;
+		update_status_display();
+	}
+}
+
 void RecordView::set_sampling_rate(const size_t new_sampling_rate) {
 	if( new_sampling_rate != sampling_rate ) {
 		stop();
@@ -118,6 +129,7 @@ void RecordView::start() {
 	}
 
 	std::unique_ptr<stream::Writer> writer;
+	std::unique_ptr<stream::Writer> index_writer;
 	switch(file_type) {
 	case FileType::WAV:
 		{
@@ -131,7 +143,9 @@ void RecordView::start() {
 		}
 		break;
 
+	case FileType::RawS8:
 	case FileType::RawS16:
+	case FileType::RawS16Compressed:
 		{
 			const auto metadata_file_error = write_metadata_file(base_path.replace_extension(u".TXT"));
 			if( metadata_file_error.is_valid() ) {
@@ -139,11 +153,27 @@ void RecordView::start() {
 				return;
 			}
 
+			auto index = std::make_unique<FileWriter>();
+			const auto index_file_error = create_index_file(*index, base_path.replace_extension(u".IDX"));
+			if( index_file_error.is_valid() ) {
+				handle_error(index_file_error.value());
+				return;
+			}
+			index_writer = std::move(index);
+
+			const auto space_info = std::filesystem::space(u"");
 			auto p = std::make_unique<RawFileWriter>();
-			auto create_error = p->create(base_path.replace_extension(u".C16"));
+			const auto extension =
+				(file_type == FileType::RawS8) ? u".C8" :
+				(file_type == FileType::RawS16Compressed) ? u".Z16" : u".C16";
+			auto create_error = p->create(
+				base_path.replace_extension(extension),
+				std::min(space_info.free, preallocate_size_max)
+			);
 			if( create_error.is_valid() ) {
 				handle_error(create_error.value());
 			} else {
+				raw_writer = p.get();
 				writer = std::move(p);
 			}
 		}
@@ -158,7 +188,11 @@ void RecordView::start() {
 		button_record.set_bitmap(&bitmap_stop);
 		capture_thread = std::make_unique<CaptureThread>(
 			std::move(writer),
+			std::move(index_writer),
 			write_size, buffer_count,
+			capture_format(),
+			decimation,
+			sampling_rate,
 			[]() {
 				CaptureThreadDoneMessage message { };
 				EventDispatcher::send_message(message);
@@ -176,6 +210,7 @@ void RecordView::start() {
 void RecordView::stop() {
 	if( is_active() ) {
 		capture_thread.reset();
+		raw_writer = nullptr;
 		button_record.set_bitmap(&bitmap_record);
 	}
 
@@ -200,6 +235,38 @@ Optional<File::Error> RecordView::write_metadata_file(const std::filesystem::pat
 	}
 }
 
+Optional<File::Error> RecordView::create_index_file(FileWriter& index_file, const std::filesystem::path& filename) {
+	const auto create_error = index_file.create(filename);
+	if( create_error.is_valid() ) {
+		return create_error;
+	}
+
+	const capture_index::Header header {
+		capture_index::magic,
+		capture_index::version,
+		sizeof(capture_index::Record),
+		sampling_rate,
+		static_cast<uint8_t>(
+			(file_type == FileType::RawS8) ? 2 :
+			(file_type == FileType::RawS16) ? 4 : 0
+		),
+		{ 0, 0, 0 },
+	};
+	const auto write_result = index_file.write(&header, sizeof(header));
+	if( write_result.is_error() ) {
+		return write_result.error();
+	}
+	return { };
+}
+
+CaptureConfig::Format RecordView::capture_format() const {
+	switch(file_type) {
+	case FileType::RawS8:				return CaptureConfig::Format::C8;
+	case FileType::RawS16Compressed:	return CaptureConfig::Format::C16Compressed;
+	default:							return CaptureConfig::Format::C16;
+	}
+}
+
 void RecordView::on_tick_second() {
 	update_status_display();
 }
@@ -212,15 +279,30 @@ void RecordView::update_status_display() {
 	}
 
 	if( sampling_rate ) {
-		const auto space_info = std::filesystem::space(u"");
-		const uint32_t bytes_per_second = file_type == FileType::WAV ? (sampling_rate * 2) : (sampling_rate * 4);
+		auto space_info = std::filesystem::space(u"");
+		if( is_active() && raw_writer ) {
+			/* Count what's preallocated to the file but not yet written. */
+			const auto preallocated_size = raw_writer->preallocated_size();
+			const auto& state = capture_thread->state();
+			const auto written = state.baseband_bytes_received - state.baseband_bytes_dropped;
+			space_info.free += preallocated_size - std::min(preallocated_size, written);
+		}
+		/* Compressed captures are counted at the coder's worst case, raw
+		 * samples plus a header per block; they typically take a little
+		 * over half that. The time is shown as ">", a minimum.
+		 */
+		const bool compressed = (file_type == FileType::RawS16Compressed);
+		const uint32_t bytes_per_second =
+			(file_type == FileType::RawS8) ? (sampling_rate * 2) :
+			compressed ? ((uint64_t(sampling_rate) * iq_compress::block_size_max + iq_compress::block_samples - 1) / iq_compress::block_samples) :
+			(sampling_rate * 4);
 		const uint32_t available_seconds = space_info.free / bytes_per_second;
 		const uint32_t seconds = available_seconds % 60;
 		const uint32_t available_minutes = available_seconds / 60;
 		const uint32_t minutes = available_minutes % 60;
 		const uint32_t hours = available_minutes / 60;
 		const std::string available_time =
-			to_string_dec_uint(hours, 3, ' ') + ":" +
+			(compressed ? (">" + to_string_dec_uint(std::min(hours, 99U), 2, ' ')) : to_string_dec_uint(hours, 3, ' ')) + ":" +
 			to_string_dec_uint(minutes, 2, '0') + ":" +
 			to_string_dec_uint(seconds, 2, '0');
 		text_time_available.set(available_time);
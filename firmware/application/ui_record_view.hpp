@@ -25,6 +25,7 @@
 #include "ui_widget.hpp"
 
 #include "capture_thread.hpp"
+#include "io_file.hpp"
 #include "signal.hpp"
 
 #include "bitmap.hpp"
@@ -40,8 +41,11 @@ public:
 	std::function<void(std::string)> on_error { };
 
 	enum FileType {
+		RawS8 = 1,
 		RawS16 = 2,
 		WAV = 3,
+		/* RawS16, losslessly compressed. Decode with host/iq_decompress. */
+		RawS16Compressed = 4,
 	};
 
 	RecordView(
@@ -57,6 +61,12 @@ public:
 
 	void set_sampling_rate(const size_t new_sampling_rate);
 
+	/* RawS8 records the baseband, as received at decimation 1, or
+	 * decimated with the target at DC. Other file types take what the
+	 * processor streams.
+	 */
+	void set_file_type(const FileType new_file_type, const size_t new_decimation = 1);
+
 	void start();
 	void stop();
 
@@ -65,6 +75,10 @@ public:
 private:
 	void toggle();
 	Optional<File::Error> write_metadata_file(const std::filesystem::path& filename);
+	/* Creates the capture's .IDX and writes its header. */
+	Optional<File::Error> create_index_file(FileWriter& index_file, const std::filesystem::path& filename);
+
+	CaptureConfig::Format capture_format() const;
 
 	void on_tick_second();
 	void update_status_display();
@@ -73,12 +87,20 @@ private:
 	void handle_error(const File::Error error);
 
 	const std::filesystem::path filename_stem_pattern;
-	const FileType file_type;
+	FileType file_type;
+	size_t decimation { 1 };
 	const size_t write_size;
 	const size_t buffer_count;
 	size_t sampling_rate { 0 };
 	SignalToken signal_token_tick_second { };
 
+	/* Raw captures preallocate this much of the card, or its free space if
+	 * less. About four minutes of the fastest raw capture.
+	 */
+	static constexpr File::Size preallocate_size_max = 2ULL * 1024 * 1024 * 1024;
+	/* Owned by capture_thread, which preallocates it. */
+	const RawFileWriter* raw_writer { nullptr };
+
 	Rectangle rect_background {
 		Color::black()
 	};
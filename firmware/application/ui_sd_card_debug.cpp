@@ -22,8 +22,10 @@
 #include "ui_sd_card_debug.hpp"
 
 #include "string_format.hpp"
+#include "rtc_time.hpp"
 
 #include "file.hpp"
+#include "io_file.hpp"
 #include "lfsr_random.hpp"
 
 #include "ff.h"
@@ -32,6 +34,8 @@
 #include "ch.h"
 #include "hal.h"
 
+#include <algorithm>
+
 class SDCardTestThread {
 public:
 	enum Result {
@@ -227,6 +231,316 @@ private:
 
 Thread* SDCardTestThread::thread { nullptr };
 
+/* Counts of durations in microseconds, in bins an eighth of an octave wide,
+ * so any percentile is within 12.5%.
+ */
+class LatencyHistogram {
+public:
+	void add(const uint32_t us) {
+		bins[bin(us)]++;
+		count_++;
+		max_ = std::max(max_, us);
+	}
+
+	size_t count() const {
+		return count_;
+	}
+
+	uint32_t max() const {
+		return max_;
+	}
+
+	/* Upper bound of the duration parts_per_10000 of durations are within. */
+	uint32_t percentile(const uint32_t parts_per_10000) const {
+		const uint64_t target = (uint64_t(count_) * parts_per_10000 + 9999) / 10000;
+		uint64_t sum = 0;
+		for(size_t i=0; i<bins.size(); i++) {
+			sum += bins[i];
+			if( (sum >= target) && (sum > 0) ) {
+				return std::min(bin_max(i), max_);
+			}
+		}
+		return max_;
+	}
+
+	size_t bin_count() const {
+		return bins.size();
+	}
+
+	uint32_t bin_value(const size_t i) const {
+		return bins[i];
+	}
+
+	static uint32_t bin_max(const size_t i) {
+		if( i < sub_bins ) {
+			return i;
+		}
+		const size_t shift = (i - sub_bins) / sub_bins;
+		const uint32_t mantissa = sub_bins + ((i - sub_bins) % sub_bins);
+		return ((mantissa + 1) << shift) - 1;
+	}
+
+private:
+	static constexpr size_t sub_bins_log2 = 3;
+	static constexpr size_t sub_bins = 1U << sub_bins_log2;
+
+	/* sub_bins of single microseconds, then sub_bins per octave above. */
+	std::array<uint32_t, sub_bins + (32 - sub_bins_log2) * sub_bins> bins { };
+	size_t count_ { 0 };
+	uint32_t max_ { 0 };
+
+	static size_t bin(const uint32_t us) {
+		if( us < sub_bins ) {
+			return us;
+		}
+		const size_t shift = (31 - __builtin_clz(us)) - sub_bins_log2;
+		return sub_bins + shift * sub_bins + ((us >> shift) - sub_bins);
+	}
+};
+
+/* Writes as a capture does: buffers of write_size, arriving at rate, and
+ * written to a preallocated file as they arrive. Alongside, it models the
+ * baseband filling buffer_count buffers, one per interval. An interval
+ * with no empty buffer to fill is one a capture would have dropped.
+ */
+class SDCardBenchmarkThread {
+public:
+	enum Result {
+		FailWrite = -4,
+		FailFileOpenWrite = -3,
+		FailHeap = -2,
+		Incomplete = 0,
+		OK = 1,
+	};
+
+	struct Config {
+		size_t write_size;
+		size_t buffer_count;
+		uint32_t rate;
+		uint32_t duration_seconds;
+		bool save_csv;
+	};
+
+	struct Stats {
+		LatencyHistogram latency { };
+		File::Size write_bytes { 0 };
+		uint64_t test_duration_us { 0 };
+		size_t intervals { 0 };
+		size_t overflow_intervals { 0 };
+	};
+
+	SDCardBenchmarkThread(
+		const Config config
+	) : config { config }
+	{
+		thread = chThdCreateFromHeap(NULL, 3072, NORMALPRIO + 10, SDCardBenchmarkThread::static_fn, this);
+	}
+
+	~SDCardBenchmarkThread() {
+		stop();
+	}
+
+	/* Ends the test early and waits for the thread to finish. The stats
+	 * and result are then final for what ran.
+	 */
+	void stop() {
+		if( thread ) {
+			chThdTerminate(thread);
+			chThdWait(thread);
+			thread = nullptr;
+		}
+	}
+
+	Result result() const {
+		return _result;
+	}
+
+	/* Only complete once result() isn't Incomplete. */
+	const Stats& stats() const {
+		return _stats;
+	}
+
+	uint32_t elapsed_seconds() const {
+		return _elapsed_seconds;
+	}
+
+	const std::filesystem::path& csv_path() const {
+		return _csv_path;
+	}
+
+private:
+	const Config config;
+	Thread* thread { nullptr };
+	volatile Result _result { Result::Incomplete };
+	volatile uint32_t _elapsed_seconds { 0 };
+	Stats _stats { };
+	std::filesystem::path _csv_path { };
+
+	/* Time since the test started. The hardware counter is 32 bits and
+	 * wraps in seconds, so it's accumulated here.
+	 */
+	uint64_t now { 0 };
+	halrtcnt_t counter_last { 0 };
+
+	/* The modelled baseband: the end of the interval it's filling a buffer
+	 * for, whether it had one to fill, and buffers filled and not written.
+	 */
+	uint64_t interval { 0 };
+	uint64_t fill_end { 0 };
+	bool filling { true };
+	size_t buffers_full { 0 };
+
+	static msg_t static_fn(void* arg) {
+		auto obj = static_cast<SDCardBenchmarkThread*>(arg);
+		obj->_result = obj->run();
+		return 0;
+	}
+
+	uint64_t clock() {
+		const halrtcnt_t counter = halGetCounterValue();
+		now += static_cast<halrtcnt_t>(counter - counter_last);
+		counter_last = counter;
+		return now;
+	}
+
+	uint64_t ticks_to_us(const uint64_t ticks) const {
+		return ticks * 1000000U / halGetCounterFrequency();
+	}
+
+	/* Fills buffers in the model up to time t. writing is 1 while a buffer
+	 * is being written, which the baseband can't have either.
+	 */
+	void fill_until(const uint64_t t, const size_t writing) {
+		while( fill_end <= t ) {
+			if( filling ) {
+				buffers_full++;
+			}
+			filling = (buffers_full + writing + 1) <= config.buffer_count;
+			if( !filling ) {
+				_stats.overflow_intervals++;
+			}
+			_stats.intervals++;
+			fill_end += interval;
+		}
+	}
+
+	Result run() {
+		const std::filesystem::path filename { u"_PPBENCH.DAT" };
+
+		const auto result = write(filename);
+		f_unlink(reinterpret_cast<const TCHAR*>(filename.c_str()));
+		if( result != Result::OK ) {
+			return result;
+		}
+
+		if( config.save_csv ) {
+			save_csv();
+		}
+
+		return Result::OK;
+	}
+
+	Result write(const std::filesystem::path& filename) {
+		const auto buffer = std::make_unique<uint8_t[]>(config.write_size);
+		if( !buffer ) {
+			return Result::FailHeap;
+		}
+		lfsr_word_t v = 1;
+		lfsr_fill(v, reinterpret_cast<lfsr_word_t*>(buffer.get()), config.write_size / sizeof(lfsr_word_t));
+
+		/* FAT files stop short of 4GiB. A test that fills the card or the
+		 * file ends early.
+		 */
+		const auto space_info = std::filesystem::space(u"");
+		const File::Size bytes_max = std::min<File::Size>(
+			std::min<File::Size>(uint64_t(config.rate) * config.duration_seconds, space_info.free),
+			0xffffffffULL
+		) / config.write_size * config.write_size;
+
+		RawFileWriter file;
+		if( file.create(filename, bytes_max).is_valid() || file.prepare().is_valid() ) {
+			return Result::FailFileOpenWrite;
+		}
+
+		interval = uint64_t(config.write_size) * halGetCounterFrequency() / config.rate;
+		fill_end = interval;
+		const uint64_t test_end = uint64_t(config.duration_seconds) * halGetCounterFrequency();
+
+		counter_last = halGetCounterValue();
+		while( !chThdShouldTerminate() && (clock() < test_end) && (_stats.write_bytes < bytes_max) ) {
+			fill_until(now, 0);
+			_elapsed_seconds = now / halGetCounterFrequency();
+
+			if( buffers_full == 0 ) {
+				const uint32_t wait_ms = ticks_to_us(fill_end - now) / 1000U + 1;
+				chThdSleepMilliseconds(wait_ms);
+				continue;
+			}
+
+			buffers_full--;
+			const auto write_start = now;
+			const auto result_write = file.write(buffer.get(), config.write_size);
+			if( result_write.is_error() ) {
+				return Result::FailWrite;
+			}
+			_stats.write_bytes += config.write_size;
+
+			fill_until(clock(), 1);
+			_stats.latency.add(ticks_to_us(now - write_start));
+		}
+
+		_stats.test_duration_us = ticks_to_us(now);
+
+		return Result::OK;
+	}
+
+	void save_csv() {
+		auto path = next_filename_stem_matching_pattern(u"SDB_????");
+		if( path.empty() ) {
+			return;
+		}
+		path.replace_extension(u".CSV");
+
+		File file;
+		if( file.create(path).is_valid() ) {
+			return;
+		}
+
+		const auto& latency = _stats.latency;
+		for(const auto& line : {
+			"write_size," + to_string_dec_uint(config.write_size),
+			"buffer_count," + to_string_dec_uint(config.buffer_count),
+			"rate_bytes_per_second," + to_string_dec_uint(config.rate),
+			"duration_us," + to_string_dec_uint(_stats.test_duration_us),
+			"writes," + to_string_dec_uint(latency.count()),
+			"write_bytes," + to_string_dec_uint(_stats.write_bytes),
+			"p50_us," + to_string_dec_uint(latency.percentile(5000)),
+			"p99_us," + to_string_dec_uint(latency.percentile(9900)),
+			"p99.9_us," + to_string_dec_uint(latency.percentile(9990)),
+			"max_us," + to_string_dec_uint(latency.max()),
+			"intervals," + to_string_dec_uint(_stats.intervals),
+			"overflow_intervals," + to_string_dec_uint(_stats.overflow_intervals),
+			std::string { "" },
+			std::string { "latency_us_max,writes" },
+		}) {
+			if( file.write_line(line).is_valid() ) {
+				return;
+			}
+		}
+
+		for(size_t i=0; i<latency.bin_count(); i++) {
+			if( latency.bin_value(i) ) {
+				const auto line = to_string_dec_uint(LatencyHistogram::bin_max(i)) + "," + to_string_dec_uint(latency.bin_value(i));
+				if( file.write_line(line).is_valid() ) {
+					return;
+				}
+			}
+		}
+
+		_csv_path = path;
+	}
+};
+
 namespace ui {
 
 SDCardDebugView::SDCardDebugView(NavigationView& nav) {
@@ -256,10 +570,12 @@ SDCardDebugView::SDCardDebugView(NavigationView& nav) {
 		&text_test_read_rate_title,
 		&text_test_read_rate_value,
 		&button_test,
+		&button_benchmark,
 		&button_ok,
 	});
 
 	button_test.on_select = [this](Button&){ this->on_test(); };
+	button_benchmark.on_select = [&nav](Button&){ nav.push<SDCardBenchmarkView>(); };
 	button_ok.on_select = [&nav](Button&){ nav.pop(); };
 }
 
@@ -427,4 +743,148 @@ void SDCardDebugView::on_test() {
 	}
 }
 
+/* SDCardBenchmarkView **************************************************/
+
+SDCardBenchmarkView::SDCardBenchmarkView(NavigationView& nav) {
+	add_children({
+		&text_title,
+		&text_write_size_title,
+		&options_write_size,
+		&text_buffer_count_title,
+		&field_buffer_count,
+		&text_rate_title,
+		&options_rate,
+		&text_duration_title,
+		&options_duration,
+		&text_csv_title,
+		&options_csv,
+		&text_status_title,
+		&text_status_value,
+		&text_p50_p99_title,
+		&text_p50_p99_value,
+		&text_p999_max_title,
+		&text_p999_max_value,
+		&text_writes_title,
+		&text_writes_value,
+		&text_overflows_title,
+		&text_overflows_value,
+		&text_csv_value,
+		&button_start,
+		&button_ok,
+	});
+
+	options_write_size.on_change = [this](size_t, OptionsField::value_t v) {
+		this->write_size = v;
+	};
+	options_rate.on_change = [this](size_t, OptionsField::value_t v) {
+		this->rate = v;
+	};
+	options_duration.on_change = [this](size_t, OptionsField::value_t v) {
+		this->duration_seconds = v;
+	};
+	options_csv.on_change = [this](size_t, OptionsField::value_t v) {
+		this->save_csv = v;
+	};
+
+	/* The capture app's buffers. */
+	options_write_size.set_by_value(write_size);
+	field_buffer_count.set_value(3);
+	options_rate.set_by_value(rate);
+
+	button_start.on_select = [this](Button&){ this->on_start(); };
+	button_ok.on_select = [&nav](Button&){ nav.pop(); };
+
+	signal_token_tick_second = rtc_time::signal_tick_second += [this]() {
+		this->on_tick_second();
+	};
+}
+
+SDCardBenchmarkView::~SDCardBenchmarkView() {
+	rtc_time::signal_tick_second -= signal_token_tick_second;
+}
+
+void SDCardBenchmarkView::focus() {
+	button_start.focus();
+}
+
+void SDCardBenchmarkView::on_start() {
+	if( thread ) {
+		/* Stopping early still gives results for what ran. */
+		thread->stop();
+		show_results();
+		thread.reset();
+		button_start.set_text("Start");
+		return;
+	}
+
+	text_status_value.set("");
+	text_p50_p99_value.set("");
+	text_p999_max_value.set("");
+	text_writes_value.set("");
+	text_overflows_value.set("");
+	text_csv_value.set("");
+
+	thread = std::make_unique<SDCardBenchmarkThread>(SDCardBenchmarkThread::Config {
+		write_size,
+		static_cast<size_t>(field_buffer_count.value()),
+		rate,
+		duration_seconds,
+		save_csv,
+	});
+	button_start.set_text("Stop");
+	text_status_value.set("Running");
+}
+
+void SDCardBenchmarkView::on_tick_second() {
+	if( !thread ) {
+		return;
+	}
+
+	if( thread->result() == SDCardBenchmarkThread::Result::Incomplete ) {
+		text_status_value.set("Running " + to_string_dec_uint(thread->elapsed_seconds(), 4) + " s");
+	} else {
+		show_results();
+		thread.reset();
+		button_start.set_text("Start");
+	}
+}
+
+void SDCardBenchmarkView::show_results() {
+	if( thread->result() != SDCardBenchmarkThread::Result::OK ) {
+		text_status_value.set("Fail: " + to_string_dec_int(toUType(thread->result()), 4));
+		return;
+	}
+
+	const auto& stats = thread->stats();
+	const auto& latency = stats.latency;
+	const uint32_t seconds = stats.test_duration_us / 1000000U;
+	text_status_value.set("Done " + to_string_dec_uint(seconds, 4) + " s");
+
+	text_p50_p99_value.set(
+		format_3dot3_string(latency.percentile(5000)) + "/" +
+		format_3dot3_string(latency.percentile(9900))
+	);
+	text_p999_max_value.set(
+		format_3dot3_string(latency.percentile(9990)) + "/" +
+		format_3dot3_string(latency.max())
+	);
+	const uint32_t kbps = stats.test_duration_us ? (stats.write_bytes * 1000U / stats.test_duration_us) : 0;
+	text_writes_value.set(
+		to_string_dec_uint(latency.count(), 7) + " " +
+		format_3dot3_string(kbps) + " MB/s"
+	);
+
+	/* Overflows as a percentage of intervals, in hundredths. */
+	const uint32_t overflow_hundredths = stats.intervals ? (uint64_t(stats.overflow_intervals) * 10000U / stats.intervals) : 0;
+	text_overflows_value.set(
+		to_string_dec_uint(stats.overflow_intervals, 8) + " " +
+		to_string_dec_uint(overflow_hundredths / 100, 3) + "." +
+		to_string_dec_uint(overflow_hundredths % 100, 2, '0') + "%"
+	);
+
+	if( !thread->csv_path().empty() ) {
+		text_csv_value.set(thread->csv_path().string());
+	}
+}
+
 } /* namespace ui */
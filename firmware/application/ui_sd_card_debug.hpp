@@ -27,6 +27,10 @@
 
 #include "sd_card.hpp"
 
+#include <memory>
+
+class SDCardBenchmarkThread;
+
 namespace ui {
 
 class SDCardDebugView : public View {
@@ -189,10 +193,193 @@ private:
 	///////////////////////////////////////////////////////////////////////
 
 	Button button_test {
-		{ 16, 17 * 16, 96, 24 },
+		{ 8, 17 * 16, 72, 24 },
 		"Test"
 	};
 
+	Button button_benchmark {
+		{ 84, 17 * 16, 72, 24 },
+		"Bench"
+	};
+
+	Button button_ok {
+		{ 240 - 72 - 8, 17 * 16, 72, 24 },
+		"OK"
+	};
+};
+
+/* Writes at a capture's rate, in its buffer sizes, for as long as a
+ * capture might run, to predict whether a card will drop samples.
+ */
+class SDCardBenchmarkView : public View {
+public:
+	SDCardBenchmarkView(NavigationView& nav);
+	~SDCardBenchmarkView();
+
+	void focus() override;
+
+private:
+	std::unique_ptr<SDCardBenchmarkThread> thread { };
+	SignalToken signal_token_tick_second { };
+
+	size_t write_size { 16384 };
+	uint32_t rate { 2000000 };
+	uint32_t duration_seconds { 10 };
+	bool save_csv { false };
+
+	void on_start();
+	void on_tick_second();
+	void show_results();
+
+	Text text_title {
+		{ (240 - (17 * 8)) / 2, 1 * 16, (17 * 8), 16 },
+		"SD Card Benchmark",
+	};
+
+	Text text_write_size_title {
+		{ 0, 3 * 16, (10 * 8), 16 },
+		"Write size",
+	};
+
+	OptionsField options_write_size {
+		{ 240 - (6 * 8), 3 * 16 },
+		6,
+		{
+			{ " 4096", 4096 },
+			{ " 8192", 8192 },
+			{ "16384", 16384 },
+			{ "32768", 32768 },
+		}
+	};
+
+	Text text_buffer_count_title {
+		{ 0, 4 * 16, (7 * 8), 16 },
+		"Buffers",
+	};
+
+	NumberField field_buffer_count {
+		{ 240 - (1 * 8), 4 * 16 },
+		1,
+		{ 2, 8 },
+		1,
+		' ',
+	};
+
+	Text text_rate_title {
+		{ 0, 5 * 16, (4 * 8), 16 },
+		"Rate",
+	};
+
+	/* Capture formats' rates, in bytes per second. */
+	OptionsField options_rate {
+		{ 240 - (15 * 8), 5 * 16 },
+		15,
+		{
+			{ "1MB/s C8  500k", 1000000 },
+			{ "2MB/s C16 500k", 2000000 },
+			{ "2MB/s C8    1M", 2000000 },
+			{ "4MB/s C8    2M", 4000000 },
+			{ "8MB/s C8    4M", 8000000 },
+		}
+	};
+
+	Text text_duration_title {
+		{ 0, 6 * 16, (8 * 8), 16 },
+		"Duration",
+	};
+
+	OptionsField options_duration {
+		{ 240 - (5 * 8), 6 * 16 },
+		5,
+		{
+			{ "  10s", 10 },
+			{ " 1min", 60 },
+			{ " 5min", 300 },
+			{ "15min", 900 },
+			{ "60min", 3600 },
+		}
+	};
+
+	Text text_csv_title {
+		{ 0, 7 * 16, (8 * 8), 16 },
+		"Save CSV",
+	};
+
+	OptionsField options_csv {
+		{ 240 - (3 * 8), 7 * 16 },
+		3,
+		{
+			{ " No", 0 },
+			{ "Yes", 1 },
+		}
+	};
+
+	///////////////////////////////////////////////////////////////////////
+
+	static constexpr size_t result_characters = 20;
+
+	Text text_status_title {
+		{ 0, 9 * 16, (6 * 8), 16 },
+		"Status",
+	};
+
+	Text text_status_value {
+		{ 240 - (result_characters * 8), 9 * 16, (result_characters * 8), 16 },
+		"",
+	};
+
+	Text text_p50_p99_title {
+		{ 0, 10 * 16, (10 * 8), 16 },
+		"p50/p99 ms",
+	};
+
+	Text text_p50_p99_value {
+		{ 240 - (result_characters * 8), 10 * 16, (result_characters * 8), 16 },
+		"",
+	};
+
+	Text text_p999_max_title {
+		{ 0, 11 * 16, (10 * 8), 16 },
+		"p99.9/max",
+	};
+
+	Text text_p999_max_value {
+		{ 240 - (result_characters * 8), 11 * 16, (result_characters * 8), 16 },
+		"",
+	};
+
+	Text text_writes_title {
+		{ 0, 12 * 16, (6 * 8), 16 },
+		"Writes",
+	};
+
+	Text text_writes_value {
+		{ 240 - (result_characters * 8), 12 * 16, (result_characters * 8), 16 },
+		"",
+	};
+
+	Text text_overflows_title {
+		{ 0, 13 * 16, (9 * 8), 16 },
+		"Overflows",
+	};
+
+	Text text_overflows_value {
+		{ 240 - (result_characters * 8), 13 * 16, (result_characters * 8), 16 },
+		"",
+	};
+
+	Text text_csv_value {
+		{ 240 - (result_characters * 8), 14 * 16, (result_characters * 8), 16 },
+		"",
+	};
+
+	///////////////////////////////////////////////////////////////////////
+
+	Button button_start {
+		{ 16, 17 * 16, 96, 24 },
+		"Start"
+	};
+
 	Button button_ok {
 		{ 240 - 96 - 16, 17 * 16, 96, 24 },
 		"OK"
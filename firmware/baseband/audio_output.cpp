@@ -30,14 +30,14 @@
 #include <cstdint>
 #include <cstddef>
 #include <array>
+#include <algorithm>
 
 void AudioOutput::configure(
 	const iir_biquad_config_t& hpf_config,
 	const iir_biquad_config_t& deemph_config,
 	const float squelch_threshold
 ) {
-	hpf.configure(hpf_config);
-	deemph.configure(deemph_config);
+	audio_filter.configure({ { hpf_config, deemph_config } });
 	squelch.set_threshold(squelch_threshold);
 }
 
@@ -69,41 +69,46 @@ void AudioOutput::write(
 void AudioOutput::on_block(
 	const buffer_f32_t& audio
 ) {
-	const auto audio_present_now = squelch.execute(audio);
-
-	hpf.execute_in_place(audio);
-	deemph.execute_in_place(audio);
+	/* Squelch's non-audio filter and the audio filters share one Q15 pass. */
+	std::array<int16_t, block_samples> audio_int;
+	const size_t count = std::min(audio.count, audio_int.size());
+	for(size_t i=0; i<count; i++) {
+		const int32_t sample = audio.p[i] * k;
+		squelch.feed(sample);
+		audio_int[i] = __SSAT(audio_filter.execute(sample), 16);
+	}
+	const auto audio_present_now = squelch.audio_present();
 
 	audio_present_history = (audio_present_history << 1) | (audio_present_now ? 1 : 0);
 	const bool audio_present = (audio_present_history != 0);
 	
 	if( !audio_present ) {
-		for(size_t i=0; i<audio.count; i++) {
-			audio.p[i] = 0;
+		for(size_t i=0; i<count; i++) {
+			audio_int[i] = 0;
 		}
 	}
 
-	fill_audio_buffer(audio, audio_present);
+	fill_audio_buffer({ audio_int.data(), count, audio.sampling_rate }, audio_present);
 }
 
-void AudioOutput::fill_audio_buffer(const buffer_f32_t& audio, const bool send_to_fifo) {
-	std::array<int16_t, 32> audio_int;
-
+void AudioOutput::fill_audio_buffer(const buffer_s16_t& audio, const bool send_to_fifo) {
+	/* A short block leaves the rest of the DMA buffer silent. */
 	auto audio_buffer = audio::dma::tx_empty_buffer();
-	for(size_t i=0; i<audio_buffer.count; i++) {
-		const int32_t sample_int = audio.p[i] * k;
-		const int32_t sample_saturated = __SSAT(sample_int, 16);
-		audio_buffer.p[i].left = audio_buffer.p[i].right = sample_saturated;
-		audio_int[i] = sample_saturated;
+	const size_t count = std::min(audio.count, audio_buffer.count);
+	for(size_t i=0; i<count; i++) {
+		audio_buffer.p[i].left = audio_buffer.p[i].right = audio.p[i];
+	}
+	for(size_t i=count; i<audio_buffer.count; i++) {
+		audio_buffer.p[i].left = audio_buffer.p[i].right = 0;
 	}
 	if( stream && send_to_fifo ) {
-		stream->write(audio_int.data(), audio_buffer.count * sizeof(audio_int[0]));
+		stream->write(audio.p, audio.count * sizeof(audio.p[0]));
 	}
 
 	feed_audio_stats(audio);
 }
 
-void AudioOutput::feed_audio_stats(const buffer_f32_t& audio) {
+void AudioOutput::feed_audio_stats(const buffer_s16_t& audio) {
 	audio_stats.feed(
 		audio,
 		[](const AudioStatistics& statistics) {
@@ -53,10 +53,15 @@ private:
 	static constexpr float k = 32768.0f;
 	static constexpr float ki = 1.0f / k;
 
-	BlockDecimator<float, 32> block_buffer { 1 };	
+	/* One audio DMA buffer's worth. on_block() converts into a stack array
+	 * of this size.
+	 */
+	static constexpr size_t block_samples = 32;
 
-	IIRBiquadFilter hpf { };
-	IIRBiquadFilter deemph { };
+	BlockDecimator<float, block_samples> block_buffer { 1 };	
+
+	/* HPF, then de-emphasis. */
+	IIRBiquadCascade<2> audio_filter { };
 	FMSquelch squelch { };
 
 	std::unique_ptr<StreamInput> stream { };
@@ -66,8 +71,8 @@ private:
 	uint64_t audio_present_history = 0;
 
 	void on_block(const buffer_f32_t& audio);
-	void fill_audio_buffer(const buffer_f32_t& audio, const bool send_to_fifo);
-	void feed_audio_stats(const buffer_f32_t& audio);
+	void fill_audio_buffer(const buffer_s16_t& audio, const bool send_to_fifo);
+	void feed_audio_stats(const buffer_s16_t& audio);
 };
 
 #endif/*__AUDIO_OUTPUT_H__*/
@@ -23,17 +23,26 @@
 
 #include "utility.hpp"
 
-void AudioStatsCollector::consume_audio_buffer(const buffer_f32_t& src) {
-	auto src_p = src.p;
-	const auto src_end = &src.p[src.count];
-	while(src_p < src_end) {
-		const auto sample = *(src_p++);
-		const auto sample_squared = sample * sample;
-		squared_sum += sample_squared;
-		if( sample_squared > max_squared ) {
-			max_squared = sample_squared;
+void AudioStatsCollector::consume_audio_buffer(const buffer_s16_t& src) {
+	/* Q15 samples: squares are Q30, scaled to full scale == 1.0. */
+	constexpr float k = 1.0f / (1U << 30);
+
+	int64_t block_squared_sum = 0;
+	uint32_t block_max_squared = 0;
+	for(size_t i=0; i<src.count; i++) {
+		const int32_t sample = src.p[i];
+		const uint32_t sample_squared = sample * sample;
+		block_squared_sum += sample_squared;
+		if( sample_squared > block_max_squared ) {
+			block_max_squared = sample_squared;
 		}
 	}
+
+	squared_sum += block_squared_sum * k;
+	const float block_max_squared_f = block_max_squared * k;
+	if( block_max_squared_f > max_squared ) {
+		max_squared = block_max_squared_f;
+	}
 }
 
 bool AudioStatsCollector::update_stats(const size_t sample_count, const size_t sampling_rate) {
@@ -56,7 +65,7 @@ bool AudioStatsCollector::update_stats(const size_t sample_count, const size_t s
 	}
 }
 
-bool AudioStatsCollector::feed(const buffer_f32_t& src) {
+bool AudioStatsCollector::feed(const buffer_s16_t& src) {
 	consume_audio_buffer(src);
 
 	return update_stats(src.count, src.sampling_rate);
@@ -79,7 +79,8 @@ void _default_exit(void) {
 	ShutdownMessage shutdown_message;
 	shared_memory.application_queue.push(shutdown_message);
 
-	shared_memory.baseband_message = nullptr;
+	shared_memory.m4_halted = true;
+	lpc43xx::creg::m4txevent::assert();
 
 	halt();
 }
@@ -86,11 +86,6 @@ constexpr gpdma::channel::Config config(const baseband::Direction direction) {
 	};
 }
 
-constexpr size_t buffer_samples_log2n = 13;
-constexpr size_t buffer_samples = (1 << buffer_samples_log2n);
-constexpr size_t transfers_per_buffer_log2n = 2;
-constexpr size_t transfers_per_buffer = (1 << transfers_per_buffer_log2n);
-constexpr size_t transfer_samples = buffer_samples / transfers_per_buffer;
 constexpr size_t transfers_mask = transfers_per_buffer - 1;
 
 constexpr size_t buffer_bytes = buffer_samples * sizeof(baseband::sample_t);
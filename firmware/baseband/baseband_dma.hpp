@@ -31,6 +31,14 @@
 namespace baseband {
 namespace dma {
 
+constexpr size_t buffer_samples_log2n = 13;
+constexpr size_t buffer_samples = (1 << buffer_samples_log2n);
+constexpr size_t transfers_per_buffer_log2n = 2;
+constexpr size_t transfers_per_buffer = (1 << transfers_per_buffer_log2n);
+
+/* Samples in each buffer handed to BasebandProcessor::execute(). */
+constexpr size_t transfer_samples = buffer_samples / transfers_per_buffer;
+
 void init();
 void configure(
 	baseband::sample_t* const buffer_base,
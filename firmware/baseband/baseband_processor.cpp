@@ -34,3 +34,17 @@ void BasebandProcessor::feed_channel_stats(const buffer_c16_t& channel) {
 		}
 	);
 }
+
+void BasebandProcessor::configure_stage_stats(const StageStatisticsConfigMessage& message) {
+	stage_stats.set_enabled(message.enabled);
+}
+
+void BasebandProcessor::feed_stage_stats(const buffer_c8_t& buffer) {
+	stage_stats.process(
+		buffer,
+		[](const StageStatistics& statistics) {
+			const StageStatisticsMessage stage_stats_message { statistics };
+			shared_memory.application_queue.push(stage_stats_message);
+		}
+	);
+}
@@ -25,6 +25,7 @@
 #include "dsp_types.hpp"
 
 #include "channel_stats_collector.hpp"
+#include "stage_stats_collector.hpp"
 
 #include "message.hpp"
 
@@ -36,11 +37,30 @@ public:
 
 	virtual void on_message(const Message* const) { };
 
+	void configure_stage_stats(const StageStatisticsConfigMessage& message);
+
 protected:
+	using Stage = StageStatistics::Stage;
+
 	void feed_channel_stats(const buffer_c16_t& channel);
 
+	/* Per-stage cycle accounting, off until the application enables it.
+	 * Bracket execute() with stage_stats_start() and feed_stage_stats(), and
+	 * call stage_stats_lap() as each stage finishes.
+	 */
+	void stage_stats_start() {
+		stage_stats.start();
+	}
+
+	void stage_stats_lap(const Stage stage) {
+		stage_stats.lap(stage);
+	}
+
+	void feed_stage_stats(const buffer_c8_t& buffer);
+
 private:
 	ChannelStatsCollector channel_stats { };
+	StageStatsCollector stage_stats { };
 };
 
 #endif/*__BASEBAND_PROCESSOR_H__*/
@@ -42,6 +42,7 @@ static baseband::SGPIO baseband_sgpio;
 WORKING_AREA(baseband_thread_wa, 4096);
 
 Thread* BasebandThread::thread = nullptr;
+std::unique_ptr<ReplaySource> BasebandThread::replay { };
 
 BasebandThread::BasebandThread(
 	uint32_t sampling_rate,
@@ -62,6 +63,15 @@ BasebandThread::~BasebandThread() {
 	chThdTerminate(thread);
 	chThdWait(thread);
 	thread = nullptr;
+	replay.reset();
+}
+
+void BasebandThread::set_replay(ReplayConfig* const config) {
+	if( config ) {
+		replay = std::make_unique<ReplaySource>(config);
+	} else {
+		replay.reset();
+	}
 }
 
 void BasebandThread::run() {
@@ -80,6 +90,11 @@ void BasebandThread::run() {
 	baseband_sgpio.streaming_enable();
 
 	while( !chThdShouldTerminate() ) {
+		if( replay ) {
+			run_replay();
+			continue;
+		}
+
 		// TODO: Place correct sampling rate into buffer returned here:
 		const auto buffer_tmp = baseband::dma::wait_for_buffer();
 		if( buffer_tmp ) {
@@ -97,3 +112,15 @@ void BasebandThread::run() {
 	baseband::dma::disable();
 	baseband_sgpio.streaming_disable();
 }
+
+void BasebandThread::run_replay() {
+	const auto buffer = replay->read(sampling_rate);
+	if( buffer && baseband_processor ) {
+		baseband_processor->execute(buffer);
+	}
+
+	const auto ticks = replay->pace(buffer, sampling_rate);
+	if( ticks > 0 ) {
+		chThdSleep(ticks);
+	}
+}
@@ -25,9 +25,12 @@
 #include "thread_base.hpp"
 #include "message.hpp"
 #include "baseband_processor.hpp"
+#include "replay_source.hpp"
 
 #include <ch.h>
 
+#include <memory>
+
 class BasebandThread : public ThreadBase {
 public:
 	BasebandThread(
@@ -49,14 +52,23 @@ public:
 		return _direction;
 	}
 
+	/* Runs the processor on samples from the application in place of the
+	 * radio's, or on the radio's again for nullptr. Called from the event
+	 * loop, which only runs while this thread waits, and this thread doesn't
+	 * hold on to the replay across waits.
+	 */
+	static void set_replay(ReplayConfig* const config);
+
 private:
 	static Thread* thread;
+	static std::unique_ptr<ReplaySource> replay;
 
 	BasebandProcessor* baseband_processor { nullptr };
 	baseband::Direction _direction { baseband::Direction::Receive };
 	uint32_t sampling_rate { 0 };
 
 	void run() override;
+	void run_replay();
 };
 
 #endif/*__BASEBAND_THREAD_H__*/
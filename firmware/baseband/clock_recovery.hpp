@@ -52,7 +52,13 @@ public:
 
 		if( symbol_phase == 0 ) {
 			const auto symbol = t[0];
-			const float lateness = (t[0] - t[2]) * t[1];
+			/* Without a transition, t[1] carries no timing information. Its
+			 * sign would still count in full with FixedErrorFilter, and on
+			 * alternating preambles (e.g. AIS "0101" NRZI, "++--") cancels
+			 * the transitions' error, so timing never pulls in.
+			 */
+			const bool transition = (t[0] < 0.0f) != (t[2] < 0.0f);
+			const float lateness = transition ? (t[0] - t[2]) * t[1] : 0.0f;
 			symbol_handler(symbol, lateness);
 		}
 
@@ -102,6 +108,9 @@ public:
 	float operator()(
 		const float lateness
 	) const {
+		if( lateness == 0.0f ) {
+			return 0.0f;
+		}
 		return (lateness < 0.0f) ? weight() : -weight();
 	}
 
@@ -140,7 +149,7 @@ public:
 		ErrorFilter error_filter
 	) {
 		resampler.configure(sampling_rate, symbol_rate * timing_error_detector.samples_per_symbol);
-		error_filter = error_filter;
+		this->error_filter = error_filter;
 	}
 
 	void operator()(
@@ -21,7 +21,8 @@
 
 #include "dsp_decimate.hpp"
 
-#include <hal.h>
+#include <algorithm>
+#include <type_traits>
 
 namespace dsp {
 namespace decimate {
@@ -108,7 +109,7 @@ static inline complex32_t mac_shift_and_store(
 	return { real, imag };
 }
 
-static inline complex32_t mac_fs4_shift_and_store_new_c8_samples(
+static inline complex32_t mac_fs4_shift_and_store_new_samples(
 	vec2_s16* const z,
 	const vec2_s16* const t,
 	const vec4_s8* const in,
@@ -135,7 +136,30 @@ static inline complex32_t mac_fs4_shift_and_store_new_c8_samples(
 	return { real, imag };
 }
 
-static inline complex32_t mac_shift_and_store_new_c16_samples(
+static inline complex32_t mac_shift_and_store_new_samples(
+	vec2_s16* const z,
+	const vec2_s16* const t,
+	const vec4_s8* const in,
+	const size_t decimation_factor,
+	const size_t index,
+	const size_t length,
+	const complex32_t accum
+) {
+	/* Accumulate sample * tap results for new samples.
+	 * Place new samples into z buffer.
+	 */
+	const auto q1_i1_q0_i0 = in[index];
+	const auto i1_i0 = sxtb16(q1_i1_q0_i0);
+	const auto q1_q0 = sxtb16(q1_i1_q0_i0, 8);
+	const auto t1_t0 = t[(length - decimation_factor) / 2 + index];
+	z[length - decimation_factor * 2 + index*2 + 0] = i1_i0;
+	const auto real = smlad(i1_i0, t1_t0, accum.real());
+	z[length - decimation_factor * 2 + index*2 + 1] = q1_q0;
+	const auto imag = smlad(q1_q0, t1_t0, accum.imag());
+	return { real, imag };
+}
+
+static inline complex32_t mac_shift_and_store_new_samples(
 	vec2_s16* const z,
 	const vec2_s16* const t,
 	const vec2_s16* const in,
@@ -146,7 +170,6 @@ static inline complex32_t mac_shift_and_store_new_c16_samples(
 ) {
 	/* Accumulate sample * tap results for new samples.
 	 * Place new samples into z buffer.
-	 * Expect negated tap t[2] to accomodate instruction set limitations.
 	 */
 	const auto q0_i0 = in[index*2+0];
 	const auto q1_i1 = in[index*2+1];
@@ -160,6 +183,36 @@ static inline complex32_t mac_shift_and_store_new_c16_samples(
 	return { real, imag };
 }
 
+/* Fs/4 translation is only implemented for complex8_t input; dispatching
+ * on the stage's FS4Shift keeps the other input type from instantiating it.
+ */
+static inline complex32_t mac_store_new_samples(
+	std::true_type,
+	vec2_s16* const z,
+	const vec2_s16* const t,
+	const vec4_s8* const in,
+	const size_t decimation_factor,
+	const size_t index,
+	const size_t length,
+	const complex32_t accum
+) {
+	return mac_fs4_shift_and_store_new_samples(z, t, in, decimation_factor, index, length, accum);
+}
+
+template<typename InputType>
+static inline complex32_t mac_store_new_samples(
+	std::false_type,
+	vec2_s16* const z,
+	const vec2_s16* const t,
+	const InputType* const in,
+	const size_t decimation_factor,
+	const size_t index,
+	const size_t length,
+	const complex32_t accum
+) {
+	return mac_shift_and_store_new_samples(z, t, in, decimation_factor, index, length, accum);
+}
+
 static inline uint32_t scale_round_and_pack(
 	const complex32_t value,
 	const int32_t scale_factor
@@ -191,22 +244,52 @@ static void taps_copy(
 	}
 }
 
-// FIRC8xR16x24FS4Decim4 //////////////////////////////////////////////////
+// FIRCxR16Decim //////////////////////////////////////////////////////////
+
+/* Calls f(0), f(1), ... f(N-1) with compile-time constant indices, so each
+ * MAC step is emitted inline with constant z/t offsets.
+ */
+template<typename F, size_t... I>
+static inline void unroll(F f, std::index_sequence<I...>) {
+	const int sequence[] = { 0, (f(std::integral_constant<size_t, I>()), 0)... };
+	(void)sequence;
+}
+
+template<size_t N, typename F>
+static inline void unroll(F f) {
+	unroll(f, std::make_index_sequence<N>());
+}
+
+template<typename SampleType, size_t TapsCount, size_t DecimationFactor, bool FS4Shift>
+void FIRCxR16Decim<SampleType, TapsCount, DecimationFactor, FS4Shift>::configure(
+	const std::array<tap_t, taps_count>& taps,
+	const int32_t scale
+) {
+	configure_taps(taps, scale, false);
+}
 
-void FIRC8xR16x24FS4Decim4::configure(
+template<typename SampleType, size_t TapsCount, size_t DecimationFactor, bool FS4Shift>
+void FIRCxR16Decim<SampleType, TapsCount, DecimationFactor, FS4Shift>::configure_taps(
 	const std::array<tap_t, taps_count>& taps,
 	const int32_t scale,
-	const Shift shift
+	const bool shift_up
 ) {
-	taps_copy(taps.data(), taps_.data(), taps_.size(), shift == Shift::Up);
+	if( fs4_shift ) {
+		taps_copy(taps.data(), taps_.data(), taps_.size(), shift_up);
+	} else {
+		std::copy(taps.cbegin(), taps.cend(), taps_.begin());
+	}
 	output_scale = scale;
 	z_.fill({});
 }
 
-buffer_c16_t FIRC8xR16x24FS4Decim4::execute(
-	const buffer_c8_t& src,
+template<typename SampleType, size_t TapsCount, size_t DecimationFactor, bool FS4Shift>
+buffer_c16_t FIRCxR16Decim<SampleType, TapsCount, DecimationFactor, FS4Shift>::execute(
+	const buffer_t<sample_t>& src,
 	const buffer_c16_t& dst
 ) {
+	using input_t = typename std::conditional<std::is_same<sample_t, complex8_t>::value, vec4_s8, vec2_s16>::type;
+
 	vec2_s16* const z = static_cast<vec2_s16*>(__builtin_assume_aligned(z_.data(), 4));
 	const vec2_s16* const t = static_cast<vec2_s16*>(__builtin_assume_aligned(taps_.data(), 4));
 	uint32_t* const d = static_cast<uint32_t*>(__builtin_assume_aligned(dst.p, 4));
@@ -215,27 +298,28 @@ buffer_c16_t FIRC8xR16x24FS4Decim4::execute(
 
 	const size_t count = src.count / decimation_factor;
 	for(size_t i=0; i<count; i++) {
-		const vec4_s8* const in = static_cast<const vec4_s8*>(__builtin_assume_aligned(&src.p[i * decimation_factor], 4));
+		const input_t* const in = static_cast<const input_t*>(__builtin_assume_aligned(&src.p[i * decimation_factor], 4));
 
 		complex32_t accum;
 
 		// Oldest samples are discarded.
-		accum = mac_fs4_shift(z, t, 0, accum);
-		accum = mac_fs4_shift(z, t, 1, accum);
+		unroll<decimation_factor / 2>([&](const size_t index) {
+			accum = fs4_shift
+				? mac_fs4_shift(z, t, index, accum)
+				: mac_shift(z, t, index, accum);
+		});
 
 		// Middle samples are shifted earlier in the "z" delay buffer.
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 0, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 1, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 2, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 3, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 4, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 5, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 6, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 7, accum);
+		unroll<(taps_count - decimation_factor * 2) / 2>([&](const size_t index) {
+			accum = fs4_shift
+				? mac_fs4_shift_and_store(z, t, decimation_factor, index, accum)
+				: mac_shift_and_store(z, t, decimation_factor, index, accum);
+		});
 
 		// Newest samples come from "in" buffer, are copied to "z" delay buffer.
-		accum = mac_fs4_shift_and_store_new_c8_samples(z, t, in, decimation_factor, 0, taps_count, accum);
-		accum = mac_fs4_shift_and_store_new_c8_samples(z, t, in, decimation_factor, 1, taps_count, accum);
+		unroll<decimation_factor / 2>([&](const size_t index) {
+			accum = mac_store_new_samples(std::integral_constant<bool, fs4_shift>(), z, t, in, decimation_factor, index, taps_count, accum);
+		});
 
 		d[i] = scale_round_and_pack(accum, k);
 	}
@@ -247,6 +331,10 @@ buffer_c16_t FIRC8xR16x24FS4Decim4::execute(
 	};
 }
 
+/* Stage configurations in use. Code is only generated for these. */
+template class FIRCxR16Decim<complex8_t, 24, 4, true>;
+template class FIRCxR16Decim<complex16_t, 16, 2, false>;
+
 // FIRC8xR16x24FS4Decim8 //////////////////////////////////////////////////
 
 void FIRC8xR16x24FS4Decim8::configure(
@@ -288,61 +376,10 @@ buffer_c16_t FIRC8xR16x24FS4Decim8::execute(
 		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 3, accum);
 
 		// Newest samples come from "in" buffer, are copied to "z" delay buffer.
-		accum = mac_fs4_shift_and_store_new_c8_samples(z, t, in, decimation_factor, 0, taps_count, accum);
-		accum = mac_fs4_shift_and_store_new_c8_samples(z, t, in, decimation_factor, 1, taps_count, accum);
-		accum = mac_fs4_shift_and_store_new_c8_samples(z, t, in, decimation_factor, 2, taps_count, accum);
-		accum = mac_fs4_shift_and_store_new_c8_samples(z, t, in, decimation_factor, 3, taps_count, accum);
-
-		d[i] = scale_round_and_pack(accum, k);
-	}
-
-	return {
-		dst.p,
-		count,
-		src.sampling_rate / decimation_factor
-	};
-}
-
-// FIRC16xR16x16Decim2 ////////////////////////////////////////////////////
-
-void FIRC16xR16x16Decim2::configure(
-	const std::array<tap_t, taps_count>& taps,
-	const int32_t scale
-) {
-	std::copy(taps.cbegin(), taps.cend(), taps_.begin());
-	output_scale = scale;
-	z_.fill({});
-}
-
-buffer_c16_t FIRC16xR16x16Decim2::execute(
-	const buffer_c16_t& src,
-	const buffer_c16_t& dst
-) {
-	vec2_s16* const z = static_cast<vec2_s16*>(__builtin_assume_aligned(z_.data(), 4));
-	const vec2_s16* const t = static_cast<vec2_s16*>(__builtin_assume_aligned(taps_.data(), 4));
-	uint32_t* const d = static_cast<uint32_t*>(__builtin_assume_aligned(dst.p, 4));
-
-	const auto k = output_scale;
-
-	const size_t count = src.count / decimation_factor;
-	for(size_t i=0; i<count; i++) {
-		const vec2_s16* const in = static_cast<const vec2_s16*>(__builtin_assume_aligned(&src.p[i * decimation_factor], 4));
-
-		complex32_t accum;
-
-		// Oldest samples are discarded.
-		accum = mac_shift(z, t, 0, accum);
-
-		// Middle samples are shifted earlier in the "z" delay buffer.
-		accum = mac_shift_and_store(z, t, decimation_factor, 0, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 1, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 2, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 3, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 4, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 5, accum);
-
-		// Newest samples come from "in" buffer, are copied to "z" delay buffer.
-		accum = mac_shift_and_store_new_c16_samples(z, t, in, decimation_factor, 0, taps_count, accum);
+		accum = mac_fs4_shift_and_store_new_samples(z, t, in, decimation_factor, 0, taps_count, accum);
+		accum = mac_fs4_shift_and_store_new_samples(z, t, in, decimation_factor, 1, taps_count, accum);
+		accum = mac_fs4_shift_and_store_new_samples(z, t, in, decimation_factor, 2, taps_count, accum);
+		accum = mac_fs4_shift_and_store_new_samples(z, t, in, decimation_factor, 3, taps_count, accum);
 
 		d[i] = scale_round_and_pack(accum, k);
 	}
@@ -398,10 +435,10 @@ buffer_c16_t FIRC16xR16x32Decim8::execute(
 		accum = mac_shift_and_store(z, t, decimation_factor, 7, accum);
 
 		// Newest samples come from "in" buffer, are copied to "z" delay buffer.
-		accum = mac_shift_and_store_new_c16_samples(z, t, in, decimation_factor, 0, taps_count, accum);
-		accum = mac_shift_and_store_new_c16_samples(z, t, in, decimation_factor, 1, taps_count, accum);
-		accum = mac_shift_and_store_new_c16_samples(z, t, in, decimation_factor, 2, taps_count, accum);
-		accum = mac_shift_and_store_new_c16_samples(z, t, in, decimation_factor, 3, taps_count, accum);
+		accum = mac_shift_and_store_new_samples(z, t, in, decimation_factor, 0, taps_count, accum);
+		accum = mac_shift_and_store_new_samples(z, t, in, decimation_factor, 1, taps_count, accum);
+		accum = mac_shift_and_store_new_samples(z, t, in, decimation_factor, 2, taps_count, accum);
+		accum = mac_shift_and_store_new_samples(z, t, in, decimation_factor, 3, taps_count, accum);
 
 		d[i] = scale_round_and_pack(accum, k);
 	}
@@ -648,120 +685,120 @@ buffer_s16_t FIR64AndDecimateBy2Real::execute(
 void FIRAndDecimateComplex::configure_common(
 	const size_t taps_count, const size_t decimation_factor
 ) {
-	samples_ = std::make_unique<samples_t>(taps_count);
-	taps_reversed_ = std::make_unique<taps_t>(taps_count);
+	history_.fill({});
+	taps_reversed_.fill({});
 	taps_count_ = taps_count;
 	decimation_factor_ = decimation_factor;
+	write_index_ = 0;
+	samples_to_output_ = decimation_factor;
+}
+
+uint32_t FIRAndDecimateComplex::filter(const sample_t* const z) const {
+	/* Complex multiply-accumulate of the taps_count_ samples starting at z
+	 * (oldest first) with the reversed taps, two 16x16 MACs per tap into
+	 * 64-bit accumulators.
+	 * taps are normalized to 1 << 16 == 1.0.
+	 */
+	auto t_p = &taps_reversed_[0];
+	auto z_p = z;
+
+	int64_t t_real = 0;
+	int64_t t_imag = 0;
+
+	size_t loop_count = taps_count_ / 4;
+	while(loop_count > 0) {
+		const auto tap0 = *__SIMD32(t_p)++;
+		const auto sample0 = *__SIMD32(z_p)++;
+		const auto tap1 = *__SIMD32(t_p)++;
+		const auto sample1 = *__SIMD32(z_p)++;
+		t_real = __SMLSLD(sample0, tap0, t_real);
+		t_imag = __SMLALDX(sample0, tap0, t_imag);
+		t_real = __SMLSLD(sample1, tap1, t_real);
+		t_imag = __SMLALDX(sample1, tap1, t_imag);
+
+		const auto tap2 = *__SIMD32(t_p)++;
+		const auto sample2 = *__SIMD32(z_p)++;
+		const auto tap3 = *__SIMD32(t_p)++;
+		const auto sample3 = *__SIMD32(z_p)++;
+		t_real = __SMLSLD(sample2, tap2, t_real);
+		t_imag = __SMLALDX(sample2, tap2, t_imag);
+		t_real = __SMLSLD(sample3, tap3, t_real);
+		t_imag = __SMLALDX(sample3, tap3, t_imag);
+
+		loop_count--;
+	}
+
+	loop_count = taps_count_ % 4;
+	while(loop_count > 0) {
+		const auto tap = *__SIMD32(t_p)++;
+		const auto sample = *__SIMD32(z_p)++;
+		t_real = __SMLSLD(sample, tap, t_real);
+		t_imag = __SMLALDX(sample, tap, t_imag);
+
+		loop_count--;
+	}
+
+	/* TODO: Re-evaluate whether saturation is performed, normalization,
+	 * all that jazz.
+	 */
+	const int32_t r = t_real >> 16;
+	const int32_t i = t_imag >> 16;
+	const int32_t r_sat = __SSAT(r, 16);
+	const int32_t i_sat = __SSAT(i, 16);
+	return __PKHBT(
+		r_sat,
+		i_sat,
+		16
+	);
 }
 
 buffer_c16_t FIRAndDecimateComplex::execute(
 	const buffer_c16_t& src,
 	const buffer_c16_t& dst
 ) {
-	/* int16_t input (sample count "n" must be multiple of decimation_factor)
+	/* int16_t input (any sample count)
 	 * -> int16_t output, decimated by decimation_factor.
-	 * taps are normalized to 1 << 16 == 1.0.
+	 * Only the outputs that survive decimation are computed. Each output
+	 * consumes at least one new input sample, so dst may be the same buffer
+	 * as src.
 	 */
-	const auto output_sampling_rate = src.sampling_rate / decimation_factor_;
-	const size_t output_samples = src.count / decimation_factor_;
-	
-	sample_t* dst_p = dst.p;
-	const buffer_c16_t result { dst.p, output_samples, output_sampling_rate };
+	const size_t taps_count = taps_count_;
+	sample_t* const z = &history_[0];
 
-	const sample_t* src_p = src.p;
-	size_t outer_count = output_samples;
-	while(outer_count > 0) {
-		/* Put new samples into delay buffer */
-		auto z_new_p = &samples_[taps_count_ - decimation_factor_];
-		for(size_t i=0; i<decimation_factor_; i++) {
-			*__SIMD32(z_new_p)++ = *__SIMD32(src_p)++;
-		}
+	auto write_index = write_index_;
+	auto samples_to_output = samples_to_output_;
 
-		size_t loop_count = taps_count_ / 8;
-		auto t_p = &taps_reversed_[0];
-		auto z_p = &samples_[0];
-
-		int64_t t_real = 0;
-		int64_t t_imag = 0;
-
-		while(loop_count > 0) {
-			const auto tap0 = *__SIMD32(t_p)++;
-			const auto sample0 = *__SIMD32(z_p)++;
-			const auto tap1 = *__SIMD32(t_p)++;
-			const auto sample1 = *__SIMD32(z_p)++;
-			t_real = __SMLSLD(sample0, tap0, t_real);
-			t_imag = __SMLALDX(sample0, tap0, t_imag);
-			t_real = __SMLSLD(sample1, tap1, t_real);
-			t_imag = __SMLALDX(sample1, tap1, t_imag);
-
-			const auto tap2 = *__SIMD32(t_p)++;
-			const auto sample2 = *__SIMD32(z_p)++;
-			const auto tap3 = *__SIMD32(t_p)++;
-			const auto sample3 = *__SIMD32(z_p)++;
-			t_real = __SMLSLD(sample2, tap2, t_real);
-			t_imag = __SMLALDX(sample2, tap2, t_imag);
-			t_real = __SMLSLD(sample3, tap3, t_real);
-			t_imag = __SMLALDX(sample3, tap3, t_imag);
-
-			const auto tap4 = *__SIMD32(t_p)++;
-			const auto sample4 = *__SIMD32(z_p)++;
-			const auto tap5 = *__SIMD32(t_p)++;
-			const auto sample5 = *__SIMD32(z_p)++;
-			t_real = __SMLSLD(sample4, tap4, t_real);
-			t_imag = __SMLALDX(sample4, tap4, t_imag);
-			t_real = __SMLSLD(sample5, tap5, t_real);
-			t_imag = __SMLALDX(sample5, tap5, t_imag);
-
-			const auto tap6 = *__SIMD32(t_p)++;
-			const auto sample6 = *__SIMD32(z_p)++;
-			const auto tap7 = *__SIMD32(t_p)++;
-			const auto sample7 = *__SIMD32(z_p)++;
-			t_real = __SMLSLD(sample6, tap6, t_real);
-			t_imag = __SMLALDX(sample6, tap6, t_imag);
-			t_real = __SMLSLD(sample7, tap7, t_real);
-			t_imag = __SMLALDX(sample7, tap7, t_imag);
-
-			loop_count--;
-		}
+	const sample_t* src_p = src.p;
+	const sample_t* const src_end = &src.p[src.count];
+	uint32_t* dst_p = reinterpret_cast<uint32_t*>(dst.p);
 
-		/* TODO: Re-evaluate whether saturation is performed, normalization,
-		 * all that jazz.
-		 */
-		const int32_t r = t_real >> 16;
-		const int32_t i = t_imag >> 16;
-		const int32_t r_sat = __SSAT(r, 16);
-		const int32_t i_sat = __SSAT(i, 16);
-		*__SIMD32(dst_p)++ = __PKHBT(
-			r_sat,
-			i_sat,
-			16
-		);
-
-		/* Shift sample buffer left/down by decimation factor. */
-		const size_t unroll_factor = 4;
-		size_t shift_count = (taps_count_ - decimation_factor_) / unroll_factor;
-
-		sample_t* t = &samples_[0];
-		const sample_t* s = &samples_[decimation_factor_];
-		
-		while(shift_count > 0) {
-			*__SIMD32(t)++ = *__SIMD32(s)++;
-			*__SIMD32(t)++ = *__SIMD32(s)++;
-			*__SIMD32(t)++ = *__SIMD32(s)++;
-			*__SIMD32(t)++ = *__SIMD32(s)++;
-			shift_count--;
+	while(src_p < src_end) {
+		/* Put new samples into delay buffer, until an output is due. */
+		const size_t src_remaining = src_end - src_p;
+		size_t copy_count = std::min(samples_to_output, src_remaining);
+		samples_to_output -= copy_count;
+		while(copy_count > 0) {
+			const auto sample = *(src_p++);
+			z[write_index] = sample;
+			z[write_index + taps_count] = sample;
+			write_index = (write_index + 1 == taps_count) ? 0 : (write_index + 1);
+			copy_count--;
 		}
 
-		shift_count = (taps_count_ - decimation_factor_) % unroll_factor;
-		while(shift_count > 0) {
-			*(t++) = *(s++);
-			shift_count--;
+		if( samples_to_output == 0 ) {
+			*(dst_p++) = filter(&z[write_index]);
+			samples_to_output = decimation_factor_;
 		}
-
-		outer_count--;
 	}
 
-	return result;
+	write_index_ = write_index;
+	samples_to_output_ = samples_to_output;
+
+	return {
+		dst.p,
+		static_cast<size_t>(dst_p - reinterpret_cast<uint32_t*>(dst.p)),
+		src.sampling_rate / decimation_factor_
+	};
 }
 
 buffer_s16_t DecimateBy2CIC4Real::execute(
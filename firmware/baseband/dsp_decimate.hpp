@@ -24,8 +24,9 @@
 
 #include <cstdint>
 #include <array>
-#include <memory>
 #include <algorithm>
+#include <type_traits>
+#include <utility>
 
 #include "utility.hpp"
 
@@ -38,6 +39,8 @@ namespace decimate {
 
 class Complex8DecimateBy2CIC3 {
 public:
+	static constexpr size_t decimation_factor = 2;
+
 	buffer_c16_t execute(
 		const buffer_c8_t& src,
 		const buffer_c16_t& dst
@@ -50,6 +53,8 @@ private:
 
 class TranslateByFSOver4AndDecimateBy2CIC3 {
 public:
+	static constexpr size_t decimation_factor = 2;
+
 	buffer_c16_t execute(
 		const buffer_c8_t& src,
 		const buffer_c16_t& dst
@@ -62,6 +67,8 @@ private:
 
 class DecimateBy2CIC3 {
 public:
+	static constexpr size_t decimation_factor = 2;
+
 	buffer_c16_t execute(
 		const buffer_c16_t& src,
 		const buffer_c16_t& dst
@@ -75,6 +82,7 @@ private:
 class FIR64AndDecimateBy2Real {
 public:
 	static constexpr size_t taps_count = 64;
+	static constexpr size_t decimation_factor = 2;
 
 	void configure(
 		const std::array<int16_t, taps_count>& taps
@@ -90,14 +98,34 @@ private:
 	std::array<int16_t, taps_count> taps { };
 };
 
-class FIRC8xR16x24FS4Decim4 {
+/* Complex FIR decimator with real int16_t taps. Tap count, decimation
+ * factor, input sample type (complex8_t or complex16_t) and an optional
+ * Fs/4 translation (complex8_t input only) are fixed at compile time, and
+ * the multiply-accumulate sequence is fully unrolled into dual 16-bit MACs
+ * (SMLAD/SMLSD).
+ *
+ * Member functions are defined in dsp_decimate.cpp. To add a new stage,
+ * add an explicit instantiation there and (optionally) an alias below.
+ */
+template<typename SampleType, size_t TapsCount, size_t DecimationFactor, bool FS4Shift>
+class FIRCxR16Decim {
 public:
-	static constexpr size_t taps_count = 24;
-	static constexpr size_t decimation_factor = 4;
+	static constexpr size_t taps_count = TapsCount;
+	static constexpr size_t decimation_factor = DecimationFactor;
+	static constexpr bool fs4_shift = FS4Shift;
 
-	using sample_t = complex8_t;
+	using sample_t = SampleType;
 	using tap_t = int16_t;
 
+	static_assert(
+		std::is_same<sample_t, complex8_t>::value || std::is_same<sample_t, complex16_t>::value,
+		"Input must be complex8_t or complex16_t"
+	);
+	static_assert((decimation_factor >= 2) && ((decimation_factor & 1) == 0), "Decimation factor must be even");
+	static_assert((taps_count & 1) == 0, "Taps count must be even");
+	static_assert(taps_count >= decimation_factor * 2, "Taps count must be at least twice the decimation factor");
+	static_assert(!fs4_shift || std::is_same<sample_t, complex8_t>::value, "Fs/4 translation needs complex8_t input");
+
 	enum class Shift : bool {
 		Down = true,
 		Up = false
@@ -105,12 +133,21 @@ public:
 
 	void configure(
 		const std::array<tap_t, taps_count>& taps,
-		const int32_t scale,
-		const Shift shift = Shift::Down
+		const int32_t scale
 	);
 
+	/* Fs/4 stages only, to pick the direction of translation. */
+	template<bool S = fs4_shift, typename = typename std::enable_if<S>::type>
+	void configure(
+		const std::array<tap_t, taps_count>& taps,
+		const int32_t scale,
+		const Shift shift
+	) {
+		configure_taps(taps, scale, shift == Shift::Up);
+	}
+
 	buffer_c16_t execute(
-		const buffer_c8_t& src,
+		const buffer_t<sample_t>& src,
 		const buffer_c16_t& dst
 	);
 	
@@ -118,8 +155,20 @@ private:
 	std::array<vec2_s16, taps_count - decimation_factor> z_ { };
 	std::array<tap_t, taps_count> taps_ { };
 	int32_t output_scale = 0;
+
+	void configure_taps(
+		const std::array<tap_t, taps_count>& taps,
+		const int32_t scale,
+		const bool shift_up
+	);
 };
 
+using FIRC8xR16x24FS4Decim4 = FIRCxR16Decim<complex8_t, 24, 4, true>;
+using FIRC16xR16x16Decim2 = FIRCxR16Decim<complex16_t, 16, 2, false>;
+
+/* The by-8 stages stay hand-written until Debug > Stage Cycles shows the
+ * template costing no more M4 cycles than these.
+ */
 class FIRC8xR16x24FS4Decim8 {
 public:
 	static constexpr size_t taps_count = 24;
@@ -150,30 +199,6 @@ private:
 	int32_t output_scale = 0;
 };
 
-class FIRC16xR16x16Decim2 {
-public:
-	static constexpr size_t taps_count = 16;
-	static constexpr size_t decimation_factor = 2;
-
-	using sample_t = complex16_t;
-	using tap_t = int16_t;
-
-	void configure(
-		const std::array<tap_t, taps_count>& taps,
-		const int32_t scale
-	);
-
-	buffer_c16_t execute(
-		const buffer_c16_t& src,
-		const buffer_c16_t& dst
-	);
-	
-private:
-	std::array<vec2_s16, taps_count - decimation_factor> z_ { };
-	std::array<tap_t, taps_count> taps_ { };
-	int32_t output_scale = 0;
-};
-
 class FIRC16xR16x32Decim8 {
 public:
 	static constexpr size_t taps_count = 32;
@@ -203,10 +228,10 @@ public:
 	using sample_t = complex16_t;
 	using tap_t = complex16_t;
 
-	using taps_t = tap_t[];
+	static constexpr size_t taps_count_max = 64;
 
-	/* NOTE! Current code makes an assumption that block of samples to be
-	 * processed will be a multiple of the taps_count.
+	/* Accepts blocks of any length. Decimation phase is carried from one
+	 * block to the next, so output count per block may vary by one.
 	 */
 
 	template<typename T>
@@ -214,6 +239,7 @@ public:
 		const T& taps,
 		const size_t decimation_factor
 	) {
+		static_assert(std::tuple_size<T>::value <= taps_count_max, "Too many taps");
 		configure(taps.data(), taps.size(), decimation_factor);
 	}
 
@@ -223,12 +249,17 @@ public:
 	);
 	
 private:
-	using samples_t = sample_t[];
-
-	std::unique_ptr<samples_t> samples_ { };
-	std::unique_ptr<taps_t> taps_reversed_ { };
+	/* Delay line is stored twice ("mirrored"): each new sample is written at
+	 * write_index_ and write_index_ + taps_count_, so the most recent
+	 * taps_count_ samples are always contiguous starting at write_index_,
+	 * and samples never need to be shifted.
+	 */
+	std::array<sample_t, taps_count_max * 2> history_ { };
+	std::array<tap_t, taps_count_max> taps_reversed_ { };
 	size_t taps_count_ { 0 };
 	size_t decimation_factor_ { 1 };
+	size_t write_index_ { 0 };
+	size_t samples_to_output_ { 1 };
 
 	template<typename T>
 	void configure(
@@ -244,10 +275,14 @@ private:
 		const size_t taps_count,
 		const size_t decimation_factor
 	);
+
+	uint32_t filter(const sample_t* const z) const;
 };
 
 class DecimateBy2CIC4Real {
 public:
+	static constexpr size_t decimation_factor = 2;
+
 	buffer_s16_t execute(
 		const buffer_s16_t& src,
 		const buffer_s16_t& dst
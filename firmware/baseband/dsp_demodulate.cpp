@@ -22,10 +22,14 @@
 #include "dsp_demodulate.hpp"
 
 #include "complex.hpp"
+#include "dsp_magnitude.hpp"
 #include "fxpt_atan2.hpp"
 #include "utility_m4.hpp"
 
-#include <hal.h>
+#include "simd.hpp"
+
+#include <cmath>
+#include <algorithm>
 
 namespace dsp {
 namespace demodulate {
@@ -40,10 +44,8 @@ buffer_f32_t AM::execute(
 	while(src_p < src_end) {
 		const uint32_t sample0 = *__SIMD32(src_p)++;
 		const uint32_t sample1 = *__SIMD32(src_p)++;
-		const uint32_t mag_sq0 = __SMUAD(sample0, sample0);
-		const uint32_t mag_sq1 = __SMUAD(sample1, sample1);
-		*(dst_p++) = __builtin_sqrtf(mag_sq0) * k;
-		*(dst_p++) = __builtin_sqrtf(mag_sq1) * k;
+		*(dst_p++) = magnitude::newton_sqrt(sample0) * k;
+		*(dst_p++) = magnitude::newton_sqrt(sample1) * k;
 	}
 
 	return { dst.p, src.count, src.sampling_rate };
@@ -72,11 +74,26 @@ static inline float angle_approx_4deg0(const complex32_t t) {
 }
 */
 static inline float angle_approx_0deg27(const complex32_t t) {
-	if( t.real() ) {
-		const auto x = static_cast<float>(t.imag()) / static_cast<float>(t.real());
-		return x / (1.0f + 0.28086f * x * x);
+	/* x / (1 + 0.28086 * x^2) is only accurate for |x| <= 1, so fold the
+	 * other octants onto it.
+	 */
+	const float re = t.real();
+	const float im = t.imag();
+	if( std::abs(im) <= std::abs(re) ) {
+		if( re == 0.0f ) {
+			return 0.0f;
+		}
+		const auto x = im / re;
+		const auto a = x / (1.0f + 0.28086f * x * x);
+		if( re > 0.0f ) {
+			return a;
+		} else {
+			return (im < 0.0f) ? (a - pi) : (a + pi);
+		}
 	} else {
-		return (t.imag() < 0) ? -1.5707963268f : 1.5707963268f;
+		const auto x = re / im;
+		const auto a = x / (1.0f + 0.28086f * x * x);
+		return (im < 0.0f) ? (-1.5707963268f - a) : (1.5707963268f - a);
 	}
 }
 
@@ -84,13 +101,46 @@ static inline float angle_precise(const complex32_t t) {
 	return atan2f(t.imag(), t.real());
 }
 
-buffer_f32_t FM::execute(
+static inline float angle_fxpt(const complex32_t t) {
+	/* fxpt_atan2() takes 16-bit inputs. Shift so the larger component uses
+	 * 15 bits of magnitude, keeping resolution for weak signals too.
+	 */
+	const int32_t re = t.real();
+	const int32_t im = t.imag();
+	const uint32_t magnitude_bits = (re ^ (re >> 31)) | (im ^ (im >> 31));
+	const size_t clz = __CLZ(magnitude_bits);
+	int16_t angle = 0;
+	if( clz < 17 ) {
+		angle = fxpt_atan2(im >> (17 - clz), re >> (17 - clz));
+	} else {
+		/* Multiplied, not shifted: left shifts of negative values are
+		 * undefined.
+		 */
+		const int32_t scale = 1 << (clz - 17);
+		angle = fxpt_atan2(im * scale, re * scale);
+	}
+	return angle * (pi / 32768.0f);
+}
+
+static inline void write_output(float*& dst_p, const float v) {
+	*(dst_p++) = v;
+}
+
+static inline void write_output(int16_t*& dst_p, const float v) {
+	const int32_t v_int = v;
+	*(dst_p++) = __SSAT(v_int, 16);
+}
+
+template<typename T, typename Angle>
+buffer_t<T> FM::execute_angle(
 	const buffer_c16_t& src,
-	const buffer_f32_t& dst
+	const buffer_t<T>& dst,
+	const float k,
+	Angle angle
 ) {
 	auto z = z_;
 
-	const auto src_p = src.p;
+	auto src_p = src.p;
 	const auto src_end = &src.p[src.count];
 	auto dst_p = dst.p;
 	while(src_p < src_end) {
@@ -99,51 +149,100 @@ buffer_f32_t FM::execute(
 		const auto t0 = multiply_conjugate_s16_s32(s0, z);
 		const auto t1 = multiply_conjugate_s16_s32(s1, s0);
 		z = s1;
-		*(dst_p++) = angle_precise(t0) * kf;
-		*(dst_p++) = angle_precise(t1) * kf;
+		write_output(dst_p, angle(t0) * k);
+		write_output(dst_p, angle(t1) * k);
 	}
 	z_ = z;
 
 	return { dst.p, src.count, src.sampling_rate };
 }
 
-buffer_s16_t FM::execute(
+template<typename T>
+buffer_t<T> FM::execute_quadricorrelator(
 	const buffer_c16_t& src,
-	const buffer_s16_t& dst
+	const buffer_t<T>& dst,
+	const float k
 ) {
+	/* Im(s[n] * conj(s[n-1])) = |s|^2 * sin(dtheta). Normalizing by the
+	 * previous block's mean power costs one division per block.
+	 *
+	 * SMUSDX cannot wrap: one product is at most 2^30, the other at least
+	 * -32768 * 32767, so the difference stays below 2^31. The normalized
+	 * value can still be far out of range when the signal steps up in
+	 * power, so it is clamped to +/-pi, the range of the angle engines.
+	 */
 	auto z = z_;
+	const float power_scale = power_inverse_;
+	int64_t power = 0;
 
-	const auto src_p = src.p;
+	auto src_p = src.p;
 	const auto src_end = &src.p[src.count];
 	auto dst_p = dst.p;
 	while(src_p < src_end) {
 		const auto s0 = *__SIMD32(src_p)++;
 		const auto s1 = *__SIMD32(src_p)++;
-		const auto t0 = multiply_conjugate_s16_s32(s0, z);
-		const auto t1 = multiply_conjugate_s16_s32(s1, s0);
+		const int32_t cross0 = __SMUSDX(z, s0);
+		const int32_t cross1 = __SMUSDX(s0, s1);
+		power = __SMLALD(s0, s0, power);
+		power = __SMLALD(s1, s1, power);
 		z = s1;
-		const int32_t theta0_int = angle_approx_0deg27(t0) * ks16;
-		const int32_t theta0_sat = __SSAT(theta0_int, 16);
-		const int32_t theta1_int = angle_approx_0deg27(t1) * ks16;
-		const int32_t theta1_sat = __SSAT(theta1_int, 16);
-		*__SIMD32(dst_p)++ = __PKHBT(
-			theta0_sat,
-			theta1_sat,
-			16
-		);
+		write_output(dst_p, std::max(-pi, std::min(pi, cross0 * power_scale)) * k);
+		write_output(dst_p, std::max(-pi, std::min(pi, cross1 * power_scale)) * k);
 	}
 	z_ = z;
 
+	power_inverse_ = (power > 0) ? (static_cast<float>(src.count) / power) : 0.0f;
+
 	return { dst.p, src.count, src.sampling_rate };
 }
 
+template<typename T>
+buffer_t<T> FM::execute_discriminator(
+	const buffer_c16_t& src,
+	const buffer_t<T>& dst,
+	const float k
+) {
+	switch(discriminator_) {
+	default:
+	case Discriminator::Precise:
+		return execute_angle(src, dst, k, [](const complex32_t t) { return angle_precise(t); });
+
+	case Discriminator::Polynomial:
+		return execute_angle(src, dst, k, [](const complex32_t t) { return angle_approx_0deg27(t); });
+
+	case Discriminator::FixedPoint:
+		return execute_angle(src, dst, k, [](const complex32_t t) { return angle_fxpt(t); });
+
+	case Discriminator::Quadricorrelator:
+		if( quadricorrelator_in_range() ) {
+			return execute_quadricorrelator(src, dst, k);
+		}
+		return execute_angle(src, dst, k, [](const complex32_t t) { return angle_approx_0deg27(t); });
+	}
+}
+
+buffer_f32_t FM::execute(
+	const buffer_c16_t& src,
+	const buffer_f32_t& dst
+) {
+	return execute_discriminator(src, dst, kf);
+}
+
+buffer_s16_t FM::execute(
+	const buffer_c16_t& src,
+	const buffer_s16_t& dst
+) {
+	return execute_discriminator(src, dst, ks16);
+}
+
 void FM::configure(const float sampling_rate, const float deviation_hz) {
 	/*
 	 * angle: -pi to pi. output range: -32768 to 32767.
 	 * Maximum delta-theta (output of atan2) at maximum deviation frequency:
 	 * delta_theta_max = 2 * pi * deviation / sampling_rate
 	 */
-	kf = static_cast<float>(1.0f / (2.0 * pi * deviation_hz / sampling_rate));
+	dtheta_max_ = 2.0 * pi * deviation_hz / sampling_rate;
+	kf = static_cast<float>(1.0f / dtheta_max_);
 	ks16 = 32767.0f * kf;
 }
 
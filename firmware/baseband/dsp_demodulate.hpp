@@ -51,6 +51,25 @@ private:
 
 class FM {
 public:
+	/* Phase difference estimators, in decreasing cost:
+	 * Precise: atan2f().
+	 * Polynomial: rational approximation of atan(), 0.27 degree error.
+	 * FixedPoint: fxpt_atan2() on 16-bit normalized inputs.
+	 * Quadricorrelator: cross product I*dQ - Q*dI, i.e. |s|^2 * sin(dtheta),
+	 *   normalized by the previous block's mean power. No per-sample
+	 *   division, but compresses large phase differences, so it is only
+	 *   used when the deviation keeps dtheta within
+	 *   quadricorrelator_dtheta_max. Otherwise Polynomial is used instead.
+	 *   No shipped NBFM or WFM configuration is that narrow (see their
+	 *   configure()), so for now only the benchmark runs it.
+	 */
+	enum class Discriminator {
+		Precise,
+		Polynomial,
+		FixedPoint,
+		Quadricorrelator,
+	};
+
 	buffer_f32_t execute(
 		const buffer_c16_t& src,
 		const buffer_f32_t& dst
@@ -63,10 +82,48 @@ public:
 
 	void configure(const float sampling_rate, const float deviation_hz);
 
+	void set_discriminator(const Discriminator discriminator) {
+		discriminator_ = discriminator;
+	}
+
+	/* sin(x) is within 1% of x up to here: harmonic distortion of a
+	 * full-deviation tone about -50dB.
+	 */
+	static constexpr float quadricorrelator_dtheta_max = 0.25f;
+
+	bool quadricorrelator_in_range() const {
+		return dtheta_max_ <= quadricorrelator_dtheta_max;
+	}
+
 private:
 	complex16_t::rep_type z_ { 0 };
 	float kf { 0 };
 	float ks16 { 0 };
+	float dtheta_max_ { 0 };
+	Discriminator discriminator_ { Discriminator::Precise };
+	float power_inverse_ { 0 };
+
+	template<typename T>
+	buffer_t<T> execute_discriminator(
+		const buffer_c16_t& src,
+		const buffer_t<T>& dst,
+		const float k
+	);
+
+	template<typename T, typename Angle>
+	buffer_t<T> execute_angle(
+		const buffer_c16_t& src,
+		const buffer_t<T>& dst,
+		const float k,
+		Angle angle
+	);
+
+	template<typename T>
+	buffer_t<T> execute_quadricorrelator(
+		const buffer_c16_t& src,
+		const buffer_t<T>& dst,
+		const float k
+	);
 };
 
 } /* namespace demodulate */
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_MAGNITUDE_H__
+#define __DSP_MAGNITUDE_H__
+
+#include "simd.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+
+/* Magnitude estimators for complex samples packed as the 32-bit word of a
+ * complex16_t (real in the low halfword, imaginary in the high halfword).
+ * None of them divide or take a square root.
+ */
+
+namespace dsp {
+namespace magnitude {
+
+/* Splits a word holding two complex8_t samples into two complex16_t words. */
+inline void unpack_c8_pair(const uint32_t c8_pair, uint32_t& iq0, uint32_t& iq1) {
+	const uint32_t re = __SXTB16(c8_pair);
+	const uint32_t im = __SXTB16(c8_pair, 8);
+	iq0 = __PKHBT(re, im, 16);
+	iq1 = __PKHTB(im, re, 16);
+}
+
+/* max(|I|, |Q|) * 123/128 + min(|I|, |Q|) * 51/128.
+ * Error is within -3.9% and +4.1% of |s|, varying with phase, plus
+ * truncation to an integer.
+ */
+inline uint32_t alpha_max_beta_min(const uint32_t iq) {
+	const int32_t re = static_cast<int16_t>(iq);
+	const int32_t im = static_cast<int32_t>(iq) >> 16;
+	const uint32_t re_abs = std::abs(re);
+	const uint32_t im_abs = std::abs(im);
+	const uint32_t max = (re_abs > im_abs) ? re_abs : im_abs;
+	const uint32_t min = (re_abs > im_abs) ? im_abs : re_abs;
+	return (max * 123 + min * 51) >> 7;
+}
+
+/* |s| from |s|^2 by two Newton iterations of 1/sqrt(x), which need no
+ * division, then multiplying by x. A linear first guess is within 8.7%;
+ * after two iterations the result is within 0.02% of |s|, plus 0.5 LSB of
+ * rounding.
+ */
+inline uint32_t newton_sqrt(const uint32_t iq) {
+	const uint32_t mag_sq = __SMUAD(iq, iq);
+	if( mag_sq == 0 ) {
+		return 0;
+	}
+
+	/* Normalize by an even shift so x is in [0.25, 1.0) as Q16. */
+	const size_t shift = __CLZ(mag_sq) & ~1U;
+	const uint32_t x = (mag_sq << shift) >> 16;
+
+	/* y ~= 1/sqrt(x), Q14, in (1.0, 2.0]. Newton steps approach the root
+	 * from below, so y*y stays under 4.0 and x*y*y fits 32 bits.
+	 */
+	uint32_t y = 34898 - ((19907 * x) >> 16);
+	for(size_t i=0; i<2; i++) {
+		const uint32_t y2 = (y * y) >> 14;
+		const uint32_t xy2 = (x * y2) >> 16;
+		y = (y * ((3 << 14) - xy2)) >> 15;
+	}
+
+	const size_t result_shift = 14 + shift / 2;
+	return (x * y + (1U << (result_shift - 1))) >> result_shift;
+}
+
+/* log2(|s|) as Q8, i.e. 256 per 6.02dB. The mantissa term log2(1 + f) is
+ * approximated by f + 0.3465 * f * (1 - f), within 0.0077, so the result is
+ * within 1.5 LSB (0.036dB). |s| < 1 returns 0.
+ */
+inline int32_t log2_q8(const uint32_t iq) {
+	const uint32_t mag_sq = __SMUAD(iq, iq);
+	if( mag_sq == 0 ) {
+		return 0;
+	}
+
+	const size_t clz = __CLZ(mag_sq);
+	const uint32_t f = ((mag_sq << clz) << 1) >> 16;
+	const uint32_t correction = (((f * (65536 - f)) >> 16) * 22708) >> 16;
+	/* log2(|s|) * 256 == log2(|s|^2) * 128 */
+	return ((31 - clz) << 7) + ((f + correction + 256) >> 9);
+}
+
+} /* namespace magnitude */
+} /* namespace dsp */
+
+#endif/*__DSP_MAGNITUDE_H__*/
@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_PIPELINE_H__
+#define __DSP_PIPELINE_H__
+
+#include "buffer.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <tuple>
+#include <type_traits>
+
+namespace dsp {
+namespace pipeline {
+
+namespace detail {
+
+template<typename... Ts>
+struct make_void {
+	using type = void;
+};
+
+template<typename... Ts>
+using void_t = typename make_void<Ts...>::type;
+
+/* Stages declare a static decimation_factor when it's fixed at compile
+ * time. Stages without one (decimation chosen at configure() time) are
+ * counted as 1, which bounds their output rate and size from above.
+ */
+template<typename Stage, typename = void>
+struct stage_decimation {
+	static constexpr size_t value = 1;
+	static constexpr bool fixed = false;
+};
+
+template<typename Stage>
+struct stage_decimation<Stage, void_t<decltype(Stage::decimation_factor)>> {
+	static constexpr size_t value = Stage::decimation_factor;
+	static constexpr bool fixed = true;
+};
+
+/* Kept outside Chain so static_assert and member array sizes in Chain can
+ * use them while Chain is still incomplete.
+ */
+template<typename... Stages>
+struct decimations {
+	static constexpr size_t at(const size_t n) {
+		constexpr size_t factors[] { stage_decimation<Stages>::value... };
+		return factors[n];
+	}
+
+	/* value after the first n stages. */
+	static constexpr size_t apply(size_t value, const size_t n) {
+		for(size_t i=0; i<n; i++) {
+			value /= at(i);
+		}
+		return value;
+	}
+
+	static constexpr bool divides_evenly(size_t value) {
+		for(size_t i=0; i<sizeof...(Stages); i++) {
+			if( (value % at(i)) != 0 ) {
+				return false;
+			}
+			value /= at(i);
+		}
+		return true;
+	}
+};
+
+} /* namespace detail */
+
+/* Gives a stage that takes its decimation factor at configure() time (e.g.
+ * FIRAndDecimateComplex) a compile-time one, so a Chain can derive rates
+ * through it.
+ */
+template<typename Stage, size_t DecimationFactor>
+class FixedDecimation : public Stage {
+public:
+	static constexpr size_t decimation_factor = DecimationFactor;
+
+	template<typename T>
+	void configure(const T& taps) {
+		Stage::configure(taps, decimation_factor);
+	}
+};
+
+/* Decimation stages run in series on blocks of InputCount samples at
+ * InputSamplingRate. The first stage reads InputType and every stage
+ * writes OutputType.
+ *
+ * Stages read each input sample before writing any output at or beyond
+ * it, so after the first stage they run in place. The only storage is one
+ * buffer sized exactly for the first stage's output.
+ */
+template<
+	typename InputType,
+	typename OutputType,
+	size_t InputSamplingRate,
+	size_t InputCount,
+	typename... Stages
+>
+class Chain {
+	using decimations_t = detail::decimations<Stages...>;
+
+public:
+	static constexpr size_t stages_count = sizeof...(Stages);
+
+	static_assert(stages_count > 0, "Chain needs at least one stage");
+
+	/* Decimation of stage n. */
+	static constexpr size_t decimation_factor(const size_t n) {
+		return decimations_t::at(n);
+	}
+
+	/* Sampling rate into stage n. n == stages_count gives the chain's
+	 * output rate. Stages without fixed decimation count as 1.
+	 */
+	static constexpr size_t sampling_rate(const size_t n) {
+		return decimations_t::apply(InputSamplingRate, n);
+	}
+
+	/* Samples per block into stage n, as sampling_rate(). */
+	static constexpr size_t count(const size_t n) {
+		return decimations_t::apply(InputCount, n);
+	}
+
+	template<size_t N>
+	using stage_t = typename std::tuple_element<N, std::tuple<Stages...>>::type;
+
+	static_assert(detail::stage_decimation<stage_t<0>>::fixed, "First stage sizes the buffer, so its decimation must be fixed");
+	static_assert(decimations_t::divides_evenly(InputSamplingRate), "Every stage must decimate the sampling rate to a whole number");
+	static_assert(decimations_t::divides_evenly(InputCount), "Every stage must decimate the block size to a whole number");
+
+	template<size_t N>
+	stage_t<N>& stage() {
+		return std::get<N>(stages_);
+	}
+
+	buffer_t<OutputType> execute(const buffer_t<InputType>& src) {
+		return execute(src, [](const size_t) { });
+	}
+
+	/* Calls observer(n) as each stage n finishes, e.g. to time stages. */
+	template<typename Observer>
+	buffer_t<OutputType> execute(const buffer_t<InputType>& src, Observer observer) {
+		const auto out = std::get<0>(stages_).execute(src, buffer());
+		observer(0);
+		return execute_from(out, observer, std::integral_constant<size_t, 1>());
+	}
+
+	/* The chain's storage, for callers to use in place after execute(). */
+	template<typename T>
+	buffer_t<T> work_buffer() {
+		return {
+			reinterpret_cast<T*>(storage_.data()),
+			sizeof(storage_) / sizeof(T)
+		};
+	}
+
+private:
+	std::tuple<Stages...> stages_ { };
+
+	std::array<OutputType, decimations_t::apply(InputCount, 1)> storage_ { };
+
+	/* Built on each use rather than stored, so a copied Chain doesn't
+	 * write into the original's storage.
+	 */
+	buffer_t<OutputType> buffer() {
+		return {
+			storage_.data(),
+			storage_.size()
+		};
+	}
+
+	template<typename Observer>
+	buffer_t<OutputType> execute_from(
+		const buffer_t<OutputType>& src,
+		Observer&,
+		std::integral_constant<size_t, stages_count>
+	) {
+		return src;
+	}
+
+	template<typename Observer, size_t N>
+	buffer_t<OutputType> execute_from(
+		const buffer_t<OutputType>& src,
+		Observer& observer,
+		std::integral_constant<size_t, N>
+	) {
+		const auto out = std::get<N>(stages_).execute(src, buffer());
+		observer(N);
+		return execute_from(out, observer, std::integral_constant<size_t, N + 1>());
+	}
+};
+
+} /* namespace pipeline */
+} /* namespace dsp */
+
+#endif/*__DSP_PIPELINE_H__*/
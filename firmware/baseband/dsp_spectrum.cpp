@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "dsp_spectrum.hpp"
+
+#include "dsp_fft.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace dsp {
+namespace spectrum {
+
+namespace {
+
+/* Window table is computed by the compiler. */
+
+constexpr double abs_d(const double x) {
+	return (x < 0.0) ? -x : x;
+}
+
+constexpr double sin_d(const double x) {
+	if( x < 0.0 ) {
+		return -sin_d(-x);
+	}
+	const double turns = x / (2.0 * fft_detail::pi_d);
+	const double quadrants = (turns - static_cast<uint64_t>(turns)) * 4.0;
+	const size_t quadrant = static_cast<size_t>(quadrants);
+	const double y = (quadrants - quadrant) * (fft_detail::pi_d / 2.0);
+	return (quadrant == 0) ?  fft_detail::sin_first_quadrant(y)
+	     : (quadrant == 1) ?  fft_detail::cos_first_quadrant(y)
+	     : (quadrant == 2) ? -fft_detail::sin_first_quadrant(y)
+	     :                   -fft_detail::cos_first_quadrant(y);
+}
+
+constexpr double cos_d(const double x) {
+	return sin_d(x + fft_detail::pi_d / 2.0);
+}
+
+/* Lowpass prototype, cut off at half a bin, Blackman windowed. window_length
+ * is even, so the sinc is never evaluated at zero.
+ */
+constexpr double prototype(const size_t n) {
+	const double t = (n - (window_length - 1) / 2.0) / fft_size;
+	const double sinc = sin_d(fft_detail::pi_d * t) / (fft_detail::pi_d * t);
+	const double a = 2.0 * fft_detail::pi_d * n / (window_length - 1);
+	const double blackman = 0.42 - 0.5 * cos_d(a) + 0.08 * cos_d(2.0 * a);
+	return sinc * blackman;
+}
+
+/* Largest sum of |taps| feeding one output sample. Normalizing to this
+ * keeps the presum from overflowing.
+ */
+constexpr double prototype_phase_sum_max() {
+	double result = 0.0;
+	for(size_t k=0; k<fft_size; k++) {
+		double sum = 0.0;
+		for(size_t p=0; p<taps_per_bin; p++) {
+			sum += abs_d(prototype(k + p * fft_size));
+		}
+		result = (sum > result) ? sum : result;
+	}
+	return result;
+}
+
+constexpr double window_scale = 1.0 / prototype_phase_sum_max();
+
+template<size_t... I>
+constexpr std::array<int16_t, sizeof...(I)> make_window_half(std::index_sequence<I...>) {
+	return { { fft_detail::to_q15(prototype(I) * window_scale)... } };
+}
+
+/* Window is symmetric, so only the first half is stored. */
+alignas(4) constexpr std::array<int16_t, window_length / 2> window_half = make_window_half(std::make_index_sequence<window_length / 2>{ });
+
+/* Q15 window * int8 sample: 22 bits, back to 15. */
+constexpr size_t presum_shift = 7;
+
+inline float bin_power(const complex16_t v) {
+	/* Unsigned: only (-32768, -32768) exceeds INT32_MAX. */
+	return static_cast<uint32_t>(__SMUAD(v.__rep(), v.__rep()));
+}
+
+} /* namespace */
+
+void wola_presum(const complex8_t* const src, frame_t& dst) {
+	/* Two adjacent output samples per iteration: one 32-bit load per tap
+	 * holds two complex8 samples, which SXTB16 splits into real and
+	 * imaginary halfword pairs. Taps 0 and 1 read the half window forwards,
+	 * taps 2 and 3 read it backwards, so their halfwords are swapped.
+	 */
+	const vec4_s8* const in = reinterpret_cast<const vec4_s8*>(src);
+	const uint32_t* const w = reinterpret_cast<const uint32_t*>(window_half.data());
+	uint32_t* const out = reinterpret_cast<uint32_t*>(dst.data());
+
+	for(size_t k=0; k<fft_size; k+=2) {
+		const auto x0 = in[(k + fft_size * 0) / 2].w;
+		const auto x1 = in[(k + fft_size * 1) / 2].w;
+		const auto x2 = in[(k + fft_size * 2) / 2].w;
+		const auto x3 = in[(k + fft_size * 3) / 2].w;
+
+		const auto w0 = w[(k + fft_size * 0) / 2];
+		const auto w1 = w[(k + fft_size * 1) / 2];
+		const auto w2 = w[(window_length / 2 - fft_size * 0 - 2 - k) / 2];
+		const auto w3 = w[(window_length / 2 - fft_size * 1 - 2 - k) / 2];
+
+		const auto re0 = __SXTB16(x0, 0);
+		const auto im0 = __SXTB16(x0, 8);
+		int32_t re_a = __SMULBB(re0, w0);
+		int32_t im_a = __SMULBB(im0, w0);
+		int32_t re_b = __SMULTT(re0, w0);
+		int32_t im_b = __SMULTT(im0, w0);
+
+		const auto re1 = __SXTB16(x1, 0);
+		const auto im1 = __SXTB16(x1, 8);
+		re_a = __SMLABB(re1, w1, re_a);
+		im_a = __SMLABB(im1, w1, im_a);
+		re_b = __SMLATT(re1, w1, re_b);
+		im_b = __SMLATT(im1, w1, im_b);
+
+		const auto re2 = __SXTB16(x2, 0);
+		const auto im2 = __SXTB16(x2, 8);
+		re_a = __SMLABT(re2, w2, re_a);
+		im_a = __SMLABT(im2, w2, im_a);
+		re_b = __SMLATB(re2, w2, re_b);
+		im_b = __SMLATB(im2, w2, im_b);
+
+		const auto re3 = __SXTB16(x3, 0);
+		const auto im3 = __SXTB16(x3, 8);
+		re_a = __SMLABT(re3, w3, re_a);
+		im_a = __SMLABT(im3, w3, im_a);
+		re_b = __SMLATB(re3, w3, re_b);
+		im_b = __SMLATB(im3, w3, im_b);
+
+		const size_t k_rev = __RBIT(k) >> (32 - log_2(fft_size));
+		out[k_rev] = __PKHBT(__SSAT(re_a >> presum_shift, 16), __SSAT(im_a >> presum_shift, 16), 16);
+		out[k_rev + fft_size / 2] = __PKHBT(__SSAT(re_b >> presum_shift, 16), __SSAT(im_b >> presum_shift, 16), 16);
+	}
+}
+
+void power_accumulate(const frame_t& bins, power_t& acc) {
+	for(size_t i=0; i<bins.size(); i++) {
+		acc[i] += bin_power(bins[i]);
+	}
+}
+
+void power_peak(const frame_t& bins, power_t& acc) {
+	for(size_t i=0; i<bins.size(); i++) {
+		acc[i] = std::max(acc[i], bin_power(bins[i]));
+	}
+}
+
+void power_exponential(const frame_t& bins, power_t& acc, const float alpha) {
+	for(size_t i=0; i<bins.size(); i++) {
+		acc[i] += (bin_power(bins[i]) - acc[i]) * alpha;
+	}
+}
+
+} /* namespace spectrum */
+} /* namespace dsp */
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __DSP_SPECTRUM_H__
+#define __DSP_SPECTRUM_H__
+
+#include "dsp_types.hpp"
+#include "complex.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace dsp {
+namespace spectrum {
+
+/* Weighted overlap-add (polyphase presum) front end for a 256-point FFT.
+ *
+ * window_length input samples are weighted by a windowed-sinc prototype
+ * filter and folded modulo fft_size. Each FFT bin then gets a flat-topped
+ * response about one bin wide with low sidelobes, where a plain 256-sample
+ * frame gets the sinc response of a rectangular window.
+ */
+constexpr size_t fft_size = 256;
+constexpr size_t taps_per_bin = 4;
+constexpr size_t window_length = fft_size * taps_per_bin;
+
+using frame_t = std::array<complex16_t, fft_size>;
+using power_t = std::array<float, fft_size>;
+
+/* Reads window_length samples from src, which must be 32-bit aligned.
+ * Output is in bit-reversed order, ready for fft_c_q15_preswapped().
+ * Full-scale complex8 input produces full-scale Q15 output.
+ */
+void wola_presum(const complex8_t* const src, frame_t& dst);
+
+/* Bin power (re^2 + im^2) of Q15 FFT output, combined into acc. */
+void power_accumulate(const frame_t& bins, power_t& acc);
+void power_peak(const frame_t& bins, power_t& acc);
+void power_exponential(const frame_t& bins, power_t& acc, const float alpha);
+
+} /* namespace spectrum */
+} /* namespace dsp */
+
+#endif/*__DSP_SPECTRUM_H__*/
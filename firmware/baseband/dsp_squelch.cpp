@@ -22,32 +22,17 @@
 #include "dsp_squelch.hpp"
 
 #include <cstdint>
-#include <array>
 
-bool FMSquelch::execute(const buffer_f32_t& audio) {
-	if( threshold_squared == 0.0f ) {
+bool FMSquelch::audio_present() {
+	if( threshold == 0 ) {
 		return true;
 	}
 
-	// TODO: No hard-coded array size.
-	std::array<float, N> squelch_energy_buffer;
-	const buffer_f32_t squelch_energy {
-		squelch_energy_buffer.data(),
-		squelch_energy_buffer.size()
-	};
-	non_audio_hpf.execute(audio, squelch_energy);
-
-	float non_audio_max_squared = 0;
-	for(const auto sample : squelch_energy_buffer) {
-		const float sample_squared = sample * sample;
-		if( sample_squared > non_audio_max_squared ) {
-			non_audio_max_squared = sample_squared;
-		}
-	}
-
-	return (non_audio_max_squared < threshold_squared);
+	const bool result = (non_audio_max < threshold);
+	non_audio_max = 0;
+	return result;
 }
 
 void FMSquelch::set_threshold(const float new_value) {
-	threshold_squared = new_value * new_value;
+	threshold = new_value * 32768.0f;
 }
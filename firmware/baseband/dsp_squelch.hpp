@@ -31,15 +31,31 @@
 
 class FMSquelch {
 public:
-	bool execute(const buffer_f32_t& audio);
+	/* Q15 samples, one at a time, so the caller can run this filter in the
+	 * same pass as its own.
+	 */
+	void feed(const int32_t sample) {
+		if( threshold ) {
+			const int32_t non_audio = non_audio_hpf.execute(sample);
+			const int32_t non_audio_abs = (non_audio < 0) ? -non_audio : non_audio;
+			if( non_audio_abs > non_audio_max ) {
+				non_audio_max = non_audio_abs;
+			}
+		}
+	}
+
+	/* True if samples fed since the last call had no energy above the
+	 * audio band.
+	 */
+	bool audio_present();
 
 	void set_threshold(const float new_value);
 
 private:
-	static constexpr size_t N = 32;
-	float threshold_squared { 0.0f };
+	int32_t threshold { 0 };
+	int32_t non_audio_max { 0 };
 
-	IIRBiquadFilter non_audio_hpf { non_audio_hpf_config };
+	IIRBiquadCascade<1> non_audio_hpf { { { non_audio_hpf_config } } };
 };
 
 #endif/*__DSP_SQUELCH_H__*/
@@ -33,6 +33,10 @@ using namespace lpc43xx;
 #include <cstdint>
 #include <array>
 
+/* Host builds (host/baseband_sim) have no interrupts or event loop thread,
+ * and provide their own run() and wait().
+ */
+#if defined(LPC43XX_M4)
 extern "C" {
 
 CH_IRQ_HANDLER(MAPP_IRQHandler) {
@@ -48,6 +52,7 @@ CH_IRQ_HANDLER(MAPP_IRQHandler) {
 }
 
 }
+#endif
 
 Thread* EventDispatcher::thread_event_loop = nullptr;
 
@@ -57,6 +62,7 @@ EventDispatcher::EventDispatcher(
 {
 }
 
+#if defined(LPC43XX_M4)
 void EventDispatcher::run() {
 	thread_event_loop = chThdSelf();
 
@@ -69,14 +75,17 @@ void EventDispatcher::run() {
 
 	lpc43xx::creg::m0apptxevent::disable();
 }
+#endif
 
 void EventDispatcher::request_stop() {
 	is_running = false;
 }
 
+#if defined(LPC43XX_M4)
 eventmask_t EventDispatcher::wait() {
 	return chEvtWaitAny(ALL_EVENTS);
 }
+#endif
 
 void EventDispatcher::dispatch(const eventmask_t events) {
 	if( events & EVT_MASK_BASEBAND ) {
@@ -89,10 +98,18 @@ void EventDispatcher::dispatch(const eventmask_t events) {
 }
 
 void EventDispatcher::handle_baseband_queue() {
-	const auto message = shared_memory.baseband_message;
-	if( message ) {
-		on_message(message);
+	if( shared_memory.baseband_queue.is_empty() ) {
+		return;
 	}
+
+	shared_memory.baseband_queue.handle([this](Message* const message) {
+		this->on_message(message);
+	});
+
+#if defined(LPC43XX_M4)
+	// Wake application threads waiting for their messages to be handled.
+	creg::m4txevent::assert();
+#endif
 }
 
 void EventDispatcher::on_message(const Message* const message) {
@@ -101,9 +118,16 @@ void EventDispatcher::on_message(const Message* const message) {
 		on_message_shutdown(*reinterpret_cast<const ShutdownMessage*>(message));
 		break;
 
+	case Message::ID::StageStatisticsConfig:
+		on_message_stage_statistics_config(*reinterpret_cast<const StageStatisticsConfigMessage*>(message));
+		break;
+
+	case Message::ID::ReplayConfig:
+		on_message_replay_config(*reinterpret_cast<const ReplayConfigMessage*>(message));
+		break;
+
 	default:
 		on_message_default(message);
-		shared_memory.baseband_message = nullptr;
 		break;
 	}
 }
@@ -112,6 +136,14 @@ void EventDispatcher::on_message_shutdown(const ShutdownMessage&) {
 	request_stop();
 }
 
+void EventDispatcher::on_message_stage_statistics_config(const StageStatisticsConfigMessage& message) {
+	baseband_processor->configure_stage_stats(message);
+}
+
+void EventDispatcher::on_message_replay_config(const ReplayConfigMessage& message) {
+	BasebandThread::set_replay(message.config);
+}
+
 void EventDispatcher::on_message_default(const Message* const message) {
 	baseband_processor->on_message(message);
 }
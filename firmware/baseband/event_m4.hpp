@@ -49,6 +49,11 @@ public:
 		chEvtSignalI(thread_event_loop, events);
 	}
 
+	/* Whether the event loop has events it hasn't handled yet. */
+	static inline bool events_pending() {
+		return thread_event_loop && thread_event_loop->p_epending;
+	}
+
 private:
 	static Thread* thread_event_loop;
 
@@ -64,6 +69,8 @@ private:
 
 	void on_message(const Message* const message);
 	void on_message_shutdown(const ShutdownMessage&);
+	void on_message_stage_statistics_config(const StageStatisticsConfigMessage& message);
+	void on_message_replay_config(const ReplayConfigMessage& message);
 	void on_message_default(const Message* const message);
 
 	void handle_spectrum();
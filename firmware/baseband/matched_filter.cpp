@@ -24,7 +24,7 @@
 #include <algorithm>
 #include <cmath>
 
-#include "utility.hpp"
+#include "simd.hpp"
 
 namespace dsp {
 namespace matched_filter {
@@ -34,74 +34,83 @@ void MatchedFilter::configure(
 	const size_t taps_count,
 	const size_t decimation_factor
 ) {
-	samples_ = std::make_unique<samples_t>(taps_count);
-	taps_reversed_ = std::make_unique<taps_t>(taps_count);
+	history_ = std::make_unique<words_t>(taps_count * 2);
+	taps_reversed_ = std::make_unique<words_t>(taps_count);
 	taps_count_ = taps_count;
+	write_index_ = 0;
 	decimation_factor_ = decimation_factor;
+	decimation_phase = 0;
 	output = 0;
-	std::reverse_copy(&taps[0], &taps[taps_count], &taps_reversed_[0]);
+
+	/* Scale the largest tap component to full scale Q15. */
+	float tap_max = 0.0f;
+	for(size_t n=0; n<taps_count; n++) {
+		tap_max = std::max(tap_max, std::max(std::abs(taps[n].real()), std::abs(taps[n].imag())));
+	}
+	const float tap_scale = (tap_max > 0.0f) ? (32767.0f / tap_max) : 0.0f;
+
+	for(size_t n=0; n<taps_count; n++) {
+		const auto& tap = taps[taps_count - 1 - n];
+		const complex16_t tap_q15 {
+			static_cast<int16_t>(std::round(tap.real() * tap_scale)),
+			static_cast<int16_t>(std::round(tap.imag() * tap_scale))
+		};
+		taps_reversed_[n] = tap_q15.__rep();
+	}
+
+	/* Correlations are taken >> 15 before squaring; undo the tap scaling
+	 * so output is in the same units as a float implementation's |P|^2.
+	 */
+	const float correlation_scale = (tap_scale > 0.0f) ? (32768.0f / tap_scale) : 0.0f;
+	output_scale_ = correlation_scale * correlation_scale;
+
+	std::fill(&history_[0], &history_[taps_count * 2], 0);
 }
 
 bool MatchedFilter::execute_once(
 	const sample_t input
 ) {
-	samples_[taps_count_ - decimation_factor_ + decimation_phase] = input;
+	history_[write_index_] = history_[write_index_ + taps_count_] = input.__rep();
+	write_index_++;
+	if( write_index_ == taps_count_ ) {
+		write_index_ = 0;
+	}
 
 	advance_decimation_phase();
 	if( is_new_decimation_cycle() ) {
-		float sr_tr = 0.0f;
-		float si_tr = 0.0f;
-		float si_ti = 0.0f;
-		float sr_ti = 0.0f;
-		for(size_t n=0; n<taps_count_; n++) {
-			const auto sample = samples_[n];
-			const auto tap = taps_reversed_[n];
+		/* Oldest sample first, to match the reversed taps. */
+		const uint32_t* const samples = &history_[write_index_];
+		const uint32_t* const taps = &taps_reversed_[0];
 
-			sr_tr += sample.real() * tap.real();
-			si_ti += sample.imag() * tap.imag();
-			si_tr += sample.imag() * tap.real();
-			sr_ti += sample.real() * tap.imag();
+		// N: complex multiply of samples and conjugate taps.
+		// P: complex multiply of samples and taps.
+		int64_t r_n = 0;
+		int64_t r_p = 0;
+		int64_t i_n = 0;
+		int64_t i_p = 0;
+		for(size_t n=0; n<taps_count_; n++) {
+			const auto sample = samples[n];
+			const auto tap = taps[n];
+			r_n = __SMLALD(sample, tap, r_n);
+			r_p = __SMLSLD(sample, tap, r_p);
+			i_n = __SMLSLDX(tap, sample, i_n);
+			i_p = __SMLALDX(sample, tap, i_p);
 		}
 
-		// N: complex multiple of samples and taps (conjugate, tap.i negated).
-		// P: complex multiply of samples and taps.
-		const auto r_n = sr_tr + si_ti;
-		const auto r_p = sr_tr - si_ti;
-		const auto i_n = si_tr - sr_ti;
-		const auto i_p = si_tr + sr_ti;
+		const float r_n_f = static_cast<int32_t>(r_n >> 15);
+		const float r_p_f = static_cast<int32_t>(r_p >> 15);
+		const float i_n_f = static_cast<int32_t>(i_n >> 15);
+		const float i_p_f = static_cast<int32_t>(i_p >> 15);
 
-		const auto mag_n = std::sqrt(r_n * r_n + i_n * i_n);
-		const auto mag_p = std::sqrt(r_p * r_p + i_p * i_p);
-		const auto diff = mag_p - mag_n;
-		output = diff;
+		const auto mag_sq_n = r_n_f * r_n_f + i_n_f * i_n_f;
+		const auto mag_sq_p = r_p_f * r_p_f + i_p_f * i_p_f;
+		output = (mag_sq_p - mag_sq_n) * output_scale_;
 
-		shift_by_decimation_factor();
 		return true;
 	} else {
 		return false;
 	}
 }
 
-void MatchedFilter::shift_by_decimation_factor() {
-	const sample_t* s = &samples_[decimation_factor_];
-	sample_t* t = &samples_[0];
-	
-	const size_t unroll_factor = 4;
-	size_t shift_count = (taps_count_ - decimation_factor_) / unroll_factor;	
-	while(shift_count > 0) {
-		*t++ = *s++;
-		*t++ = *s++;
-		*t++ = *s++;
-		*t++ = *s++;
-		shift_count--;
-	}
-
-	shift_count = (taps_count_ - decimation_factor_) % unroll_factor;
-	while(shift_count > 0) {
-		*t++ = *s++;
-		shift_count--;
-	}
-}
-
 } /* namespace matched_filter */
 } /* namespace dsp */
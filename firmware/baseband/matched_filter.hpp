@@ -22,10 +22,13 @@
 #ifndef __MATCHED_FILTER_H__
 #define __MATCHED_FILTER_H__
 
+#include <cstdint>
 #include <cstddef>
 #include <complex>
 #include <memory>
 
+#include "complex.hpp"
+
 namespace dsp {
 namespace matched_filter {
 
@@ -33,10 +36,16 @@ namespace matched_filter {
 // combine a low-pass filter with a complex sinusoid that performs shifting of
 // the input signal to 0Hz/DC. This also means that the taps length must be
 // a multiple of the complex sinusoid period.
+//
+// Taps are scaled to Q15 at configure time. History is a mirrored circular
+// buffer (each sample is written twice, taps_count apart) so the newest
+// taps_count samples are always contiguous and nothing is shifted.
+// The output is |P|^2 - |N|^2 rather than |P| - |N|: the same sign, with no
+// square roots.
 
 class MatchedFilter {
 public:
-	using sample_t = std::complex<float>;
+	using sample_t = complex16_t;
 	using tap_t = std::complex<float>;
 
 	using taps_t = tap_t[];
@@ -64,17 +73,18 @@ public:
 	}
 
 private:
-	using samples_t = sample_t[];
+	/* complex16_t packed in 32-bit words, for SMLALD and friends. */
+	using words_t = uint32_t[];
 
-	std::unique_ptr<samples_t> samples_ { };
-	std::unique_ptr<taps_t> taps_reversed_ { };
+	std::unique_ptr<words_t> history_ { };
+	std::unique_ptr<words_t> taps_reversed_ { };
 	size_t taps_count_ { 0 };
+	size_t write_index_ { 0 };
 	size_t decimation_factor_ { 1 };
 	size_t decimation_phase { 0 };
+	float output_scale_ { 0 };
 	float output { 0 };
 
-	void shift_by_decimation_factor();
-
 	void advance_decimation_phase() {
 		decimation_phase = (decimation_phase + 1) % decimation_factor_;
 	}
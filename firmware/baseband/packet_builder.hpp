@@ -26,6 +26,7 @@
 #include <cstddef>
 #include <bitset>
 #include <functional>
+#include <type_traits>
 
 #include "bit_pattern.hpp"
 #include "baseband_packet.hpp"
@@ -97,6 +98,15 @@ public:
 					payload_handler(packet);
 				}
 				reset_state();
+
+				/* With flag framing, the flag that ended a packet may also
+				 * start the next, e.g. when noise started a false packet
+				 * just before a real one. A fixed-length packet ends on its
+				 * payload, whose tail could pass for a preamble.
+				 */
+				if( end_is_flag && preamble(bit_history, packet.size()) ) {
+					state = State::Payload;
+				}
 			} else {
 				if( packet_truncated() ) {
 					reset_state();
@@ -116,6 +126,9 @@ private:
 		Payload,
 	};
 
+	/* Packets end on a bit pattern, not after a count of symbols. */
+	static constexpr bool end_is_flag = std::is_same<EndMatcher, BitPattern>::value;
+
 	bool packet_truncated() const {
 		return packet.size() >= packet.capacity();
 	}
@@ -47,13 +47,13 @@ public:
 	}
 
 	result_t operator()(const history_t symbol_history) const {
-		static_assert(sizeof(history_t) == sizeof(unsigned long), "popcountl size mismatch");
+		static_assert(sizeof(history_t) == sizeof(unsigned int), "popcount size mismatch");
 
 		// history = ...0111, early
 		// history = ...1110, late
 
-		const size_t late_side = __builtin_popcountl(symbol_history & late_mask);
-		const size_t early_side = __builtin_popcountl(symbol_history & early_mask);
+		const size_t late_side = __builtin_popcount(symbol_history & late_mask);
+		const size_t early_side = __builtin_popcount(symbol_history & early_mask);
 		const size_t total_count = late_side + early_side;
 		const auto lateness = static_cast<int>(late_side) - static_cast<int>(early_side);
 		const symbol_t symbol = (total_count >= sample_threshold);
@@ -32,18 +32,29 @@ void NarrowbandAMAudio::execute(const buffer_c8_t& buffer) {
 		return;
 	}
 
-	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-	const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
-	const auto decim_2_out = decim_2.execute(decim_1_out, dst_buffer);
-	const auto channel_out = channel_filter.execute(decim_2_out, dst_buffer);
+	stage_stats_start();
+
+	/* The last two decimator stages are both channel filtering. */
+	const auto channel_out = decimator.execute(buffer, [this](const size_t n) {
+		if( n < 2 ) {
+			stage_stats_lap(static_cast<Stage>(n));
+		}
+	});
+	stage_stats_lap(Stage::Channel);
 
 	// TODO: Feed channel_stats post-decimation data?
 	feed_channel_stats(channel_out);
 	channel_spectrum.feed(channel_out, channel_filter_pass_f, channel_filter_stop_f);
+	stage_stats_lap(Stage::Spectrum);
 
 	auto audio = demodulate(channel_out);
+	stage_stats_lap(Stage::Demod);
+
 	audio_compressor.execute_in_place(audio);
 	audio_output.write(audio);
+	stage_stats_lap(Stage::Audio);
+
+	feed_stage_stats(buffer);
 }
 
 buffer_f32_t NarrowbandAMAudio::demodulate(const buffer_c16_t& channel) {
@@ -75,22 +86,13 @@ void NarrowbandAMAudio::on_message(const Message* const message) {
 }
 
 void NarrowbandAMAudio::configure(const AMConfigureMessage& message) {
-	constexpr size_t decim_0_input_fs = baseband_fs;
-	constexpr size_t decim_0_output_fs = decim_0_input_fs / decim_0.decimation_factor;
-
-	constexpr size_t decim_1_input_fs = decim_0_output_fs;
-	constexpr size_t decim_1_output_fs = decim_1_input_fs / decim_1.decimation_factor;
-
-	constexpr size_t decim_2_input_fs = decim_1_output_fs;
-	constexpr size_t decim_2_output_fs = decim_2_input_fs / decim_2_decimation_factor;
-
-	constexpr size_t channel_filter_input_fs = decim_2_output_fs;
-	const size_t channel_filter_output_fs = channel_filter_input_fs / channel_filter_decimation_factor;
+	constexpr size_t channel_filter_input_fs = Decimator::sampling_rate(3);
+	constexpr size_t channel_filter_output_fs = Decimator::sampling_rate(4);
 
-	decim_0.configure(message.decim_0_filter.taps, 33554432);
-	decim_1.configure(message.decim_1_filter.taps, 131072);
-	decim_2.configure(message.decim_2_filter.taps, decim_2_decimation_factor);
-	channel_filter.configure(message.channel_filter.taps, channel_filter_decimation_factor);
+	decimator.stage<0>().configure(message.decim_0_filter.taps, 33554432);
+	decimator.stage<1>().configure(message.decim_1_filter.taps, 131072);
+	decimator.stage<2>().configure(message.decim_2_filter.taps);
+	decimator.stage<3>().configure(message.channel_filter.taps);
 	channel_filter_pass_f = message.channel_filter.pass_frequency_normalized * channel_filter_input_fs;
 	channel_filter_stop_f = message.channel_filter.stop_frequency_normalized * channel_filter_input_fs;
 	channel_spectrum.set_decimation_factor(std::floor(channel_filter_output_fs / (channel_filter_pass_f + channel_filter_stop_f)));
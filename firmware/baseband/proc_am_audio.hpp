@@ -24,10 +24,12 @@
 
 #include "baseband_processor.hpp"
 #include "baseband_thread.hpp"
+#include "baseband_dma.hpp"
 #include "rssi_thread.hpp"
 
 #include "dsp_decimate.hpp"
 #include "dsp_demodulate.hpp"
+#include "dsp_pipeline.hpp"
 #include "audio_compressor.hpp"
 
 #include "audio_output.hpp"
@@ -43,27 +45,25 @@ public:
 
 private:
 	static constexpr size_t baseband_fs = 3072000;
-	static constexpr size_t decim_2_decimation_factor = 4;
-	static constexpr size_t channel_filter_decimation_factor = 1;
 
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20 };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
 
-	std::array<complex16_t, 512> dst { };
-	const buffer_c16_t dst_buffer {
-		dst.data(),
-		dst.size()
-	};
 	std::array<float, 32> audio { };
 	const buffer_f32_t audio_buffer {
 		audio.data(),
 		audio.size()
 	};
 
-	dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0 { };
-	dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
-	dsp::decimate::FIRAndDecimateComplex decim_2 { };
-	dsp::decimate::FIRAndDecimateComplex channel_filter { };
+	/* decim_0, decim_1, decim_2, channel filter. */
+	using Decimator = dsp::pipeline::Chain<
+		complex8_t, complex16_t, baseband_fs, baseband::dma::transfer_samples,
+		dsp::decimate::FIRC8xR16x24FS4Decim8,
+		dsp::decimate::FIRC16xR16x32Decim8,
+		dsp::pipeline::FixedDecimation<dsp::decimate::FIRAndDecimateComplex, 4>,
+		dsp::pipeline::FixedDecimation<dsp::decimate::FIRAndDecimateComplex, 1>
+	>;
+	Decimator decimator { };
 	uint32_t channel_filter_pass_f = 0;
 	uint32_t channel_filter_stop_f = 0;
 
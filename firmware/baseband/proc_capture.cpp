@@ -29,15 +29,12 @@
 
 CaptureProcessor::CaptureProcessor() {
 	const auto& decim_0_filter = taps_200k_decim_0;
-	constexpr size_t decim_0_input_fs = baseband_fs;
-	constexpr size_t decim_0_output_fs = decim_0_input_fs / decim_0.decimation_factor;
-
 	const auto& decim_1_filter = taps_200k_decim_1;
-	constexpr size_t decim_1_input_fs = decim_0_output_fs;
-	constexpr size_t decim_1_output_fs = decim_1_input_fs / decim_1.decimation_factor;
+	constexpr size_t decim_1_input_fs = Decimator::sampling_rate(1);
+	constexpr size_t decim_1_output_fs = Decimator::sampling_rate(2);
 
-	decim_0.configure(decim_0_filter.taps, 33554432);
-	decim_1.configure(decim_1_filter.taps, 131072);
+	decimator.stage<0>().configure(decim_0_filter.taps, 33554432);
+	decimator.stage<1>().configure(decim_1_filter.taps, 131072);
 
 	channel_filter_pass_f = decim_1_filter.pass_frequency_normalized * decim_1_input_fs;
 	channel_filter_stop_f = decim_1_filter.stop_frequency_normalized * decim_1_input_fs;
@@ -49,15 +46,25 @@ CaptureProcessor::CaptureProcessor() {
 }
 
 void CaptureProcessor::execute(const buffer_c8_t& buffer) {
-	/* 2.4576MHz, 2048 samples */
-	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-	const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
-	const auto& decimator_out = decim_1_out;
+	if( stream && (stream_format == CaptureConfig::Format::C8) ) {
+		/* Nothing uses the channel, so it isn't decimated, and there are no
+		 * channel statistics until the capture stops.
+		 */
+		write_raw(buffer);
+		return;
+	}
+
+	/* 4MHz, 2048 samples */
+	const auto decimator_out = decimator.execute(buffer);
 	const auto& channel = decimator_out;
 
 	if( stream ) {
-		const size_t bytes_to_write = sizeof(*decimator_out.p) * decimator_out.count;
-		const auto result = stream->write(decimator_out.p, bytes_to_write);
+		if( stream_format == CaptureConfig::Format::C16Compressed ) {
+			write_compressed(decimator_out);
+		} else {
+			const size_t bytes_to_write = sizeof(*decimator_out.p) * decimator_out.count;
+			stream->write(decimator_out.p, bytes_to_write);
+		}
 	}
 
 	feed_channel_stats(channel);
@@ -87,9 +94,78 @@ void CaptureProcessor::on_message(const Message* const message) {
 
 void CaptureProcessor::capture_config(const CaptureConfigMessage& message) {
 	if( message.config ) {
+		stream_format = message.config->format;
+		stream_decimation = message.config->decimation;
+		raw_sampling_rate = message.config->sampling_rate;
+		raw_spectrum_interval_samples = raw_sampling_rate / spectrum_rate_hz;
+		switch(stream_decimation) {
+		case 2:	raw_decimator.set_decimation_factor(ChannelDecimator::DecimationFactor::By2);	break;
+		case 4:	raw_decimator.set_decimation_factor(ChannelDecimator::DecimationFactor::By4);	break;
+		case 8:	raw_decimator.set_decimation_factor(ChannelDecimator::DecimationFactor::By8);	break;
+		default:
+			stream_decimation = 1;
+			break;
+		}
+		encoder = { };
+		spectrum_samples = 0;
 		stream = std::make_unique<StreamInput>(message.config);
 	} else {
 		stream.reset();
+		spectrum_samples = 0;
+	}
+}
+
+/* Samples go straight from the DMA buffer, or the decimator's output, into
+ * the buffers the application writes to the card, converted on the way.
+ * The DMA ring is only a few milliseconds long, far shorter than an SD card
+ * write can stall, so it can't be handed over itself.
+ *
+ * The spectrum shows what is written, from a block of it at the spectrum
+ * rate.
+ */
+void CaptureProcessor::write_raw(const buffer_c8_t& buffer) {
+	if( stream_decimation == 1 ) {
+		stream->write(buffer.p, buffer.count * sizeof(*buffer.p));
+
+		spectrum_samples += buffer.count;
+		if( spectrum_samples >= raw_spectrum_interval_samples ) {
+			spectrum_samples -= raw_spectrum_interval_samples;
+			for(size_t i=0; i<raw_spectrum.size(); i++) {
+				raw_spectrum[i] = { static_cast<int16_t>(buffer.p[i].real() * 256), static_cast<int16_t>(buffer.p[i].imag() * 256) };
+			}
+			channel_spectrum.feed({ raw_spectrum.data(), raw_spectrum.size(), raw_sampling_rate }, 0, 0);
+		}
+	} else {
+		/* Keep the high byte of the decimator's full-scale int16 output. */
+		const auto decimated = raw_decimator.execute(buffer);
+		const auto src = decimated.p;
+		stream->write(decimated.count * sizeof(complex8_t), [src](uint8_t* const p, const size_t offset, const size_t n) {
+			auto d = reinterpret_cast<complex8_t*>(p);
+			const auto s = &src[offset / sizeof(*d)];
+			const size_t count = n / sizeof(*d);
+			for(size_t i=0; i<count; i++) {
+				d[i] = { static_cast<int8_t>(s[i].real() >> 8), static_cast<int8_t>(s[i].imag() >> 8) };
+			}
+		});
+
+		spectrum_samples += decimated.count;
+		if( spectrum_samples >= raw_spectrum_interval_samples ) {
+			spectrum_samples -= raw_spectrum_interval_samples;
+			const size_t count = std::min(decimated.count, raw_spectrum.size());
+			channel_spectrum.feed({ decimated.p, count, decimated.sampling_rate }, 0, 0);
+		}
+	}
+}
+
+/* The channel, 256 samples per DMA transfer, is one block each. Blocks are
+ * written whole or dropped whole, and the decoder fills the gaps from the
+ * block sequence numbers.
+ */
+void CaptureProcessor::write_compressed(const buffer_c16_t& buffer) {
+	for(size_t n=0; n<buffer.count; n+=iq_compress::block_samples) {
+		const auto count = std::min(buffer.count - n, iq_compress::block_samples);
+		const auto size = encoder.encode(&buffer.p[n], count, compressed_block.data());
+		stream->write_whole(compressed_block.data(), size);
 	}
 }
 
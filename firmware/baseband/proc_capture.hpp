@@ -24,13 +24,17 @@
 
 #include "baseband_processor.hpp"
 #include "baseband_thread.hpp"
+#include "baseband_dma.hpp"
 #include "rssi_thread.hpp"
 
+#include "channel_decimator.hpp"
 #include "dsp_decimate.hpp"
+#include "dsp_pipeline.hpp"
 
 #include "spectrum_collector.hpp"
 
 #include "stream_input.hpp"
+#include "iq_compress.hpp"
 
 #include <array>
 #include <memory>
@@ -51,24 +55,41 @@ private:
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20 };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
 
-	std::array<complex16_t, 512> dst { };
-	const buffer_c16_t dst_buffer {
-		dst.data(),
-		dst.size()
-	};
-
-	dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0 { };
-	dsp::decimate::FIRC16xR16x16Decim2 decim_1 { };
+	/* decim_0, decim_1. */
+	using Decimator = dsp::pipeline::Chain<
+		complex8_t, complex16_t, baseband_fs, baseband::dma::transfer_samples,
+		dsp::decimate::FIRC8xR16x24FS4Decim4,
+		dsp::decimate::FIRC16xR16x16Decim2
+	>;
+	Decimator decimator { };
 	uint32_t channel_filter_pass_f = 0;
 	uint32_t channel_filter_stop_f = 0;
 
 	std::unique_ptr<StreamInput> stream { };
+	CaptureConfig::Format stream_format { CaptureConfig::Format::C16 };
+	size_t stream_decimation { 1 };
+
+	/* Raw capture, decimated by more than 1. */
+	ChannelDecimator raw_decimator { ChannelDecimator::DecimationFactor::By2 };
+	/* Raw capture spectrum, in place of the channel's. The radio may not
+	 * be at baseband_fs, so the rate comes from the application.
+	 */
+	std::array<complex16_t, SpectrumCollector::channel_spectrum_size> raw_spectrum { };
+	uint32_t raw_sampling_rate = 0;
+	size_t raw_spectrum_interval_samples = 0;
+
+	/* Compressed capture. */
+	iq_compress::BlockEncoder encoder { };
+	std::array<uint8_t, iq_compress::block_size_max> compressed_block { };
 
 	SpectrumCollector channel_spectrum { };
 	size_t spectrum_interval_samples = 0;
 	size_t spectrum_samples = 0;
 
 	void capture_config(const CaptureConfigMessage& message);
+
+	void write_raw(const buffer_c8_t& buffer);
+	void write_compressed(const buffer_c16_t& buffer);
 };
 
 #endif/*__PROC_CAPTURE_HPP__*/
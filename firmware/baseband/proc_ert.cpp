@@ -25,20 +25,7 @@
 
 #include "event_m4.hpp"
 
-float ERTProcessor::abs(const complex8_t& v) {
-	// const int16_t r = v.real() - offset_i;
-	// const int16_t i = v.imag() - offset_q;
-	// const uint32_t r2 = r * r;
-	// const uint32_t i2 = i * i;
-	// const uint32_t r2_i2 = r2 + i2;
-	// return std::sqrt(static_cast<float>(r2_i2));
-	const float r = static_cast<float>(v.real()) - offset_i;
-	const float i = static_cast<float>(v.imag()) - offset_q;
-	const float r2 = r * r;
-	const float i2 = i * i;
-	const float r2_i2 = r2 + i2;
-	return std::sqrt(r2_i2);
-}
+#include "dsp_magnitude.hpp"
 
 void ERTProcessor::execute(const buffer_c8_t& buffer) {
 	/* 4.194304MHz, 2048 samples */
@@ -50,8 +37,10 @@ void ERTProcessor::execute(const buffer_c8_t& buffer) {
 	average_q += src->imag();
 	average_count++;
 	if( average_count == average_window ) {
-		offset_i = static_cast<float>(average_i) / average_window;
-		offset_q = static_cast<float>(average_q) / average_window;
+		/* Integer offsets, so DC removal is one SIMD subtract per sample. */
+		const int16_t offset_i = average_i / static_cast<int32_t>(average_window);
+		const int16_t offset_q = average_q / static_cast<int32_t>(average_window);
+		offset_iq = __PKHBT(offset_i, offset_q, 16);
 		average_i = 0;
 		average_q = 0;
 		average_count = 0;
@@ -61,9 +50,12 @@ void ERTProcessor::execute(const buffer_c8_t& buffer) {
 	const float k = 1.0f / gain;
 
 	while(src < src_end) {
-		float sum = 0.0f;
-		for(size_t i=0; i<(samples_per_symbol / 2); i++) {
-			sum += abs(*(src++));
+		uint32_t sum = 0;
+		for(size_t i=0; i<(samples_per_symbol / 2); i+=2) {
+			uint32_t iq0, iq1;
+			dsp::magnitude::unpack_c8_pair(*__SIMD32(src)++, iq0, iq1);
+			sum += dsp::magnitude::alpha_max_beta_min(__SSUB16(iq0, offset_iq));
+			sum += dsp::magnitude::alpha_max_beta_min(__SSUB16(iq1, offset_iq));
 		}
 		sum_half_period[1] = sum_half_period[0];
 		sum_half_period[0] = sum;
@@ -101,10 +101,7 @@ private:
 	int32_t average_i { 0 };
 	int32_t average_q { 0 };
 	size_t average_count { 0 };
-	float offset_i { 0.0f };
-	float offset_q { 0.0f };
-
-	float abs(const complex8_t& v);
+	uint32_t offset_iq { 0 };
 };
 
 #endif/*__PROC_ERT_H__*/
@@ -33,15 +33,23 @@ void NarrowbandFMAudio::execute(const buffer_c8_t& buffer) {
 		return;
 	}
 
-	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-	const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
-	const auto channel_out = channel_filter.execute(decim_1_out, dst_buffer);
+	stage_stats_start();
+
+	const auto channel_out = decimator.execute(buffer, [this](const size_t n) {
+		stage_stats_lap(static_cast<Stage>(n));
+	});
 
 	feed_channel_stats(channel_out);
 	channel_spectrum.feed(channel_out, channel_filter_pass_f, channel_filter_stop_f);
+	stage_stats_lap(Stage::Spectrum);
 
 	auto audio = demod.execute(channel_out, audio_buffer);
+	stage_stats_lap(Stage::Demod);
+
 	audio_output.write(audio);
+	stage_stats_lap(Stage::Audio);
+
+	feed_stage_stats(buffer);
 }
 
 void NarrowbandFMAudio::on_message(const Message* const message) {
@@ -65,20 +73,18 @@ void NarrowbandFMAudio::on_message(const Message* const message) {
 }
 
 void NarrowbandFMAudio::configure(const NBFMConfigureMessage& message) {
-	constexpr size_t decim_0_input_fs = baseband_fs;
-	constexpr size_t decim_0_output_fs = decim_0_input_fs / decim_0.decimation_factor;
-
-	constexpr size_t decim_1_input_fs = decim_0_output_fs;
-	constexpr size_t decim_1_output_fs = decim_1_input_fs / decim_1.decimation_factor;
-
-	constexpr size_t channel_filter_input_fs = decim_1_output_fs;
+	constexpr size_t channel_filter_input_fs = Decimator::sampling_rate(2);
 	const size_t channel_filter_output_fs = channel_filter_input_fs / message.channel_decimation;
 
 	const size_t demod_input_fs = channel_filter_output_fs;
 
-	decim_0.configure(message.decim_0_filter.taps, 33554432);
-	decim_1.configure(message.decim_1_filter.taps, 131072);
-	channel_filter.configure(message.channel_filter.taps, message.channel_decimation);
+	decimator.stage<0>().configure(message.decim_0_filter.taps, 33554432);
+	decimator.stage<1>().configure(message.decim_1_filter.taps, 131072);
+	decimator.stage<2>().configure(message.channel_filter.taps, message.channel_decimation);
+	/* Deviations of 2.5kHz and 5kHz at 24kHz are 0.65 and 1.31 radians per
+	 * sample, past FM::quadricorrelator_dtheta_max, so Quadricorrelator
+	 * would fall back to Polynomial. Precise is kept.
+	 */
 	demod.configure(demod_input_fs, message.deviation);
 	channel_filter_pass_f = message.channel_filter.pass_frequency_normalized * channel_filter_input_fs;
 	channel_filter_stop_f = message.channel_filter.stop_frequency_normalized * channel_filter_input_fs;
@@ -32,17 +32,24 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 		return;
 	}
 
-	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-	const auto channel = decim_1.execute(decim_0_out, dst_buffer);
+	stage_stats_start();
+
+	const auto channel = decimator.execute(buffer, [this](const size_t n) {
+		stage_stats_lap(static_cast<Stage>(n));
+	});
 
 	// TODO: Feed channel_stats post-decimation data?
 	feed_channel_stats(channel);
 
 	spectrum_samples += channel.count;
-	if( spectrum_samples >= spectrum_interval_samples ) {
+	const bool spectrum_due = (spectrum_samples >= spectrum_interval_samples);
+	if( spectrum_due ) {
 		spectrum_samples -= spectrum_interval_samples;
-		channel_spectrum.feed(channel, channel_filter_pass_f, channel_filter_stop_f);
+		if( spectrum == WFMConfigureMessage::Spectrum::Channel ) {
+			channel_spectrum.feed(channel, channel_filter_pass_f, channel_filter_stop_f);
+		}
 	}
+	stage_stats_lap(Stage::Spectrum);
 
 	/* 384kHz complex<int16_t>[256]
 	 * -> FM demodulation
@@ -51,25 +58,31 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 	 *		pass < +/- 100kHz, stop > +/- 200kHz
 	 */
 
-	auto audio_oversampled = demod.execute(channel, work_audio_buffer);
+	/* Channel is consumed two samples ahead of the audio written over it. */
+	auto audio_oversampled = demod.execute(channel, decimator.work_buffer<int16_t>());
+
+	/* MPX (mono audio, 19kHz pilot, stereo subcarrier, RDS) is real, and
+	 * only exists once demodulated. Copying it out is counted as Demod.
+	 */
+	if( spectrum_due && (spectrum == WFMConfigureMessage::Spectrum::MPX) ) {
+		channel_spectrum.feed(audio_oversampled);
+	}
+	stage_stats_lap(Stage::Demod);
 
 	/* 384kHz int16_t[256]
 	 * -> 4th order CIC decimation by 2, gain of 1
-	 * -> 192kHz int16_t[128] */
-	auto audio_4fs = audio_dec_1.execute(audio_oversampled, work_audio_buffer);
-
-	/* 192kHz int16_t[128]
+	 * -> 192kHz int16_t[128]
 	 * -> 4th order CIC decimation by 2, gain of 1
-	 * -> 96kHz int16_t[64] */
-	auto audio_2fs = audio_dec_2.execute(audio_4fs, work_audio_buffer);
-
-	/* 96kHz int16_t[64]
+	 * -> 96kHz int16_t[64]
 	 * -> FIR filter, <15kHz (0.156fs) pass, >19kHz (0.198fs) stop, gain of 1
 	 * -> 48kHz int16_t[32] */
-	auto audio = audio_filter.execute(audio_2fs, work_audio_buffer);
+	auto audio = audio_decimator.execute(audio_oversampled);
 
 	/* -> 48kHz int16_t[32] */
 	audio_output.write(audio);
+	stage_stats_lap(Stage::Audio);
+
+	feed_stage_stats(buffer);
 }
 
 void WidebandFMAudio::on_message(const Message* const message) {
@@ -93,23 +106,26 @@ void WidebandFMAudio::on_message(const Message* const message) {
 }
 
 void WidebandFMAudio::configure(const WFMConfigureMessage& message) {
-	constexpr size_t decim_0_input_fs = baseband_fs;
-	constexpr size_t decim_0_output_fs = decim_0_input_fs / decim_0.decimation_factor;
-
-	constexpr size_t decim_1_input_fs = decim_0_output_fs;
-	constexpr size_t decim_1_output_fs = decim_1_input_fs / decim_1.decimation_factor;
+	constexpr size_t decim_1_input_fs = Decimator::sampling_rate(1);
+	constexpr size_t decim_1_output_fs = Decimator::sampling_rate(2);
 
 	constexpr size_t demod_input_fs = decim_1_output_fs;
 
 	spectrum_interval_samples = decim_1_output_fs / spectrum_rate_hz;
 	spectrum_samples = 0;
+	spectrum = message.spectrum;
 
-	decim_0.configure(message.decim_0_filter.taps, 33554432);
-	decim_1.configure(message.decim_1_filter.taps, 131072);
+	decimator.stage<0>().configure(message.decim_0_filter.taps, 33554432);
+	decimator.stage<1>().configure(message.decim_1_filter.taps, 131072);
 	channel_filter_pass_f = message.decim_1_filter.pass_frequency_normalized * decim_1_input_fs;
 	channel_filter_stop_f = message.decim_1_filter.stop_frequency_normalized * decim_1_input_fs;
+	/* 75kHz deviation at 384kHz is 1.23 radians per sample, far past
+	 * FM::quadricorrelator_dtheta_max, so Quadricorrelator would only fall
+	 * back to Polynomial.
+	 */
 	demod.configure(demod_input_fs, message.deviation);
-	audio_filter.configure(message.audio_filter.taps);
+	demod.set_discriminator(dsp::demodulate::FM::Discriminator::Polynomial);
+	audio_decimator.stage<2>().configure(message.audio_filter.taps);
 	audio_output.configure(message.audio_hpf_config, message.audio_deemph_config);
 
 	channel_spectrum.set_decimation_factor(1);
@@ -24,10 +24,12 @@
 
 #include "baseband_processor.hpp"
 #include "baseband_thread.hpp"
+#include "baseband_dma.hpp"
 #include "rssi_thread.hpp"
 
 #include "dsp_decimate.hpp"
 #include "dsp_demodulate.hpp"
+#include "dsp_pipeline.hpp"
 
 #include "audio_output.hpp"
 #include "spectrum_collector.hpp"
@@ -45,31 +47,34 @@ private:
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20 };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
 
-	std::array<complex16_t, 512> dst { };
-	const buffer_c16_t dst_buffer {
-		dst.data(),
-		dst.size()
-	};
-	const buffer_s16_t work_audio_buffer {
-		(int16_t*)dst.data(),
-		sizeof(dst) / sizeof(int16_t)
-	};
-
-	dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0 { };
-	dsp::decimate::FIRC16xR16x16Decim2 decim_1 { };
+	/* decim_0, decim_1. */
+	using Decimator = dsp::pipeline::Chain<
+		complex8_t, complex16_t, baseband_fs, baseband::dma::transfer_samples,
+		dsp::decimate::FIRC8xR16x24FS4Decim4,
+		dsp::decimate::FIRC16xR16x16Decim2
+	>;
+	Decimator decimator { };
 	uint32_t channel_filter_pass_f = 0;
 	uint32_t channel_filter_stop_f = 0;
 
 	dsp::demodulate::FM demod { };
-	dsp::decimate::DecimateBy2CIC4Real audio_dec_1 { };
-	dsp::decimate::DecimateBy2CIC4Real audio_dec_2 { };
-	dsp::decimate::FIR64AndDecimateBy2Real audio_filter { };
+
+	/* audio_dec_1, audio_dec_2, audio_filter. */
+	using AudioDecimator = dsp::pipeline::Chain<
+		int16_t, int16_t, Decimator::sampling_rate(2), Decimator::count(2),
+		dsp::decimate::DecimateBy2CIC4Real,
+		dsp::decimate::DecimateBy2CIC4Real,
+		dsp::decimate::FIR64AndDecimateBy2Real
+	>;
+	static_assert(AudioDecimator::sampling_rate(3) == 48000, "AudioOutput expects 48kHz");
+	AudioDecimator audio_decimator { };
 
 	AudioOutput audio_output { };
 
 	SpectrumCollector channel_spectrum { };
 	size_t spectrum_interval_samples = 0;
 	size_t spectrum_samples = 0;
+	WFMConfigureMessage::Spectrum spectrum { WFMConfigureMessage::Spectrum::Channel };
 
 	bool configured { false };
 	void configure(const WFMConfigureMessage& message);
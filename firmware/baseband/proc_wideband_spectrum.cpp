@@ -25,40 +25,100 @@
 
 #include "dsp_fft.hpp"
 
+#include "hal.h"
+
 #include <cstdint>
 #include <cstddef>
 
+#include <algorithm>
 #include <array>
 
 void WidebandSpectrum::execute(const buffer_c8_t& buffer) {
 	// 2048 complex8_t samples per buffer.
 	// 102.4us per buffer. 20480 instruction cycles per buffer.
 
-	if( phase == 0 ) {
-		std::fill(spectrum.begin(), spectrum.end(), 0);
-	}
+	const size_t frames_per_buffer = (buffer.count - dsp::spectrum::window_length) / frame_hop + 1;
+	const size_t frame_count = std::min(frames_per_execute, frames_per_buffer);
 
-	for(size_t i=0; i<spectrum.size(); i++) {
-		// TODO: Removed window-presum windowing, due to lack of available code RAM.
-		// TODO: Apply window to improve spectrum bin sidelobes.
-		spectrum[i] += buffer.p[i +    0];
-		spectrum[i] += buffer.p[i + 1024];
+	/* Each frame is charged to the spectrum stage, so Debug > Stage Cycles
+	 * shows cycles per frame against frame_cycle_budget; its count is
+	 * frames, not buffers.
+	 */
+	stage_stats_start();
+	const auto frames_start = halGetCounterValue();
+	for(size_t n=0; n<frame_count; n++) {
+		if( frame_index >= frames_per_buffer ) {
+			frame_index = 0;
+		}
+		process_frame(&buffer.p[frame_index * frame_hop]);
+		frame_index++;
+		stage_stats_lap(Stage::Spectrum);
 	}
+	const uint32_t frame_cycles = (halGetCounterValue() - frames_start) / frame_count;
+	frame_cycles_max = std::max(frame_cycles_max, frame_cycles);
 
-	if( phase == 127 ) {
-		const buffer_c16_t buffer_c16 {
-			spectrum.data(),
-			spectrum.size(),
-			buffer.sampling_rate
-		};
-		channel_spectrum.feed(
-			buffer_c16,
-			0, 0
-		);
+	if( phase == (buffers_per_report - 1) ) {
+		report(buffer.sampling_rate, frames_per_buffer);
 		phase = 0;
 	} else {
 		phase++;
 	}
+
+	feed_stage_stats(buffer);
+}
+
+void WidebandSpectrum::process_frame(const complex8_t* const src) {
+	dsp::spectrum::wola_presum(src, frame);
+	fft_c_q15_preswapped(frame);
+
+	switch(averaging) {
+	default:
+	case WidebandSpectrumConfigMessage::Averaging::Linear:
+		dsp::spectrum::power_accumulate(frame, power);
+		break;
+
+	case WidebandSpectrumConfigMessage::Averaging::PeakHold:
+		dsp::spectrum::power_peak(frame, power);
+		break;
+
+	case WidebandSpectrumConfigMessage::Averaging::Exponential:
+		dsp::spectrum::power_exponential(frame, power, exponential_alpha);
+		break;
+	}
+	frames_in_average++;
+}
+
+void WidebandSpectrum::report(const uint32_t sampling_rate, const size_t frames_per_buffer) {
+	if( frames_in_average > 0 ) {
+		constexpr float full_scale_power = 32768.0f * 32768.0f;
+		const float count = (averaging == WidebandSpectrumConfigMessage::Averaging::Linear) ? frames_in_average : 1;
+		channel_spectrum.feed(power, 1.0f / (full_scale_power * count), sampling_rate);
+	}
+
+	if( averaging != WidebandSpectrumConfigMessage::Averaging::Exponential ) {
+		power.fill(0.0f);
+		frames_in_average = 0;
+	}
+
+	/* Take as many frames per buffer as the measured worst case allows. */
+	if( frame_cycles_max > 0 ) {
+		frames_per_execute = std::max(size_t(1), std::min(frames_per_buffer, size_t(frame_cycle_budget / frame_cycles_max)));
+	}
+	frame_cycles_max = 0;
+}
+
+void WidebandSpectrum::configure(const WidebandSpectrumConfigMessage& message) {
+	switch(message.overlap) {
+	default:
+	case WidebandSpectrumConfigMessage::Overlap::None:			frame_hop = dsp::spectrum::window_length;		break;
+	case WidebandSpectrumConfigMessage::Overlap::Half:			frame_hop = dsp::spectrum::window_length / 2;	break;
+	case WidebandSpectrumConfigMessage::Overlap::ThreeQuarters:	frame_hop = dsp::spectrum::window_length / 4;	break;
+	}
+
+	averaging = message.averaging;
+	power.fill(0.0f);
+	frame_index = 0;
+	frames_in_average = 0;
 }
 
 void WidebandSpectrum::on_message(const Message* const message) {
@@ -68,6 +128,10 @@ void WidebandSpectrum::on_message(const Message* const message) {
 		channel_spectrum.on_message(message);
 		break;
 
+	case Message::ID::WidebandSpectrumConfig:
+		configure(*reinterpret_cast<const WidebandSpectrumConfigMessage*>(message));
+		break;
+
 	default:
 		break;
 	}
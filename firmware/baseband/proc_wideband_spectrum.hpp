@@ -27,9 +27,11 @@
 #include "rssi_thread.hpp"
 
 #include "spectrum_collector.hpp"
+#include "dsp_spectrum.hpp"
 
 #include "message.hpp"
 
+#include <cstdint>
 #include <cstddef>
 #include <array>
 #include <complex>
@@ -43,14 +45,37 @@ public:
 private:
 	static constexpr size_t baseband_fs = 20000000;
 
+	/* 2048 samples per buffer at 20MHz, 102.4us, 20480 cycles at 200MHz.
+	 * Leave a quarter for DMA and RSSI interrupts and the other threads.
+	 */
+	static constexpr uint32_t frame_cycle_budget = 20480 * 3 / 4;
+	static constexpr size_t buffers_per_report = 128;
+	static constexpr float exponential_alpha = 1.0f / 16.0f;
+
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20 };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
 
 	SpectrumCollector channel_spectrum { };
 
-	std::array<complex16_t, 256> spectrum { };
+	dsp::spectrum::frame_t frame { };
+	dsp::spectrum::power_t power { };
+
+	WidebandSpectrumConfigMessage::Averaging averaging { WidebandSpectrumConfigMessage::Averaging::Linear };
+	size_t frame_hop { dsp::spectrum::window_length / 2 };
+
+	/* Frames start every frame_hop samples within a buffer. When they do
+	 * not all fit the cycle budget, successive buffers take turns.
+	 */
+	size_t frame_index { 0 };
+	size_t frames_per_execute { 1 };
+	size_t frames_in_average { 0 };
+	uint32_t frame_cycles_max { 0 };
+
+	size_t phase { 0 };
 
-	size_t phase = 0;
+	void configure(const WidebandSpectrumConfigMessage& message);
+	void process_frame(const complex8_t* const src);
+	void report(const uint32_t sampling_rate, const size_t frames_per_buffer);
 };
 
 #endif/*__PROC_WIDEBAND_SPECTRUM_H__*/
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "replay_source.hpp"
+
+#include "event_m4.hpp"
+
+#include <algorithm>
+
+ReplaySource::ReplaySource(
+	ReplayConfig* const config
+) : config { config },
+	stream { config }
+{
+}
+
+buffer_c8_t ReplaySource::read(const uint32_t sampling_rate) {
+	if( config->format == ReplayConfig::Format::C16 ) {
+		while( block_samples < block.size() ) {
+			std::array<complex16_t, 64> c16;
+			const size_t count = std::min(c16.size(), block.size() - block_samples);
+			const size_t bytes = stream.read(c16.data(), count * sizeof(complex16_t));
+			const size_t samples = bytes / sizeof(complex16_t);
+			for(size_t i=0; i<samples; i++) {
+				block[block_samples + i] = {
+					static_cast<int8_t>(c16[i].real() >> 8),
+					static_cast<int8_t>(c16[i].imag() >> 8)
+				};
+			}
+			block_samples += samples;
+			if( samples < count ) {
+				break;
+			}
+		}
+	} else {
+		const size_t bytes_needed = (block.size() - block_samples) * sizeof(complex8_t);
+		block_samples += stream.read(&block[block_samples], bytes_needed) / sizeof(complex8_t);
+	}
+
+	if( block_samples < block.size() ) {
+		return { };
+	}
+
+	block_samples = 0;
+	return { block.data(), block.size(), sampling_rate };
+}
+
+systime_t ReplaySource::pace(const bool block_read, const uint32_t sampling_rate) {
+	systime_t ticks = 0;
+
+	if( config->real_time ) {
+		if( block_read ) {
+			if( !started ) {
+				pace_start = chTimeNow();
+				started = true;
+			}
+			samples_paced += block.size();
+			late = false;
+		}
+
+		const systime_t due = pace_start + samples_paced * CH_FREQUENCY / sampling_rate;
+		const int32_t ticks_ahead = due - chTimeNow();
+		if( ticks_ahead > 0 ) {
+			ticks = ticks_ahead;
+		} else if( !block_read ) {
+			/* Behind and still waiting for samples. Count it once, and start the
+			 * schedule over when they arrive rather than rush to catch up.
+			 */
+			if( started && !late ) {
+				config->baseband_underruns++;
+				late = true;
+			}
+			started = false;
+			samples_paced = 0;
+			ticks = 1;
+		}
+	} else {
+		if( !block_read ) {
+			ticks = 1;
+		}
+	}
+
+	if( (ticks == 0) && EventDispatcher::events_pending() ) {
+		ticks = 1;
+	}
+
+	return ticks;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __REPLAY_SOURCE_H__
+#define __REPLAY_SOURCE_H__
+
+#include "stream_output.hpp"
+
+#include "message.hpp"
+#include "dsp_types.hpp"
+#include "baseband_dma.hpp"
+
+#include "ch.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+/* Blocks of samples the application reads from a file, which BasebandThread
+ * runs the processor on in place of the radio's, and the pacing between
+ * them.
+ */
+class ReplaySource {
+public:
+	explicit ReplaySource(ReplayConfig* const config);
+
+	ReplaySource(const ReplaySource&) = delete;
+	ReplaySource(ReplaySource&&) = delete;
+	ReplaySource& operator=(const ReplaySource&) = delete;
+	ReplaySource& operator=(ReplaySource&&) = delete;
+
+	/* The next block, or an empty buffer until the application has sent all
+	 * of it.
+	 */
+	buffer_c8_t read(const uint32_t sampling_rate);
+
+	/* Ticks to sleep after each read(), as pacing requires. At least one if
+	 * the event loop, which runs at lower priority, has anything pending.
+	 */
+	systime_t pace(const bool block_read, const uint32_t sampling_rate);
+
+private:
+	ReplayConfig* const config;
+	StreamOutput stream;
+
+	std::array<complex8_t, baseband::dma::transfer_samples> block { };
+	size_t block_samples { 0 };
+
+	bool started { false };
+	bool late { false };
+	systime_t pace_start { 0 };
+	uint64_t samples_paced { 0 };
+};
+
+#endif/*__REPLAY_SOURCE_H__*/
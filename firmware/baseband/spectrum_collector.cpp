@@ -30,6 +30,7 @@
 #include "event_m4.hpp"
 
 #include <algorithm>
+#include <array>
 
 void SpectrumCollector::on_message(const Message* const message) {
 	switch(message->id) {
@@ -69,6 +70,7 @@ void SpectrumCollector::set_decimation_factor(
 	const size_t decimation_factor
 ) {
 	channel_spectrum_decimator.set_factor(decimation_factor);
+	audio_spectrum_decimator.set_factor(decimation_factor);
 }
 
 /* TODO: Refactor to register task with idle thread?
@@ -93,54 +95,144 @@ void SpectrumCollector::feed(
 	);
 }
 
+void SpectrumCollector::feed(
+	const buffer_s16_t& audio
+) {
+	// Called from baseband processing thread.
+	channel_filter_pass_frequency = 0;
+	channel_filter_stop_frequency = 0;
+
+	audio_spectrum_decimator.feed(
+		audio,
+		[this](const buffer_s16_t& data) {
+			this->post_message(data);
+		}
+	);
+}
+
+void SpectrumCollector::feed(
+	const std::array<float, channel_spectrum_size>& power,
+	const float scale,
+	const uint32_t sampling_rate
+) {
+	// Called from baseband processing thread.
+	if( streaming && !channel_spectrum_request_update ) {
+		auto& dst = power_spectrum();
+		for(size_t i=0; i<power.size(); i++) {
+			dst[i] = power[i] * scale;
+		}
+		channel_filter_pass_frequency = 0;
+		channel_filter_stop_frequency = 0;
+		channel_spectrum_input = Input::Power;
+		channel_spectrum_sampling_rate = sampling_rate;
+		channel_spectrum_request_update = true;
+		EventDispatcher::events_flag(EVT_MASK_SPECTRUM);
+	}
+}
+
 void SpectrumCollector::post_message(const buffer_c16_t& data) {
 	// Called from baseband processing thread.
 	if( streaming && !channel_spectrum_request_update ) {
 		fft_swap(data, channel_spectrum);
+		channel_spectrum_input = Input::Complex;
+		channel_spectrum_sampling_rate = data.sampling_rate;
+		channel_spectrum_request_update = true;
+		EventDispatcher::events_flag(EVT_MASK_SPECTRUM);
+	}
+}
+
+void SpectrumCollector::post_message(const buffer_s16_t& data) {
+	// Called from baseband processing thread.
+	if( streaming && !channel_spectrum_request_update ) {
+		fft_swap_real(data, real_spectrum());
+		channel_spectrum_input = Input::Real;
 		channel_spectrum_sampling_rate = data.sampling_rate;
 		channel_spectrum_request_update = true;
 		EventDispatcher::events_flag(EVT_MASK_SPECTRUM);
 	}
 }
 
+/* Expand packed real FFT output (first half of channel_spectrum) into the
+ * full conjugate-symmetric spectrum, in place.
+ */
+void SpectrumCollector::unpack_real_spectrum() {
+	constexpr size_t n = channel_spectrum_size;
+	const auto bin_0_n_2 = channel_spectrum[0];
+
+	for(size_t k=n/2-1; k>0; k--) {
+		const auto v = channel_spectrum[k];
+		channel_spectrum[n - k] = { v.real(), static_cast<int16_t>(-v.imag()) };
+	}
+	channel_spectrum[0] = { bin_0_n_2.real(), 0 };
+	channel_spectrum[n / 2] = { bin_0_n_2.imag(), 0 };
+}
+
 template<typename T>
-static typename T::value_type spectrum_window_none(const T& s, const size_t i) {
-	static_assert(power_of_two(s.size()), "Array size must be power of 2");
+static std::complex<float> spectrum_window_none(const T& s, const size_t i) {
+	static_assert(power_of_two(std::tuple_size<T>::value), "Array size must be power of 2");
 	return s[i];
 };
 
 template<typename T>
-static typename T::value_type spectrum_window_hamming_3(const T& s, const size_t i) {
-	static_assert(power_of_two(s.size()), "Array size must be power of 2");
-	constexpr size_t mask = s.size() - 1;
+static std::complex<float> spectrum_window_hamming_3(const T& s, const size_t i) {
+	static_assert(power_of_two(std::tuple_size<T>::value), "Array size must be power of 2");
+	constexpr size_t mask = std::tuple_size<T>::value - 1;
 	// Three point Hamming window.
-	return s[i] * 0.54f + (s[(i-1) & mask] + s[(i+1) & mask]) * -0.23f;
+	const std::complex<float> s0 = s[i];
+	const std::complex<float> s_m1 = s[(i-1) & mask];
+	const std::complex<float> s_p1 = s[(i+1) & mask];
+	return s0 * 0.54f + (s_m1 + s_p1) * -0.23f;
 };
 
 template<typename T>
-static typename T::value_type spectrum_window_blackman_3(const T& s, const size_t i) {
-	static_assert(power_of_two(s.size()), "Array size must be power of 2");
-	constexpr size_t mask = s.size() - 1;
+static std::complex<float> spectrum_window_blackman_3(const T& s, const size_t i) {
+	static_assert(power_of_two(std::tuple_size<T>::value), "Array size must be power of 2");
+	constexpr size_t mask = std::tuple_size<T>::value - 1;
 	// Three term Blackman window.
 	constexpr float alpha = 0.42f;
 	constexpr float beta = 0.5f * 0.5f;
 	constexpr float gamma = 0.08f * 0.05f;
-	return s[i] * alpha - (s[(i-1) & mask] + s[(i+1) & mask]) * beta + (s[(i-2) & mask] + s[(i+2) & mask]) * gamma;
+	const std::complex<float> s0 = s[i];
+	const std::complex<float> s_m1 = s[(i-1) & mask];
+	const std::complex<float> s_p1 = s[(i+1) & mask];
+	const std::complex<float> s_m2 = s[(i-2) & mask];
+	const std::complex<float> s_p2 = s[(i+2) & mask];
+	return s0 * alpha - (s_m1 + s_p1) * beta + (s_m2 + s_p2) * gamma;
 };
 
 void SpectrumCollector::update() {
 	// Called from idle thread (after EVT_MASK_SPECTRUM is flagged)
 	if( streaming && channel_spectrum_request_update ) {
 		/* Decimated buffer is full. Compute spectrum. */
-		fft_c_preswapped(channel_spectrum);
+		switch(channel_spectrum_input) {
+		case Input::Complex:
+			fft_c_q15_preswapped(channel_spectrum);
+			break;
+
+		case Input::Real:
+			fft_r_q15_preswapped(real_spectrum());
+			unpack_real_spectrum();
+			break;
+
+		case Input::Power:
+			break;
+		}
 
 		ChannelSpectrum spectrum;
 		spectrum.sampling_rate = channel_spectrum_sampling_rate;
 		spectrum.channel_filter_pass_frequency = channel_filter_pass_frequency;
 		spectrum.channel_filter_stop_frequency = channel_filter_stop_frequency;
 		for(size_t i=0; i<spectrum.db.size(); i++) {
-			const auto corrected_sample = spectrum_window_hamming_3(channel_spectrum, i);
-			const auto mag2 = magnitude_squared(corrected_sample * (1.0f / 32768.0f));
+			float mag2 = 0.0f;
+			if( channel_spectrum_input == Input::Power ) {
+				// Windowed before the FFT, and already scaled.
+				mag2 = power_spectrum()[i];
+			} else {
+				const auto corrected_sample = spectrum_window_hamming_3(channel_spectrum, i);
+				// Q15 FFT output is scaled by 1/N, restore the float FFT's full-scale reference.
+				constexpr float bin_scale = static_cast<float>(channel_spectrum_size) / 32768.0f;
+				mag2 = magnitude_squared(corrected_sample * bin_scale);
+			}
 			const float db = mag2_to_dbv_norm(mag2);
 			constexpr float mag_scale = 5.0f;
 			const unsigned int v = (db * mag_scale) + 255.0f;
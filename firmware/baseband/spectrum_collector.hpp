@@ -34,6 +34,8 @@
 
 class SpectrumCollector {
 public:
+	static constexpr size_t channel_spectrum_size = 256;
+
 	void on_message(const Message* const message);
 
 	void set_decimation_factor(const size_t decimation_factor);
@@ -44,19 +46,55 @@ public:
 		const uint32_t filter_stop_frequency
 	);
 
+	/* Real (audio) input, used instead of the channel. Spectrum is computed
+	 * with a half-size complex FFT and displayed symmetric about DC, like
+	 * complex input with no imaginary part.
+	 */
+	void feed(const buffer_s16_t& audio);
+
+	/* Power spectrum computed by the caller, in natural FFT bin order.
+	 * power * scale == 1.0 is full scale (0 dB).
+	 */
+	void feed(
+		const std::array<float, channel_spectrum_size>& power,
+		const float scale,
+		const uint32_t sampling_rate
+	);
+
 private:
-	BlockDecimator<complex16_t, 256> channel_spectrum_decimator { 1 };
+	BlockDecimator<complex16_t, channel_spectrum_size> channel_spectrum_decimator { 1 };
+	BlockDecimator<int16_t, channel_spectrum_size> audio_spectrum_decimator { 1 };
 	ChannelSpectrum fifo_data[1 << ChannelSpectrumConfigMessage::fifo_k] { };
 	ChannelSpectrumFIFO fifo { fifo_data, ChannelSpectrumConfigMessage::fifo_k };
 
+	enum class Input {
+		Complex,
+		Real,
+		Power,
+	};
+
 	volatile bool channel_spectrum_request_update { false };
+	Input channel_spectrum_input { Input::Complex };
 	bool streaming { false };
-	std::array<std::complex<float>, 256> channel_spectrum { };
+	std::array<complex16_t, channel_spectrum_size> channel_spectrum { };
 	uint32_t channel_spectrum_sampling_rate { 0 };
 	uint32_t channel_filter_pass_frequency { 0 };
 	uint32_t channel_filter_stop_frequency { 0 };
 
 	void post_message(const buffer_c16_t& data);
+	void post_message(const buffer_s16_t& data);
+
+	/* Real input uses the first half of channel_spectrum, power input all
+	 * of it.
+	 */
+	std::array<complex16_t, channel_spectrum_size / 2>& real_spectrum() {
+		return *reinterpret_cast<std::array<complex16_t, channel_spectrum_size / 2>*>(channel_spectrum.data());
+	}
+	std::array<float, channel_spectrum_size>& power_spectrum() {
+		static_assert(sizeof(float) == sizeof(complex16_t), "power spectrum does not fit");
+		return *reinterpret_cast<std::array<float, channel_spectrum_size>*>(channel_spectrum.data());
+	}
+	void unpack_real_spectrum();
 
 	void set_state(const SpectrumStreamingConfigMessage& message);
 	void start();
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __STAGE_STATS_COLLECTOR_H__
+#define __STAGE_STATS_COLLECTOR_H__
+
+#include "dsp_types.hpp"
+#include "message.hpp"
+#include "utility.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#include <hal.h>
+
+/* Charges DWT cycle counts to the stages of a processor's execute(). A block
+ * is bracketed by start() and process(); each lap() charges the cycles since
+ * the previous start() or lap() to a stage. Disabled, each call is a single
+ * test of a flag.
+ */
+class StageStatsCollector {
+public:
+	using Stage = StageStatistics::Stage;
+
+	void set_enabled(const bool new_enabled) {
+		enabled = new_enabled;
+		reset();
+	}
+
+	void start() {
+		if( enabled ) {
+			last = halGetCounterValue();
+		}
+	}
+
+	void lap(const Stage stage) {
+		if( enabled ) {
+			const uint32_t now = halGetCounterValue();
+			const uint32_t cycles = now - last;
+			last = now;
+
+			auto& s = stages[toUType(stage)];
+			s.min = std::min(s.min, cycles);
+			s.max = std::max(s.max, cycles);
+			s.sum += cycles;
+			s.count++;
+		}
+	}
+
+	template<typename Callback>
+	void process(const buffer_c8_t& buffer, Callback callback) {
+		if( !enabled ) {
+			return;
+		}
+
+		samples += buffer.count;
+
+		const size_t samples_per_update = buffer.sampling_rate * update_interval;
+		if( samples >= samples_per_update ) {
+			callback(capture_statistics(buffer));
+			reset();
+		}
+	}
+
+private:
+	static constexpr float update_interval { 1.0f };
+
+	struct Accumulator {
+		uint32_t min { UINT32_MAX };
+		uint32_t max { 0 };
+		uint64_t sum { 0 };
+		uint32_t count { 0 };
+	};
+
+	bool enabled { false };
+	uint32_t last { 0 };
+	size_t samples { 0 };
+	std::array<Accumulator, toUType(Stage::Count)> stages { };
+
+	void reset() {
+		stages.fill({ });
+		samples = 0;
+	}
+
+	StageStatistics capture_statistics(const buffer_c8_t& buffer) const {
+		StageStatistics statistics;
+		for(size_t i=0; i<stages.size(); i++) {
+			const auto& s = stages[i];
+			if( s.count > 0 ) {
+				statistics.stages[i] = { s.min, static_cast<uint32_t>(s.sum / s.count), s.max, s.count };
+			}
+		}
+		statistics.block_samples = buffer.count;
+		statistics.sampling_rate = buffer.sampling_rate;
+		return statistics;
+	}
+};
+
+#endif/*__STAGE_STATS_COLLECTOR_H__*/
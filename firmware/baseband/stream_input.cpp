@@ -40,37 +40,25 @@ StreamInput::StreamInput(CaptureConfig* const config) :
 }
 
 size_t StreamInput::write(const void* const data, const size_t length) {
-	const uint8_t* p = static_cast<const uint8_t*>(data);
-	size_t written = 0;
-
-	while( written < length ) {
-		if( !active_buffer ) {
-			// We need an empty buffer...
-			if( !fifo_buffers_empty.out(active_buffer) ) {
-				// ...but none are available. Samples were dropped.
-				break;
-			}
-		}
-		
-		const auto remaining = length - written;
-		written += active_buffer->write(&p[written], remaining);
+	const uint8_t* const p = static_cast<const uint8_t*>(data);
+	return write(length, [p](uint8_t* const dst, const size_t offset, const size_t n) {
+		memcpy(dst, &p[offset], n);
+	});
+}
 
-		if( active_buffer->is_full() ) {
-			if( !fifo_buffers_full.in(active_buffer) ) {
-				// FIFO is fuil of buffers, there's no place for this one.
-				// Bail out of the loop, and try submitting the buffer in the
-				// next pass.
-				// This should never happen if the number of buffers is less
-				// than the capacity of the FIFO.
-				break;
-			}
-			active_buffer = nullptr;
-			creg::m4txevent::assert();
-		}
+size_t StreamInput::write_whole(const void* const data, const size_t length) {
+	const size_t space =
+		(active_buffer ? (active_buffer->capacity() - active_buffer->size()) : 0) +
+		fifo_buffers_empty.len() * config->write_size;
+	if( length > space ) {
+		config->baseband_bytes_received += length;
+		config->baseband_bytes_dropped += length;
+		return 0;
 	}
 
-	config->baseband_bytes_received += length;
-	config->baseband_bytes_dropped += (length - written);
+	return write(data, length);
+}
 
-	return written;
+void StreamInput::buffer_full() {
+	creg::m4txevent::assert();
 }
@@ -29,6 +29,7 @@
 #include <cstddef>
 #include <array>
 #include <memory>
+#include <cstring>
 
 class StreamInput {
 public:
@@ -41,6 +42,58 @@ public:
 
 	size_t write(const void* const data, const size_t length);
 
+	/* Writes all of length bytes, or none if the buffers can't take them
+	 * all, so a drop never leaves part of a block in the stream.
+	 */
+	size_t write_whole(const void* const data, const size_t length);
+
+	/* Writes straight into the buffers handed to the application, without
+	 * a copy through an intermediate buffer: fill(p, offset, n) puts bytes
+	 * [offset, offset + n) of the length being written at p. Spans break
+	 * where buffers do, so keep buffers a multiple of the sample size.
+	 */
+	template<typename Fill>
+	size_t write(const size_t length, Fill fill) {
+		size_t written = 0;
+
+		while( written < length ) {
+			if( !active_buffer ) {
+				// We need an empty buffer...
+				if( !fifo_buffers_empty.out(active_buffer) ) {
+					// ...but none are available. Samples were dropped.
+					break;
+				}
+				active_buffer->set_origin(
+					buffer_sequence++,
+					config->baseband_bytes_received + written,
+					Timestamp::now()
+				);
+			}
+
+			written += active_buffer->write(length - written, [&fill, written](uint8_t* const p, const size_t n) {
+				fill(p, written, n);
+			});
+
+			if( active_buffer->is_full() ) {
+				if( !fifo_buffers_full.in(active_buffer) ) {
+					// FIFO is fuil of buffers, there's no place for this one.
+					// Bail out of the loop, and try submitting the buffer in the
+					// next pass.
+					// This should never happen if the number of buffers is less
+					// than the capacity of the FIFO.
+					break;
+				}
+				active_buffer = nullptr;
+				buffer_full();
+			}
+		}
+
+		config->baseband_bytes_received += length;
+		config->baseband_bytes_dropped += (length - written);
+
+		return written;
+	}
+
 private:
 	static constexpr size_t buffer_count_max_log2 = 3;
 	static constexpr size_t buffer_count_max = 1U << buffer_count_max_log2;
@@ -51,8 +104,10 @@ private:
 	std::array<StreamBuffer*, buffer_count_max> buffers_empty { };
 	std::array<StreamBuffer*, buffer_count_max> buffers_full { };
 	StreamBuffer* active_buffer { nullptr };
+	uint32_t buffer_sequence { 0 };
 	CaptureConfig* const config { nullptr };
 	std::unique_ptr<uint8_t[]> data { };
+	void buffer_full();
 };
 
 #endif/*__STREAM_INPUT_H__*/
@@ -185,7 +185,7 @@ Longitude Packet::longitude(const size_t start_bit) const {
 
 bool Packet::crc_ok() const {
 	CRCReader field_crc { packet_ };
-	CRC<16> ais_fcs { 0x1021, 0xffff, 0xffff };
+	CRCTableDriven<16, 0x1021> ais_fcs { 0xffff, 0xffff };
 	
 	for(size_t i=0; i<data_length(); i+=8) {
 		ais_fcs.process_byte(field_crc.read(i, 8));
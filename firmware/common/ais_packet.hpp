@@ -97,8 +97,8 @@ using MMSI = uint32_t;
 
 class Packet {
 public:
-	constexpr Packet(
-		const baseband::Packet& packet
+	Packet(
+		const baseband::PacketView& packet
 	) : packet_ { packet },
 		field_ { packet_ }
 	{
@@ -126,10 +126,10 @@ public:
 	bool crc_ok() const;
 
 private:
-	using Reader = FieldReader<baseband::Packet, BitRemapByteReverse>;
-	using CRCReader = FieldReader<baseband::Packet, BitRemapNone>;
+	using Reader = FieldReader<baseband::PacketView, BitRemapByteReverse>;
+	using CRCReader = FieldReader<baseband::PacketView, BitRemapNone>;
 	
-	const baseband::Packet packet_;
+	const baseband::PacketView packet_;
 	const Reader field_;
 
 	const size_t fcs_length = 16;
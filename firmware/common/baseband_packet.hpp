@@ -25,12 +25,18 @@
 #include "baseband.hpp"
 
 #include <cstddef>
-#include <bitset>
+#include <cstdint>
+#include <array>
 
 namespace baseband {
 
+/* Bits are packed MSB-first into bytes, and the byte array is the last member,
+ * so a message ending in a Packet need only carry the bytes actually used.
+ */
 class Packet {
 public:
+	static constexpr size_t capacity_bits = 1408;
+
 	void set_timestamp(const Timestamp& value) {
 		timestamp_ = value;
 	}
@@ -41,12 +47,18 @@ public:
 
 	void add(const bool symbol) {
 		if( count < capacity() ) {
-			data[count++] = symbol;
+			const uint8_t mask = 0x80U >> (count & 7);
+			if( symbol ) {
+				data_[count >> 3] |= mask;
+			} else {
+				data_[count >> 3] &= ~mask;
+			}
+			count++;
 		}
 	}
 
 	uint_fast8_t operator[](const size_t index) const {
-		return (index < size()) ? data[index] : 0;
+		return (index < size()) ? ((data_[index >> 3] >> (7 - (index & 7))) & 1) : 0;
 	}
 
 	size_t size() const {
@@ -54,17 +66,73 @@ public:
 	}
 
 	size_t capacity() const {
-		return data.size();
+		return capacity_bits;
 	}
 
 	void clear() {
 		count = 0;
 	}
 
+	const uint8_t* data() const {
+		return data_.data();
+	}
+
+	/* Bytes from the start of this object through the last byte holding a bit. */
+	size_t used_size() const {
+		return (data() - reinterpret_cast<const uint8_t*>(this)) + ((count + 7) >> 3);
+	}
+
 private:
-	std::bitset<1408> data { };
 	Timestamp timestamp_ { };
 	size_t count { 0 };
+	std::array<uint8_t, capacity_bits / 8> data_ { };
+};
+
+/* Non-owning view of a Packet's bits, e.g. one still sitting in a message
+ * queue buffer, so decoders don't copy the bits out.
+ */
+class PacketView {
+public:
+	PacketView(
+		const Packet& packet
+	) : data_ { packet.data() },
+		count { packet.size() },
+		timestamp_ { packet.timestamp() }
+	{
+	}
+
+	Timestamp timestamp() const {
+		return timestamp_;
+	}
+
+	uint_fast8_t operator[](const size_t index) const {
+		return (index < size()) ? ((data_[index >> 3] >> (7 - (index & 7))) & 1) : 0;
+	}
+
+	size_t size() const {
+		return count;
+	}
+
+	const uint8_t* data() const {
+		return data_;
+	}
+
+	/* Packed byte, with any bits at or past size() read as zero. */
+	uint8_t byte(const size_t index) const {
+		const size_t bit = index * 8;
+		if( (bit + 8) <= count ) {
+			return data_[index];
+		} else if( bit < count ) {
+			return data_[index] & (0xff << (8 - (count - bit)));
+		} else {
+			return 0;
+		}
+	}
+
+private:
+	const uint8_t* data_;
+	size_t count;
+	Timestamp timestamp_;
 };
 
 } /* namespace baseband */
@@ -33,4 +33,8 @@ Timestamp Timestamp::now() {
     } while( (timestamp.tv_time != LPC_RTC->CTIME0) || (timestamp.tv_date != LPC_RTC->CTIME1) );
     return timestamp;
 }
+#elif !defined(LPC43XX_M0)
+Timestamp Timestamp::now() {
+	return { };
+}
 #endif
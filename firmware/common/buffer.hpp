@@ -31,8 +31,10 @@
  *
  * But yes, this is a hack, and something better is needed. It's too tangled of
  * a knot to tackle at the moment, though...
+ *
+ * Host builds (neither core defined) share the M4 representation.
  */
-#if defined(LPC43XX_M4)
+#if !defined(LPC43XX_M0)
 struct Timestamp {
 	uint32_t tv_date { 0 };
 	uint32_t tv_time { 0 };
@@ -25,13 +25,20 @@ BufferExchange* BufferExchange::obj { nullptr };
 
 BufferExchange::BufferExchange(
 	CaptureConfig* const config
-) : config { config }
-{
+) {
 	obj = this;
 	fifo_buffers_for_baseband = config->fifo_buffers_empty;
 	fifo_buffers_for_application = config->fifo_buffers_full;
 }
 
+BufferExchange::BufferExchange(
+	ReplayConfig* const config
+) {
+	obj = this;
+	fifo_buffers_for_baseband = config->fifo_buffers_full;
+	fifo_buffers_for_application = config->fifo_buffers_empty;
+}
+
 BufferExchange::~BufferExchange() {
 	obj = nullptr;
 	fifo_buffers_for_baseband = nullptr;
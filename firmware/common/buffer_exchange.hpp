@@ -30,6 +30,7 @@
 class BufferExchange {
 public:
 	BufferExchange(CaptureConfig* const config);
+	BufferExchange(ReplayConfig* const config);
 	~BufferExchange();
 
 	BufferExchange(const BufferExchange&) = delete;
@@ -72,7 +73,6 @@ public:
 	}
 
 private:
-	CaptureConfig* const config;
 	FIFO<StreamBuffer*>* fifo_buffers_for_baseband { nullptr };
 	FIFO<StreamBuffer*>* fifo_buffers_for_application { nullptr };
 	Thread* thread { nullptr };
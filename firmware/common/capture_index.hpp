@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef __CAPTURE_INDEX_H__
+#define __CAPTURE_INDEX_H__
+
+#include <cstdint>
+#include <cstddef>
+
+/* Side file to a capture (.IDX) saying where its samples were dropped.
+ *
+ * A Header, then a Record for the first buffer written, for each buffer
+ * written after a drop, and for the end of the capture. Between records,
+ * the capture file holds the stream without gaps. Where
+ * stream_offset - file_offset grows from one record to the next, that many
+ * bytes of stream were lost just before the later record. The end record
+ * catches what was lost when the capture stopped.
+ */
+namespace capture_index {
+
+constexpr uint32_t magic = 0x58444950;	/* "PIDX" */
+constexpr uint16_t version = 1;
+
+struct Header {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t record_size;
+	/* Of the capture file, in samples per second. */
+	uint32_t sampling_rate;
+	/* Of the capture file. 0 if compressed: offsets are then bytes of the
+	 * compressed stream.
+	 */
+	uint8_t bytes_per_sample;
+	uint8_t reserved[3];
+};
+
+static_assert(sizeof(Header) == 16, "Header size wrong");
+
+struct Record {
+	/* Counts the buffers the baseband filled. The end record's is one
+	 * past the last buffer written.
+	 */
+	uint32_t sequence;
+	/* RTC when the baseband started filling the buffer, as CTIME1 and
+	 * CTIME0: year << 16 | month << 8 | day, hour << 16 | minute << 8 | second.
+	 */
+	uint32_t rtc_date;
+	uint32_t rtc_time;
+	uint32_t flags;
+	/* Bytes in the capture file before the buffer. */
+	uint64_t file_offset;
+	/* Bytes the baseband produced before the buffer, dropped or not. */
+	uint64_t stream_offset;
+};
+
+static_assert(sizeof(Record) == 32, "Record size wrong");
+
+/* Record flags. */
+constexpr uint32_t flag_end = 1U << 0;
+
+/* Follows the buffers written to a capture file, to say which need a
+ * Record.
+ */
+class Tracker {
+public:
+	/* Call for each buffer, in the order written, before writing it. True
+	 * if it needs a record, which is filled in.
+	 */
+	bool buffer(
+		const uint32_t sequence,
+		const uint32_t rtc_date,
+		const uint32_t rtc_time,
+		const uint64_t stream_offset,
+		const size_t size,
+		Record& record
+	) {
+		const bool needs_record = (file_offset == 0) || (stream_offset != stream_offset_next);
+		record = { sequence, rtc_date, rtc_time, 0, file_offset, stream_offset };
+
+		file_offset += size;
+		stream_offset_next = stream_offset + size;
+		sequence_next = sequence + 1;
+		return needs_record;
+	}
+
+	/* The end record, once stream_size, the bytes the baseband produced,
+	 * is final.
+	 */
+	Record end(
+		const uint32_t rtc_date,
+		const uint32_t rtc_time,
+		const uint64_t stream_size
+	) const {
+		return { sequence_next, rtc_date, rtc_time, flag_end, file_offset, stream_size };
+	}
+
+private:
+	uint64_t file_offset { 0 };
+	uint64_t stream_offset_next { 0 };
+	uint32_t sequence_next { 0 };
+};
+
+} /* namespace capture_index */
+
+#endif/*__CAPTURE_INDEX_H__*/
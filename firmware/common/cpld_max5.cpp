@@ -115,7 +115,7 @@ bool CPLD::verify(
 }
 
 uint32_t CPLD::crc() {
-	crc_t crc { 0x04c11db7, 0xffffffff, 0xffffffff };
+	crc_t crc { 0xffffffff, 0xffffffff };
 	block_crc(0, 3328, crc);
 	block_crc(1,  512, crc);
 	return crc.checksum();
@@ -144,7 +144,7 @@ private:
 
 	bool is_blank_block(const uint16_t id, const size_t count);
 
-	using crc_t = CRC<32, true, true>;
+	using crc_t = CRCTableDriven<32, 0x04c11db7, true, true>;
 	void block_crc(const uint16_t id, const size_t count, crc_t& crc);
 	
 	const uint32_t IDCODE = 0b00000010000010100101000011011101;
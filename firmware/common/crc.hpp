@@ -26,6 +26,8 @@
 #include <cstdint>
 #include <limits>
 #include <array>
+#include <algorithm>
+#include <type_traits>
 
 /* Inspired by
  * http://www.barrgroup.com/Embedded-Systems/How-To/CRC-Calculation-C-Code
@@ -105,7 +107,7 @@ public:
 		return ((RevOut ? reflect(remainder) : remainder) ^ final_xor_value) & mask();
 	}
 
-private:
+protected:
 	const value_type truncated_polynomial;
 	const value_type initial_remainder;
 	const value_type final_xor_value;
@@ -153,16 +155,107 @@ private:
 	}
 };
 
+/* Remainders after shifting each possible top byte of the register through
+ * eight bits of polynomial division, computed at compile time.
+ */
+template<size_t Width, uint32_t TruncatedPolynomial>
+class CRCLookupTable {
+public:
+	using entry_type = typename std::conditional<(Width <= 8), uint8_t,
+		typename std::conditional<(Width <= 16), uint16_t, uint32_t>::type
+	>::type;
+
+	constexpr CRCLookupTable() {
+		constexpr uint32_t top_bit = 1UL << (Width - 1);
+		constexpr uint32_t mask = (top_bit << 1) - 1;
+		for(size_t i=0; i<256; i++) {
+			uint32_t remainder = static_cast<uint32_t>(i) << (Width - 8);
+			for(size_t bit=0; bit<8; bit++) {
+				remainder = (remainder & top_bit) ? ((remainder << 1) ^ TruncatedPolynomial) : (remainder << 1);
+			}
+			entries[i] = static_cast<entry_type>(remainder & mask);
+		}
+	}
+
+	constexpr uint32_t operator[](const size_t index) const {
+		return entries[index];
+	}
+
+	static const CRCLookupTable instance;
+
+private:
+	entry_type entries[256] { };
+};
+
+template<size_t Width, uint32_t TruncatedPolynomial>
+constexpr CRCLookupTable<Width, TruncatedPolynomial> CRCLookupTable<Width, TruncatedPolynomial>::instance { };
+
+/* As CRC, but with the polynomial fixed at compile time so whole bytes go
+ * through a CRCLookupTable instead of eight rounds of process_bit(). Bits
+ * fed by process_bit() or process_bits() are still handled one at a time.
+ */
+template<size_t Width, uint32_t TruncatedPolynomial, bool RevIn = false, bool RevOut = false>
+class CRCTableDriven : public CRC<Width, RevIn, RevOut> {
+public:
+	static_assert(Width >= 8, "table holds byte-at-a-time remainders, Width must be at least 8");
+
+	constexpr CRCTableDriven(
+		const uint32_t initial_remainder = 0,
+		const uint32_t final_xor_value = 0
+	) : CRC<Width, RevIn, RevOut> { TruncatedPolynomial, initial_remainder, final_xor_value }
+	{
+	}
+
+	void process_byte(const uint8_t byte) {
+		const uint8_t in = RevIn ? reflect_byte(byte) : byte;
+		const size_t index = ((this->remainder >> (Width - 8)) ^ in) & 0xff;
+		this->remainder = (this->remainder << 8) ^ Table::instance[index];
+	}
+
+	void process_bytes(const void* const data, const size_t length) {
+		const uint8_t* const p = reinterpret_cast<const uint8_t*>(data);
+		for(size_t i=0; i<length; i++) {
+			process_byte(p[i]);
+		}
+	}
+
+	template<size_t N>
+	void process_bytes(const std::array<uint8_t, N>& data) {
+		process_bytes(data.data(), data.size());
+	}
+
+private:
+	using Table = CRCLookupTable<Width, TruncatedPolynomial>;
+
+	static uint8_t reflect_byte(uint8_t value) {
+		value = ((value & 0xf0) >> 4) | ((value & 0x0f) << 4);
+		value = ((value & 0xcc) >> 2) | ((value & 0x33) << 2);
+		value = ((value & 0xaa) >> 1) | ((value & 0x55) << 1);
+		return value;
+	}
+};
+
 class Adler32 {
 public:
 	void feed(const uint8_t v) {
 		feed_one(v);
 	}
 
-	void feed(const void* const data, const size_t n) {
-		const uint8_t* const p = reinterpret_cast<const uint8_t*>(data);
-		for(size_t i=0; i<n; i++) {
-			feed_one(p[i]);
+	/* Sums run unreduced for as many bytes as can't overflow b, then take
+	 * one modulo each.
+	 */
+	void feed(const void* const data, size_t n) {
+		const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+		while( n > 0 ) {
+			const size_t block = std::min(n, block_max);
+			for(size_t i=0; i<block; i++) {
+				a += p[i];
+				b += a;
+			}
+			a %= mod;
+			b %= mod;
+			p += block;
+			n -= block;
 		}
 	}
 
@@ -182,13 +275,21 @@ public:
 
 private:
 	static constexpr uint32_t mod = 65521;
+	/* Largest n with 255n(n+1)/2 + (n+1)(mod-1) < 2^32. */
+	static constexpr size_t block_max = 5552;
 
 	uint32_t a { 1 };
 	uint32_t b { 0 };
 
 	void feed_one(const uint8_t c) {
-		a = (a + c) % mod;
-		b = (b + a) % mod;
+		a += c;
+		if( a >= mod ) {
+			a -= mod;
+		}
+		b += a;
+		if( b >= mod ) {
+			b -= mod;
+		}
 	}
 };
 
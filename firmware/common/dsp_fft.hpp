@@ -28,10 +28,11 @@
 #include <cmath>
 #include <type_traits>
 #include <array>
+#include <utility>
 
 #include "dsp_types.hpp"
 #include "complex.hpp"
-#include "hal.h"
+#include "simd.hpp"
 #include "utility.hpp"
 
 namespace std {
@@ -86,13 +87,28 @@ void fft_swap(const std::array<T, N>& src, std::array<T, N>& dst) {
 	}
 }
 
+/* Packs 2N real samples as N complex (even samples real, odd imaginary), in
+ * bit-reversed order, for fft_r_q15_preswapped().
+ */
+template<size_t N>
+void fft_swap_real(const buffer_s16_t src, std::array<complex16_t, N>& dst) {
+	static_assert(power_of_two(N), "only defined for N == power of two");
+
+	for(size_t i=0; i<N; i++) {
+		const size_t i_rev = __RBIT(i) >> (32 - log_2(N));
+		dst[i_rev] = { src.p[i * 2 + 0], src.p[i * 2 + 1] };
+	}
+}
+
 template<typename T, size_t N>
 void fft_swap_in_place(std::array<T, N>& data) {
 	static_assert(power_of_two(N), "only defined for N == power of two");
 
-	for(size_t i=0; i<N/2; i++) {
+	for(size_t i=0; i<N; i++) {
 		const size_t i_rev = __RBIT(i) >> (32 - log_2(N));
-		std::swap(data[i], data[i_rev]);
+		if( i < i_rev ) {
+			std::swap(data[i], data[i_rev]);
+		}
 	}
 }
 
@@ -134,4 +150,265 @@ void fft_c_preswapped(std::array<T, N>& data) {
 	}
 }
 
+/* Fixed-point FFT ********************************************************/
+
+/* Radix-4 decimation-in-time, with a leading radix-2 stage when log2(N) is
+ * odd. Input is bit-reversed (fft_swap(), or fft_swap_in_place()), output
+ * is in natural order.
+ *
+ * fft_c_q15*: complex16_t data, scaled by 1/N (1/2 per radix-2 stage, 1/4
+ * per radix-4 stage) so it cannot overflow as long as input magnitude is
+ * below 32768. Butterflies use packed 16-bit SIMD.
+ *
+ * fft_c_q31*: complex32_t data, not scaled. 16-bit input needs at most 29
+ * bits at N == 4096, so it cannot overflow either. Trades speed for the
+ * dynamic range lost to scaling in the Q15 path.
+ *
+ * Both use the same Q15 twiddle table, computed at compile time.
+ */
+
+namespace fft_detail {
+
+constexpr size_t N_min = 64;
+constexpr size_t N_max = 4096;
+
+constexpr double pi_d { 3.141592653589793238462643383279502884 };
+
+/* Taylor series, for 0 <= x < pi/2. Only evaluated by the compiler. */
+constexpr double sin_first_quadrant(const double x) {
+	double term = x;
+	double sum = x;
+	for(int n=1; n<=12; n++) {
+		term *= -x * x / ((2 * n) * (2 * n + 1));
+		sum += term;
+	}
+	return sum;
+}
+
+constexpr double cos_first_quadrant(const double x) {
+	double term = 1.0;
+	double sum = 1.0;
+	for(int n=1; n<=12; n++) {
+		term *= -x * x / ((2 * n - 1) * (2 * n));
+		sum += term;
+	}
+	return sum;
+}
+
+constexpr int16_t to_q15(const double v) {
+	return (v >= (32767.0 / 32768.0))
+		? 32767
+		: static_cast<int16_t>(v * 32768.0 + ((v >= 0.0) ? 0.5 : -0.5));
+}
+
+/* W_N^k = exp(-2*pi*i*k/N), reduced to the first quadrant so that
+ * multiples of pi/2 are exact.
+ */
+template<size_t N>
+constexpr complex16_t twiddle_q15(const size_t k) {
+	const size_t quadrant = (k * 4) / N;
+	const double x = 2.0 * pi_d * (k - quadrant * (N / 4)) / N;
+	const double s = sin_first_quadrant(x);
+	const double c = cos_first_quadrant(x);
+	const double cos_k = (quadrant == 0) ? c : (quadrant == 1) ? -s : (quadrant == 2) ? -c :  s;
+	const double sin_k = (quadrant == 0) ? s : (quadrant == 1) ?  c : (quadrant == 2) ? -s : -c;
+	return { to_q15(cos_k), to_q15(-sin_k) };
+}
+
+template<size_t N, size_t... I>
+constexpr std::array<complex16_t, sizeof...(I)> make_twiddles_q15(std::index_sequence<I...>) {
+	return { { twiddle_q15<N>(I)... } };
+}
+
+/* Radix-4 stages index W_N^(m*j*N/4L) for m < 4, j < L. */
+template<size_t N>
+struct twiddles_q15 {
+	static_assert(power_of_two(N), "only defined for N == power of two");
+	static_assert((N >= N_min) && (N <= N_max), "FFT size out of range");
+
+	static constexpr std::array<complex16_t, N * 3 / 4> w = make_twiddles_q15<N>(std::make_index_sequence<N * 3 / 4>{ });
+};
+
+template<size_t N>
+constexpr std::array<complex16_t, N * 3 / 4> twiddles_q15<N>::w;
+
+/* (x * w) / 2, x and w packed complex Q15. Halving keeps the result in range
+ * for any x, w.
+ */
+inline uint32_t cmul_half_q15(const uint32_t x, const uint32_t w) {
+	const int32_t re = __SMUSD(x, w) >> 16;
+	const int32_t im = __SMUADX(x, w) >> 16;
+	return __PKHBT(re, im, 16);
+}
+
+inline void butterfly_r4_q15(
+	uint32_t* const p0, uint32_t* const p1, uint32_t* const p2, uint32_t* const p3,
+	const uint32_t w1, const uint32_t w2, const uint32_t w3
+) {
+	/* p1 holds the DFT of the odd-even subsequence, p2 the even-odd, due to
+	 * binary (not base-4) bit reversal of the input.
+	 */
+	const auto z0 = __SHADD16(*p0, 0);
+	const auto z1 = cmul_half_q15(*p2, w1);
+	const auto z2 = cmul_half_q15(*p1, w2);
+	const auto z3 = cmul_half_q15(*p3, w3);
+
+	const auto t0 = __SHADD16(z0, z2);
+	const auto t1 = __SHSUB16(z0, z2);
+	const auto t2 = __SHADD16(z1, z3);
+	const auto t3 = __SHSUB16(z1, z3);
+
+	*p0 = __QADD16(t0, t2);
+	*p1 = __QSAX(t1, t3);		/* t1 - i * t3 */
+	*p2 = __QSUB16(t0, t2);
+	*p3 = __QASX(t1, t3);		/* t1 + i * t3 */
+}
+
+inline complex32_t cmul_q15(const complex32_t x, const complex16_t w) {
+	const int64_t re = static_cast<int64_t>(x.real()) * w.real() - static_cast<int64_t>(x.imag()) * w.imag();
+	const int64_t im = static_cast<int64_t>(x.real()) * w.imag() + static_cast<int64_t>(x.imag()) * w.real();
+	return { static_cast<int32_t>(re >> 15), static_cast<int32_t>(im >> 15) };
+}
+
+inline complex32_t mul_minus_i(const complex32_t x) {
+	return { x.imag(), -x.real() };
+}
+
+} /* namespace fft_detail */
+
+template<size_t N>
+void fft_c_q15_preswapped(std::array<complex16_t, N>& data) {
+	const auto& w = fft_detail::twiddles_q15<N>::w;
+	uint32_t* const p = reinterpret_cast<uint32_t*>(data.data());
+
+	size_t L = 1;
+	if( log_2(N) & 1 ) {
+		for(size_t i=0; i<N; i+=2) {
+			const auto a = p[i + 0];
+			const auto b = p[i + 1];
+			p[i + 0] = __SHADD16(a, b);
+			p[i + 1] = __SHSUB16(a, b);
+		}
+		L = 2;
+	}
+
+	for(; L<N; L*=4) {
+		const size_t w_stride = N / (L * 4);
+		for(size_t j=0; j<L; j++) {
+			const auto w1 = w[j * w_stride * 1].__rep();
+			const auto w2 = w[j * w_stride * 2].__rep();
+			const auto w3 = w[j * w_stride * 3].__rep();
+			for(size_t i=j; i<N; i+=L*4) {
+				fft_detail::butterfly_r4_q15(&p[i], &p[i + L], &p[i + L * 2], &p[i + L * 3], w1, w2, w3);
+			}
+		}
+	}
+}
+
+template<size_t N>
+void fft_c_q15(std::array<complex16_t, N>& data) {
+	fft_swap_in_place(data);
+	fft_c_q15_preswapped(data);
+}
+
+template<size_t N>
+void fft_c_q31_preswapped(std::array<complex32_t, N>& data) {
+	const auto& w = fft_detail::twiddles_q15<N>::w;
+
+	size_t L = 1;
+	if( log_2(N) & 1 ) {
+		for(size_t i=0; i<N; i+=2) {
+			const auto a = data[i + 0];
+			const auto b = data[i + 1];
+			data[i + 0] = a + b;
+			data[i + 1] = a - b;
+		}
+		L = 2;
+	}
+
+	for(; L<N; L*=4) {
+		const size_t w_stride = N / (L * 4);
+		for(size_t j=0; j<L; j++) {
+			const auto w1 = w[j * w_stride * 1];
+			const auto w2 = w[j * w_stride * 2];
+			const auto w3 = w[j * w_stride * 3];
+			for(size_t i=j; i<N; i+=L*4) {
+				const auto z0 = data[i];
+				const auto z1 = fft_detail::cmul_q15(data[i + L * 2], w1);
+				const auto z2 = fft_detail::cmul_q15(data[i + L * 1], w2);
+				const auto z3 = fft_detail::cmul_q15(data[i + L * 3], w3);
+
+				const auto t0 = z0 + z2;
+				const auto t1 = z0 - z2;
+				const auto t2 = z1 + z3;
+				const auto t3 = fft_detail::mul_minus_i(z1 - z3);
+
+				data[i + L * 0] = t0 + t2;
+				data[i + L * 1] = t1 + t3;
+				data[i + L * 2] = t0 - t2;
+				data[i + L * 3] = t1 - t3;
+			}
+		}
+	}
+}
+
+template<size_t N>
+void fft_c_q31(std::array<complex32_t, N>& data) {
+	fft_swap_in_place(data);
+	fft_c_q31_preswapped(data);
+}
+
+/* Real-input FFT: 2N real samples packed as N complex (see fft_swap_real()),
+ * transformed by an N-point complex FFT, then split into the 2N-point
+ * spectrum. Output is bins 0..N-1, scaled by 1/2N, except data[0] holds
+ * bin 0 (real) in .real() and bin N (real) in .imag(). Bins N+1..2N-1 are
+ * the conjugates of bins N-1..1.
+ */
+template<size_t N>
+void fft_r_q15_preswapped(std::array<complex16_t, N>& data) {
+	fft_c_q15_preswapped(data);
+
+	const auto& w = fft_detail::twiddles_q15<N * 2>::w;
+
+	const int32_t z0_re = data[0].real();
+	const int32_t z0_im = data[0].imag();
+	data[0] = {
+		static_cast<int16_t>((z0_re + z0_im) >> 1),
+		static_cast<int16_t>((z0_re - z0_im) >> 1)
+	};
+
+	for(size_t k=1; k<=N/2; k++) {
+		const auto a = data[k];
+		const auto c = data[N - k];
+
+		/* even = (Z[k] + conj(Z[N-k])) / 2, odd = (Z[k] - conj(Z[N-k])) / 2 */
+		const int32_t e_re = (a.real() + c.real()) >> 1;
+		const int32_t e_im = (a.imag() - c.imag()) >> 1;
+		const int32_t o_re = (a.real() - c.real()) >> 1;
+		const int32_t o_im = (a.imag() + c.imag()) >> 1;
+
+		/* f = W_2N^k * -i * odd */
+		const int32_t w_re = w[k].real();
+		const int32_t w_im = w[k].imag();
+		const int32_t f_re = (o_im * w_re + o_re * w_im) >> 15;
+		const int32_t f_im = (o_im * w_im - o_re * w_re) >> 15;
+
+		/* X[k] = even + f, X[N-k] = conj(even - f), halved for 1/2N scale. */
+		data[k] = {
+			static_cast<int16_t>((e_re + f_re) >> 1),
+			static_cast<int16_t>((e_im + f_im) >> 1)
+		};
+		data[N - k] = {
+			static_cast<int16_t>((e_re - f_re) >> 1),
+			static_cast<int16_t>((f_im - e_im) >> 1)
+		};
+	}
+}
+
+template<size_t N>
+void fft_r_q15(std::array<complex16_t, N>& data) {
+	fft_swap_in_place(data);
+	fft_r_q15_preswapped(data);
+}
+
 #endif/*__DSP_FFT_H__*/
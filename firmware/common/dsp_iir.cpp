@@ -21,8 +21,6 @@
 
 #include "dsp_iir.hpp"
 
-#include <hal.h>
-
 void IIRBiquadFilter::configure(const iir_biquad_config_t& new_config) {
 	config = new_config;
 }
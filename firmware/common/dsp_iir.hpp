@@ -22,6 +22,8 @@
 #ifndef __DSP_IIR_H__
 #define __DSP_IIR_H__
 
+#include <cstdint>
+#include <cstddef>
 #include <array>
 
 #include "dsp_types.hpp"
@@ -67,4 +69,95 @@ private:
 	std::array<float, 3> y { { 0.0f, 0.0f, 0.0f } };
 };
 
+/* Biquad sections in series, in fixed point, evaluated one sample at a time
+ * so callers can fuse several filters into one pass over a block.
+ * Direct form I with Q2.29 coefficients (normalized so a0=1.0, |c| < 4.0)
+ * and 64-bit accumulation. Outputs are rounded to integers, and each
+ * section feeds the rounding errors back through its poles (error
+ * feedback), so round-off noise is not amplified by poles near z=1, e.g.
+ * a 30Hz HPF at 48kHz.
+ * Samples are integers (Q15 for audio); 32 bits leaves headroom between
+ * sections.
+ */
+template<size_t Sections>
+class IIRBiquadCascade {
+public:
+	constexpr IIRBiquadCascade(
+	) : sections { }
+	{
+	}
+
+	IIRBiquadCascade(
+		const std::array<iir_biquad_config_t, Sections>& configs
+	) : IIRBiquadCascade()
+	{
+		configure(configs);
+	}
+
+	void configure(const std::array<iir_biquad_config_t, Sections>& configs) {
+		for(size_t i=0; i<Sections; i++) {
+			auto& s = sections[i];
+			const auto& c = configs[i];
+			s.b0 = to_q29(c.b[0]);
+			s.b1 = to_q29(c.b[1]);
+			s.b2 = to_q29(c.b[2]);
+			s.a1 = to_q29(c.a[1]);
+			s.a2 = to_q29(c.a[2]);
+		}
+	}
+
+	int32_t execute(const int32_t in) {
+		int32_t v = in;
+		for(auto& s : sections) {
+			/* Rounding errors of y1 and y2, through the feedback
+			 * coefficients, so the recursion sees full-precision outputs.
+			 */
+			int64_t error = static_cast<int64_t>(s.a1) * s.e1;
+			error += static_cast<int64_t>(s.a2) * s.e2;
+
+			int64_t acc = -(error >> q);
+			acc += static_cast<int64_t>(s.b0) * v;
+			acc += static_cast<int64_t>(s.b1) * s.x1;
+			acc += static_cast<int64_t>(s.b2) * s.x2;
+			acc -= static_cast<int64_t>(s.a1) * s.y1;
+			acc -= static_cast<int64_t>(s.a2) * s.y2;
+
+			const int32_t y = (acc + (1 << (q - 1))) >> q;
+
+			s.e2 = s.e1;
+			s.e1 = acc - (static_cast<int64_t>(y) << q);
+			s.x2 = s.x1;
+			s.x1 = v;
+			s.y2 = s.y1;
+			s.y1 = y;
+			v = y;
+		}
+		return v;
+	}
+
+private:
+	static constexpr size_t q = 29;
+
+	struct Section {
+		int32_t b0 { 0 };
+		int32_t b1 { 0 };
+		int32_t b2 { 0 };
+		int32_t a1 { 0 };
+		int32_t a2 { 0 };
+		int32_t x1 { 0 };
+		int32_t x2 { 0 };
+		int32_t y1 { 0 };
+		int32_t y2 { 0 };
+		int32_t e1 { 0 };
+		int32_t e2 { 0 };
+	};
+
+	std::array<Section, Sections> sections;
+
+	static int32_t to_q29(const float v) {
+		const float scaled = v * (1U << q);
+		return (scaled < 0.0f) ? (scaled - 0.5f) : (scaled + 0.5f);
+	}
+};
+
 #endif/*__DSP_IIR_H__*/
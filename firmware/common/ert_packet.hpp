@@ -49,7 +49,7 @@ public:
 
 	Packet(
 		const Type type,
-		const baseband::Packet& packet
+		const baseband::PacketView& packet
 	) : packet_ { packet },
 		decoder_ { packet_ },
 		reader_ { decoder_ },
@@ -75,7 +75,7 @@ public:
 private:
 	using Reader = FieldReader<ManchesterDecoder, BitRemapNone>;
 
-	const baseband::Packet packet_;
+	const baseband::PacketView packet_;
 	const ManchesterDecoder decoder_;
 	const Reader reader_;
 	const Type type_;
@@ -25,16 +25,32 @@
 #include <cstdint>
 #include <cstddef>
 
+#include "baseband_packet.hpp"
+
+/* Each remap also says how to apply it to a whole byte of MSB-first packed
+ * bits, for readers that work a byte at a time.
+ */
 struct BitRemapNone {
 	constexpr size_t operator()(const size_t& bit_index) const {
 		return bit_index;
 	}
+
+	static constexpr uint8_t byte(const uint8_t value) {
+		return value;
+	}
 };
 
 struct BitRemapByteReverse {
 	constexpr size_t operator()(const size_t bit_index) const {
 		return bit_index ^ 7;
 	}
+
+	static uint8_t byte(uint8_t value) {
+		value = ((value & 0xf0) >> 4) | ((value & 0x0f) << 4);
+		value = ((value & 0xcc) >> 2) | ((value & 0x33) << 2);
+		value = ((value & 0xaa) >> 1) | ((value & 0x55) << 1);
+		return value;
+	}
 };
 
 template<typename T, typename BitRemap>
@@ -62,4 +78,45 @@ private:
 	const BitRemap bit_remap { };
 };
 
+/* Packed packets are read a byte at a time: the bytes spanning the field are
+ * shifted into a word, and the field masked out of that.
+ */
+template<typename BitRemap>
+class FieldReader<baseband::PacketView, BitRemap> {
+public:
+	constexpr FieldReader(
+		const baseband::PacketView& data
+	) : data { data }
+	{
+	}
+
+	uint32_t read(const size_t start_bit, const size_t length) const {
+		return read64(start_bit, length);
+	}
+
+	/* As read(), for fields of up to 64 bits. */
+	uint64_t read64(const size_t start_bit, const size_t length) const {
+		if( length == 0 ) {
+			return 0;
+		}
+
+		const size_t end_bit = start_bit + length;
+		const size_t first_byte = start_bit >> 3;
+		const size_t last_byte = (end_bit - 1) >> 3;
+		const size_t last_byte_unused = 7 - ((end_bit - 1) & 7);
+
+		/* Bits ahead of the field that overflow the word are discarded. */
+		uint64_t word = 0;
+		for(size_t i=first_byte; i<last_byte; i++) {
+			word = (word << 8) | BitRemap::byte(data.byte(i));
+		}
+		word = (word << (8 - last_byte_unused)) | (BitRemap::byte(data.byte(last_byte)) >> last_byte_unused);
+
+		return (length < 64) ? (word & ((uint64_t(1) << length) - 1)) : word;
+	}
+
+private:
+	const baseband::PacketView& data;
+};
+
 #endif/*__FIELD_READER_H__*/
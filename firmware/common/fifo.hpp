@@ -48,6 +48,12 @@ public:
 		_in = _out = 0;
 	}
 
+	/* Resizes to 2^k elements, no more than data was given room for. */
+	void reset(const size_t k) {
+		_size = 1U << k;
+		reset();
+	}
+
 	void reset_in() {
 		_in = _out;
 	}
@@ -72,6 +78,19 @@ public:
 		return unused() == 0;
 	}
 
+	size_t capacity() const {
+		return size();
+	}
+
+	/* Free-running counts of elements put in and taken out. */
+	size_t position_in() const {
+		return _in;
+	}
+
+	size_t position_out() const {
+		return _out;
+	}
+
 	bool in(const T& val) {
 		if( is_full() ) {
 			return false;
@@ -231,7 +250,7 @@ private:
 	}
 
 	T* const _data;
-	const size_t _size;
+	size_t _size;
 	volatile size_t _in;
 	volatile size_t _out;
 };
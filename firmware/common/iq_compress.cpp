@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "iq_compress.hpp"
+
+#include <cstring>
+
+namespace iq_compress {
+
+namespace {
+
+class BitWriter {
+public:
+	explicit BitWriter(
+		uint8_t* const p
+	) : p { p }
+	{
+	}
+
+	/* Puts the low n bits of value, n at most 24. */
+	void put(const uint32_t value, const size_t n) {
+		bits = (bits << n) | (value & ((1U << n) - 1));
+		bits_count += n;
+		while( bits_count >= 8 ) {
+			bits_count -= 8;
+			*(p++) = bits >> bits_count;
+		}
+	}
+
+	/* Pads the last byte with zeros. Returns the end of the bytes written. */
+	uint8_t* flush() {
+		if( bits_count ) {
+			put(0, 8 - bits_count);
+		}
+		return p;
+	}
+
+private:
+	uint8_t* p;
+	uint32_t bits { 0 };
+	size_t bits_count { 0 };
+};
+
+class BitReader {
+public:
+	BitReader(
+		const uint8_t* const p,
+		const size_t size
+	) : p { p },
+		end { p + size },
+		bits_remaining { size * 8 }
+	{
+	}
+
+	/* Gets n bits, n at most 24. Reads past the end return zeros. */
+	uint32_t get(const size_t n) {
+		while( bits_count < n ) {
+			bits = (bits << 8) | ((p < end) ? *(p++) : 0);
+			bits_count += 8;
+		}
+		bits_count -= n;
+		overrun_ |= (n > bits_remaining);
+		bits_remaining -= overrun_ ? bits_remaining : n;
+		return (bits >> bits_count) & ((1U << n) - 1);
+	}
+
+	/* Counts 1s up to the next 0, or up to limit. */
+	size_t ones(const size_t limit) {
+		size_t count = 0;
+		while( (count < limit) && get(1) ) {
+			count++;
+		}
+		return count;
+	}
+
+	bool overrun() const {
+		return overrun_;
+	}
+
+private:
+	const uint8_t* p;
+	const uint8_t* const end;
+	uint32_t bits { 0 };
+	size_t bits_count { 0 };
+	size_t bits_remaining;
+	bool overrun_ { false };
+};
+
+constexpr uint32_t zigzag(const int32_t v) {
+	return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+constexpr int32_t unzigzag(const uint32_t u) {
+	return static_cast<int32_t>(u >> 1) ^ -static_cast<int32_t>(u & 1);
+}
+
+constexpr uint8_t coding_byte(const Coding coding, const size_t k) {
+	return (static_cast<uint8_t>(coding) << 5) | k;
+}
+
+/* Value n of I (part 0) or Q (part 1). */
+int32_t value(const complex16_t* const samples, const size_t n, const size_t part) {
+	return part ? samples[n].imag() : samples[n].real();
+}
+
+/* Smallest k with count * 2^(k + 1) > sum: about log2 of the mean. */
+size_t rice_parameter(const uint32_t sum, const size_t count) {
+	size_t k = 0;
+	while( (k < 16) && ((static_cast<uint64_t>(count) << (k + 1)) <= sum) ) {
+		k++;
+	}
+	return k;
+}
+
+void put_rice(BitWriter& writer, const uint32_t u, const size_t k) {
+	const auto q = u >> k;
+	if( q < escape_ones ) {
+		writer.put(((1U << q) - 1) << 1, q + 1);
+		writer.put(u, k);
+	} else {
+		writer.put((1U << escape_ones) - 1, escape_ones);
+		writer.put(u, 17);
+	}
+}
+
+uint8_t encode_part_raw(
+	BitWriter& writer,
+	const complex16_t* const samples,
+	const size_t count,
+	const size_t part
+) {
+	for(size_t n=0; n<count; n++) {
+		writer.put(static_cast<uint16_t>(value(samples, n, part)), 16);
+	}
+	return coding_byte(Coding::Raw, 0);
+}
+
+/* Codes one part, returning its Coding byte. Falls back to raw if Rice
+ * turns out no smaller.
+ */
+uint8_t encode_part(
+	BitWriter& writer,
+	const complex16_t* const samples,
+	const size_t count,
+	const size_t part
+) {
+	uint32_t sum = 0;
+	uint32_t sum_delta = 0;
+	int32_t previous = 0;
+	for(size_t n=0; n<count; n++) {
+		const auto v = value(samples, n, part);
+		sum += zigzag(v);
+		sum_delta += zigzag(v - previous);
+		previous = v;
+	}
+
+	const bool delta = (sum_delta < sum);
+	const auto k = rice_parameter(delta ? sum_delta : sum, count);
+
+	/* Rice bits are about count * (k + 1) + sum / 2^k. */
+	const uint32_t rice_bits = count * (k + 1) + ((delta ? sum_delta : sum) >> k);
+	if( rice_bits >= (count * 16) ) {
+		return encode_part_raw(writer, samples, count, part);
+	}
+
+	const BitWriter start = writer;
+	size_t bits = 0;
+	previous = 0;
+	for(size_t n=0; n<count; n++) {
+		const auto v = value(samples, n, part);
+		const auto u = zigzag(delta ? (v - previous) : v);
+		previous = v;
+		put_rice(writer, u, k);
+
+		const auto q = u >> k;
+		bits += (q < escape_ones) ? (q + 1 + k) : (escape_ones + 17);
+		if( bits >= (count * 16) ) {
+			writer = start;
+			return encode_part_raw(writer, samples, count, part);
+		}
+	}
+
+	return coding_byte(delta ? Coding::RiceDelta : Coding::Rice, k);
+}
+
+bool decode_part(
+	BitReader& reader,
+	const uint8_t coding_k,
+	complex16_t* const samples,
+	const size_t count,
+	const size_t part
+) {
+	const auto coding = static_cast<Coding>(coding_k >> 5);
+	const size_t k = coding_k & 0x1f;
+	if( k > 16 ) {
+		return false;
+	}
+
+	int32_t previous = 0;
+	for(size_t n=0; n<count; n++) {
+		int32_t v = 0;
+		switch(coding) {
+		case Coding::Raw:
+			v = static_cast<int16_t>(reader.get(16));
+			break;
+
+		case Coding::Rice:
+		case Coding::RiceDelta:
+			{
+				const auto q = reader.ones(escape_ones);
+				const auto u = (q < escape_ones) ? ((q << k) | reader.get(k)) : reader.get(17);
+				v = unzigzag(u) + ((coding == Coding::RiceDelta) ? previous : 0);
+			}
+			break;
+
+		default:
+			return false;
+		}
+
+		previous = v;
+		if( part ) {
+			samples[n] = { samples[n].real(), static_cast<int16_t>(v) };
+		} else {
+			samples[n] = { static_cast<int16_t>(v), 0 };
+		}
+	}
+
+	return !reader.overrun();
+}
+
+} /* namespace */
+
+size_t BlockEncoder::encode(const complex16_t* const samples, const size_t count, uint8_t* const out) {
+	BlockHeader header {
+		block_sync,
+		sequence++,
+		static_cast<uint16_t>(count),
+		0,
+		{ 0, 0 },
+		{ 0, 0 },
+	};
+
+	uint8_t* const payload = &out[sizeof(header)];
+	BitWriter writer { payload };
+	header.coding[0] = encode_part(writer, samples, count, 0);
+	header.coding[1] = encode_part(writer, samples, count, 1);
+	header.payload_size = writer.flush() - payload;
+
+	memcpy(out, &header, sizeof(header));
+	return sizeof(header) + header.payload_size;
+}
+
+bool decode(
+	const BlockHeader& header,
+	const uint8_t* const payload,
+	complex16_t* const samples
+) {
+	if( (header.sync != block_sync) || (header.sample_count > block_samples) ) {
+		return false;
+	}
+
+	BitReader reader { payload, header.payload_size };
+	return decode_part(reader, header.coding[0], samples, header.sample_count, 0)
+	    && decode_part(reader, header.coding[1], samples, header.sample_count, 1);
+}
+
+} /* namespace iq_compress */
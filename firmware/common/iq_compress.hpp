@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __IQ_COMPRESS_H__
+#define __IQ_COMPRESS_H__
+
+#include "complex.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+/* Lossless compression of complex16_t captures, in blocks of up to
+ * block_samples samples. Each block is a BlockHeader and then a bit stream,
+ * MSB first, holding the I values and then the Q values, padded to a byte.
+ * Each is coded one of three ways, given by its Coding byte:
+ *
+ *   Raw         16 bits per value.
+ *   Rice        Values zigzag-mapped to unsigned (0, -1, 1, -2...), then
+ *               Rice coded with parameter k: the value >> k in unary as
+ *               that many 1s and a 0, then the k low bits.
+ *   RiceDelta   As Rice, for the difference from the previous value in
+ *               the block (the first value's from 0).
+ *
+ * A unary part of escape_ones 1s is followed by the 17 bit zigzag value
+ * itself, and no 0.
+ *
+ * Blocks decode independently. The sequence number counts blocks, so a
+ * decoder can fill blocks the capture dropped to keep the timing.
+ */
+namespace iq_compress {
+
+constexpr size_t block_samples = 256;
+constexpr uint16_t block_sync = 0x5a51;
+constexpr size_t escape_ones = 16;
+
+enum class Coding : uint8_t {
+	Raw = 0,
+	Rice = 1,
+	RiceDelta = 2,
+};
+
+struct BlockHeader {
+	uint16_t sync;
+	uint16_t sequence;
+	uint16_t sample_count;
+	uint16_t payload_size;
+	/* Coding in bits 7:5, Rice parameter k in bits 4:0. I, then Q. */
+	uint8_t coding[2];
+	uint8_t reserved[2];
+};
+
+static_assert(sizeof(BlockHeader) == 12, "BlockHeader size wrong");
+
+/* Raw coding bounds the bit stream, so a block never outgrows this. */
+constexpr size_t block_size_max = sizeof(BlockHeader) + block_samples * 2 * sizeof(int16_t);
+
+class BlockEncoder {
+public:
+	/* Codes count samples, at most block_samples, into out, which must hold
+	 * block_size_max bytes. Returns the bytes used.
+	 */
+	size_t encode(const complex16_t* const samples, const size_t count, uint8_t* const out);
+
+private:
+	uint16_t sequence { 0 };
+};
+
+/* Decodes a block whose header has been read and checked, from its
+ * payload_size byte bit stream into header.sample_count samples. False if
+ * the bit stream doesn't hold them.
+ */
+bool decode(
+	const BlockHeader& header,
+	const uint8_t* const payload,
+	complex16_t* const samples
+);
+
+} /* namespace iq_compress */
+
+#endif/*__IQ_COMPRESS_H__*/
@@ -23,6 +23,8 @@
 
 #include "string_format.hpp"
 
+#include <algorithm>
+
 DecodedSymbol ManchesterDecoder::operator[](const size_t index) const {
 	const size_t encoded_index = index * 2;
 	if( (encoded_index + 1) < packet.size() ) {
@@ -34,6 +36,28 @@ DecodedSymbol ManchesterDecoder::operator[](const size_t index) const {
 	}
 }
 
+uint32_t ManchesterDecoder::read(const size_t start_index, const size_t length) const {
+	const size_t symbols_available = (start_index < symbols_count()) ? (symbols_count() - start_index) : 0;
+	const size_t length_available = std::min(length, symbols_available);
+	if( length_available == 0 ) {
+		return 0;
+	}
+
+	/* Each symbol is a pair of encoded bits; keep the one "sense" selects,
+	 * then squeeze out the gaps between them.
+	 */
+	const FieldReader<baseband::PacketView, BitRemapNone> encoded { packet };
+	uint64_t bits = encoded.read64(start_index * 2, length_available * 2);
+	bits = (sense ? bits : (bits >> 1)) & 0x5555555555555555ULL;
+	bits = (bits | (bits >>  1)) & 0x3333333333333333ULL;
+	bits = (bits | (bits >>  2)) & 0x0f0f0f0f0f0f0f0fULL;
+	bits = (bits | (bits >>  4)) & 0x00ff00ff00ff00ffULL;
+	bits = (bits | (bits >>  8)) & 0x0000ffff0000ffffULL;
+	bits = (bits | (bits >> 16)) & 0x00000000ffffffffULL;
+
+	return static_cast<uint32_t>(bits) << (length - length_available);
+}
+
 size_t ManchesterDecoder::symbols_count() const {
 	return packet.size() / 2;
 }
@@ -24,10 +24,10 @@
 
 #include <cstdint>
 #include <cstddef>
-#include <bitset>
 #include <string>
 
 #include "baseband_packet.hpp"
+#include "field_reader.hpp"
 
 struct DecodedSymbol {
 	uint_fast8_t value;
@@ -37,7 +37,7 @@ struct DecodedSymbol {
 class ManchesterDecoder {
 public:
 	constexpr ManchesterDecoder(
-		const baseband::Packet& packet,
+		const baseband::PacketView& packet,
 		const size_t sense = 0
 	) : packet { packet },
 		sense { sense }
@@ -46,13 +46,35 @@ public:
 
 	DecodedSymbol operator[](const size_t index) const;
 
+	/* Values of up to 32 symbols, first symbol in the MSB. Errors are not
+	 * reported; symbols past symbols_count() read as zero.
+	 */
+	uint32_t read(const size_t start_index, const size_t length) const;
+
 	size_t symbols_count() const;
 
 private:
-	const baseband::Packet& packet;
+	const baseband::PacketView& packet;
 	const size_t sense;
 };
 
+template<>
+class FieldReader<ManchesterDecoder, BitRemapNone> {
+public:
+	constexpr FieldReader(
+		const ManchesterDecoder& data
+	) : data { data }
+	{
+	}
+
+	uint32_t read(const size_t start_bit, const size_t length) const {
+		return data.read(start_bit, length);
+	}
+
+private:
+	const ManchesterDecoder& data;
+};
+
 template<typename T>
 T operator|(const T& l, const DecodedSymbol& r) {
 	return l | r.value;
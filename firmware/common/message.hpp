@@ -64,6 +64,11 @@ public:
 		DisplaySleep = 16,
 		CaptureConfig = 17,
 		CaptureThreadDone = 18,
+		WidebandSpectrumConfig = 19,
+		StageStatisticsConfig = 20,
+		StageStatistics = 21,
+		ReplayConfig = 22,
+		ReplayThreadDone = 23,
 		MAX
 	};
 
@@ -322,20 +327,27 @@ public:
 
 class WFMConfigureMessage : public Message {
 public:
+	enum class Spectrum : int32_t {
+		Channel = 0,
+		MPX = 1,
+	};
+
 	constexpr WFMConfigureMessage(
 		const fir_taps_real<24> decim_0_filter,
 		const fir_taps_real<16> decim_1_filter,
 		const fir_taps_real<64> audio_filter,
 		const size_t deviation,
 		const iir_biquad_config_t audio_hpf_config,
-		const iir_biquad_config_t audio_deemph_config
+		const iir_biquad_config_t audio_deemph_config,
+		const Spectrum spectrum
 	) : Message { ID::WFMConfigure },
 		decim_0_filter(decim_0_filter),
 		decim_1_filter(decim_1_filter),
 		audio_filter(audio_filter),
 		deviation { deviation },
 		audio_hpf_config(audio_hpf_config),
-		audio_deemph_config(audio_deemph_config)
+		audio_deemph_config(audio_deemph_config),
+		spectrum { spectrum }
 	{
 	}
 
@@ -345,6 +357,7 @@ public:
 	const size_t deviation;
 	const iir_biquad_config_t audio_hpf_config;
 	const iir_biquad_config_t audio_deemph_config;
+	const Spectrum spectrum;
 };
 
 class AMConfigureMessage : public Message {
@@ -384,6 +397,10 @@ class StreamBuffer {
 	uint8_t* data_;
 	size_t used_;
 	size_t capacity_;
+	size_t read_offset_;
+	uint32_t sequence_;
+	uint64_t stream_offset_;
+	Timestamp timestamp_;
 
 public:
 	constexpr StreamBuffer(
@@ -391,10 +408,35 @@ public:
 		const size_t capacity = 0
 	) : data_ { static_cast<uint8_t*>(data) },
 		used_ { 0 },
-		capacity_ { capacity }
+		capacity_ { capacity },
+		read_offset_ { 0 },
+		sequence_ { 0 },
+		stream_offset_ { 0 },
+		timestamp_ { }
 	{
 	}
 
+	/* Where the buffer's data starts in the stream: the count of buffers
+	 * before it and bytes before it, dropped ones included, and when.
+	 */
+	void set_origin(const uint32_t sequence, const uint64_t stream_offset, const Timestamp timestamp) {
+		sequence_ = sequence;
+		stream_offset_ = stream_offset;
+		timestamp_ = timestamp;
+	}
+
+	uint32_t sequence() const {
+		return sequence_;
+	}
+
+	uint64_t stream_offset() const {
+		return stream_offset_;
+	}
+
+	Timestamp timestamp() const {
+		return timestamp_;
+	}
+
 	size_t write(const void* p, const size_t count) {
 		const auto copy_size = std::min(capacity_ - used_, count);
 		memcpy(&data_[used_], p, copy_size);
@@ -402,10 +444,30 @@ public:
 		return copy_size;
 	}
 
+	/* Writes in place: fill(p, n) puts the next n bytes at p. */
+	template<typename Fill>
+	size_t write(const size_t count, Fill fill) {
+		const auto fill_size = std::min(capacity_ - used_, count);
+		fill(&data_[used_], fill_size);
+		used_ += fill_size;
+		return fill_size;
+	}
+
+	size_t read(void* p, const size_t count) {
+		const auto copy_size = std::min(used_ - read_offset_, count);
+		memcpy(p, &data_[read_offset_], copy_size);
+		read_offset_ += copy_size;
+		return copy_size;
+	}
+
 	bool is_full() const {
 		return used_ >= capacity_;
 	}
 
+	bool is_read() const {
+		return read_offset_ >= used_;
+	}
+
 	void* data() const {
 		return data_;
 	}
@@ -418,14 +480,37 @@ public:
 		used_ = value;
 	}
 
+	size_t capacity() const {
+		return capacity_;
+	}
+
 	void empty() {
 		used_ = 0;
+		read_offset_ = 0;
 	}
 };
 
 struct CaptureConfig {
+	/* What CaptureProcessor streams. Audio processors ignore this. */
+	enum class Format : uint32_t {
+		/* Baseband. At decimation 1 as received, with the target wherever
+		 * the application tuned it, so captures at a decoder's rate and
+		 * tuning replay into that decoder. At 2, 4 or 8 translated by
+		 * -fs/4 to put the target at DC and decimated with CIC filters.
+		 */
+		C8 = 0,
+		/* The channel, filtered and decimated by 8. */
+		C16 = 1,
+		/* C16, losslessly compressed in iq_compress blocks. */
+		C16Compressed = 2,
+	};
+
 	const size_t write_size;
 	const size_t buffer_count;
+	const Format format;
+	const size_t decimation;
+	/* Of the samples streamed, as the application set the radio. */
+	const uint32_t sampling_rate;
 	uint64_t baseband_bytes_received;
 	uint64_t baseband_bytes_dropped;
 	FIFO<StreamBuffer*>* fifo_buffers_empty;
@@ -433,9 +518,15 @@ struct CaptureConfig {
 
 	constexpr CaptureConfig(
 		const size_t write_size,
-		const size_t buffer_count
+		const size_t buffer_count,
+		const Format format = Format::C16,
+		const size_t decimation = 8,
+		const uint32_t sampling_rate = 500000
 	) : write_size { write_size },
 		buffer_count { buffer_count },
+		format { format },
+		decimation { decimation },
+		sampling_rate { sampling_rate },
 		baseband_bytes_received { 0 },
 		baseband_bytes_dropped { 0 },
 		fifo_buffers_empty { nullptr },
@@ -448,7 +539,7 @@ struct CaptureConfig {
 			return 0;
 		} else {
 			const size_t percent = baseband_bytes_dropped * 100U / baseband_bytes_received;
-			return std::max(1U, percent);
+			return std::max<size_t>(1U, percent);
 		}
 	}
 };
@@ -477,4 +568,178 @@ public:
 	uint32_t error;
 };
 
+/* Samples the application reads from a file and the baseband runs its
+ * processor on in place of the radio's. Buffers go the opposite way to
+ * CaptureConfig's: the application fills empty ones, the baseband empties
+ * full ones.
+ */
+struct ReplayConfig {
+	enum class Format : uint32_t {
+		C8 = 0,
+		/* Converted to complex8_t by taking the high byte. */
+		C16 = 1,
+	};
+
+	const size_t read_size;
+	const size_t buffer_count;
+	const Format format;
+	/* Paced to the processor's sampling rate, or run as fast as samples
+	 * arrive.
+	 */
+	const bool real_time;
+	uint64_t baseband_bytes_replayed;
+	/* Times real-time replay fell behind waiting for samples. */
+	uint32_t baseband_underruns;
+	FIFO<StreamBuffer*>* fifo_buffers_empty;
+	FIFO<StreamBuffer*>* fifo_buffers_full;
+
+	constexpr ReplayConfig(
+		const size_t read_size,
+		const size_t buffer_count,
+		const Format format,
+		const bool real_time
+	) : read_size { read_size },
+		buffer_count { buffer_count },
+		format { format },
+		real_time { real_time },
+		baseband_bytes_replayed { 0 },
+		baseband_underruns { 0 },
+		fifo_buffers_empty { nullptr },
+		fifo_buffers_full { nullptr }
+	{
+	}
+
+	size_t bytes_per_sample() const {
+		return (format == Format::C16) ? 4 : 2;
+	}
+};
+
+class ReplayConfigMessage : public Message {
+public:
+	constexpr ReplayConfigMessage(
+		ReplayConfig* const config
+	) : Message { ID::ReplayConfig },
+		config { config }
+	{
+	}
+
+	ReplayConfig* const config;
+};
+
+class ReplayThreadDoneMessage : public Message {
+public:
+	constexpr ReplayThreadDoneMessage(
+		uint32_t error = 0
+	) : Message { ID::ReplayThreadDone },
+		error { error }
+	{
+	}
+
+	uint32_t error;
+};
+
+class WidebandSpectrumConfigMessage : public Message {
+public:
+	enum class Overlap : uint32_t {
+		None = 0,
+		Half = 1,
+		ThreeQuarters = 2,
+	};
+
+	enum class Averaging : uint32_t {
+		Linear = 0,
+		PeakHold = 1,
+		Exponential = 2,
+	};
+
+	constexpr WidebandSpectrumConfigMessage(
+		const Overlap overlap,
+		const Averaging averaging
+	) : Message { ID::WidebandSpectrumConfig },
+		overlap { overlap },
+		averaging { averaging }
+	{
+	}
+
+	const Overlap overlap;
+	const Averaging averaging;
+};
+
+class StageStatisticsConfigMessage : public Message {
+public:
+	constexpr StageStatisticsConfigMessage(
+		const bool enabled
+	) : Message { ID::StageStatisticsConfig },
+		enabled { enabled }
+	{
+	}
+
+	const bool enabled;
+};
+
+/* Cycles spent in each stage of a processor's execute(), per block. Stages a
+ * processor doesn't have report a count of zero.
+ */
+struct StageStatistics {
+	enum class Stage : uint32_t {
+		Decim0 = 0,
+		Decim1 = 1,
+		Channel = 2,
+		Demod = 3,
+		Audio = 4,
+		Spectrum = 5,
+		Count,
+	};
+
+	struct Cycles {
+		uint32_t min { 0 };
+		uint32_t avg { 0 };
+		uint32_t max { 0 };
+		uint32_t count { 0 };
+	};
+
+	std::array<Cycles, toUType(Stage::Count)> stages { };
+	/* Input block size and rate, to relate cycles to the time per block. */
+	uint32_t block_samples { 0 };
+	uint32_t sampling_rate { 0 };
+};
+
+class StageStatisticsMessage : public Message {
+public:
+	constexpr StageStatisticsMessage(
+		const StageStatistics& statistics
+	) : Message { ID::StageStatistics },
+		statistics { statistics }
+	{
+	}
+
+	StageStatistics statistics;
+};
+
+/* Number of bytes of a message to copy through a MessageQueue. Packet
+ * messages end with their Packet, so only the bits received are copied.
+ */
+template<typename T>
+constexpr size_t message_size(const T&) {
+	return sizeof(T);
+}
+
+template<typename T>
+size_t packet_message_size(const T& message) {
+	const auto packet_offset = reinterpret_cast<const uint8_t*>(&message.packet) - reinterpret_cast<const uint8_t*>(&message);
+	return packet_offset + message.packet.used_size();
+}
+
+inline size_t message_size(const AISPacketMessage& message) {
+	return packet_message_size(message);
+}
+
+inline size_t message_size(const TPMSPacketMessage& message) {
+	return packet_message_size(message);
+}
+
+inline size_t message_size(const ERTPacketMessage& message) {
+	return packet_message_size(message);
+}
+
 #endif/*__MESSAGE_H__*/
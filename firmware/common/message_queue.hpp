@@ -23,12 +23,29 @@
 #define __MESSAGE_QUEUE_H__
 
 #include <cstdint>
+#include <cstddef>
+#include <array>
+#include <algorithm>
 
 #include "message.hpp"
 #include "fifo.hpp"
 
 #include <ch.h>
 
+/* Kept with the queue in shared memory so either core can read it. */
+struct MessageQueueStatistics {
+	static constexpr size_t ids_count = static_cast<size_t>(Message::ID::MAX);
+
+	uint32_t pushes { 0 };
+	uint32_t push_failures { 0 };
+	/* Message bytes pushed, not counting record headers. */
+	uint32_t bytes { 0 };
+	/* Most bytes queued at once, counting record headers. */
+	uint32_t depth_max { 0 };
+	std::array<uint32_t, ids_count> id_pushes { };
+	std::array<uint32_t, ids_count> id_push_failures { };
+};
+
 class MessageQueue {
 public:
 	MessageQueue() = delete;
@@ -40,25 +57,58 @@ public:
 		size_t k
 	) : fifo { data, k }
 	{
-		chMtxInit(&mutex_write);
 	}
 
 	template<typename T>
 	bool push(const T& message) {
+		chSysLock();
+		const auto result = pushS(message);
+		chSysUnlock();
+		return result;
+	}
+
+	/* The consumer on the other core never locks, so only producers on this
+	 * core need to be kept apart. Call with the system locked; the copy is
+	 * at most Message::MAX_SIZE bytes.
+	 */
+	template<typename T>
+	bool pushS(const T& message) {
 		static_assert(sizeof(T) <= Message::MAX_SIZE, "Message::MAX_SIZE too small for message type");
 		static_assert(std::is_base_of<Message, T>::value, "type is not based on Message");
 
-		return push(&message, sizeof(message));
+		return pushS(&message, message_size(message));
 	}
 
-	template<typename T>
-	bool push_and_wait(const T& message) {
-		const bool result = push(message);
-		if( result ) {
-			// TODO: More graceful method of waiting for empty? Maybe sleep for a bit?
-			while( !is_empty() );
+	/* As above, for messages whose type is only known at run time. */
+	bool pushS(const Message* const message, const size_t size) {
+		const auto result = fifo.in_r(message, size);
+
+		const bool success = (result == size);
+		if( success ) {
+			signal();
 		}
-		return result;
+		update_statistics(message, size, success);
+		return success;
+	}
+
+	const MessageQueueStatistics& statistics() const {
+		return statistics_;
+	}
+
+	size_t capacity() const {
+		return fifo.capacity();
+	}
+
+	/* Where the next message will be pushed, which is just past the last
+	 * one pushed.
+	 */
+	size_t position() const {
+		return fifo.position_in();
+	}
+
+	/* True once the consumer has handled every message before position. */
+	bool is_handled(const size_t position) const {
+		return static_cast<std::ptrdiff_t>(fifo.position_out() - position) >= 0;
 	}
 
 	template<typename HandlerFn>
@@ -77,10 +127,35 @@ public:
 	void reset() {
 		fifo.reset();
 	}
+
+	/* Resizes to 2^k bytes, no more than data was given room for, and
+	 * clears the statistics. Only while neither core is using the queue.
+	 */
+	void reset(const size_t k) {
+		fifo.reset(k);
+		statistics_ = { };
+	}
 	
 private:
 	FIFO<uint8_t> fifo;
-	Mutex mutex_write { };
+	MessageQueueStatistics statistics_ { };
+
+	void update_statistics(const Message* const message, const size_t size, const bool success) {
+		const auto id = static_cast<size_t>(message->id);
+		if( success ) {
+			statistics_.pushes++;
+			statistics_.bytes += size;
+			statistics_.depth_max = std::max(statistics_.depth_max, static_cast<uint32_t>(fifo.len()));
+			if( id < statistics_.ids_count ) {
+				statistics_.id_pushes[id]++;
+			}
+		} else {
+			statistics_.push_failures++;
+			if( id < statistics_.ids_count ) {
+				statistics_.id_push_failures[id]++;
+			}
+		}
+	}
 
 	Message* peek(std::array<uint8_t, Message::MAX_SIZE>& buf) {
 		Message* const p = reinterpret_cast<Message*>(buf.data());
@@ -100,18 +175,6 @@ private:
 		return fifo.len();
 	}
 
-	bool push(const void* const buf, const size_t len) {
-		chMtxLock(&mutex_write);
-		const auto result = fifo.in_r(buf, len);
-		chMtxUnlock();
-
-		const bool success = (result == len);
-		if( success ) {
-			signal();
-		}
-		return success;
-	}
-
 	void signal();
 };
 
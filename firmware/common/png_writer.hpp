@@ -46,7 +46,7 @@ private:
 
 	File file { };
 	int scanline_count { 0 };
-	CRC<32, true, true> crc { 0x04c11db7, 0xffffffff, 0xffffffff };
+	CRCTableDriven<32, 0x04c11db7, true, true> crc { 0xffffffff, 0xffffffff };
 	Adler32 adler_32 { };
 
 	void write_chunk_header(const size_t length, const std::array<uint8_t, 4>& type);
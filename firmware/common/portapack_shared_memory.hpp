@@ -29,14 +29,23 @@
 
 /* NOTE: These structures must be located in the same location in both M4 and M0 binaries */
 struct SharedMemory {
+	/* Baseband images can ask for an application_queue of up to
+	 * 2^application_queue_k_max bytes, see baseband::run_image().
+	 */
 	static constexpr size_t application_queue_k = 11;
-	static constexpr size_t app_local_queue_k = 11;
+	static constexpr size_t application_queue_k_max = 12;
+	static constexpr size_t app_local_queue_k = 10;
+	static constexpr size_t baseband_queue_k = 11;
 
-	uint8_t application_queue_data[1 << application_queue_k] { 0 };
+	uint8_t application_queue_data[1 << application_queue_k_max] { 0 };
 	uint8_t app_local_queue_data[1 << app_local_queue_k] { 0 };
-	const Message* volatile baseband_message { nullptr };
+	uint8_t baseband_queue_data[1 << baseband_queue_k] { 0 };
 	MessageQueue application_queue { application_queue_data, application_queue_k };
 	MessageQueue app_local_queue { app_local_queue_data, app_local_queue_k };
+	MessageQueue baseband_queue { baseband_queue_data, baseband_queue_k };
+
+	/* Set by the baseband as the last thing it does before halting. */
+	volatile bool m4_halted { false };
 
 	char m4_panic_msg[32] { 0 };
 };
@@ -23,10 +23,16 @@
 #define __SIMD_H__
 
 #if defined(LPC43XX_M4)
-
 #include <hal.h>
+#elif !defined(LPC43XX_M0)
+/* Host build: portable, bit-exact versions of the M4 DSP intrinsics. */
+#include "simd_portable.hpp"
+#endif
+
+#if !defined(LPC43XX_M0)
 
 #include <cstdint>
+#include <cstddef>
 
 struct vec4_s8 {
 	union {
@@ -95,6 +101,12 @@ static inline vec2_s16 pkhtb(const vec2_s16 v1, const vec2_s16 v2, const size_t
 	return result;
 }
 
+static inline vec2_s16 ror16(const vec2_s16 v) {
+	vec2_s16 result;
+	result.w = __ROR(v.w, 16);
+	return result;
+}
+
 static inline vec2_s16 sxtb16(const vec4_s8 v, const size_t sh = 0) {
 	vec2_s16 result;
 	result.w = __SXTB16(v.w, sh);
@@ -109,6 +121,6 @@ static inline int32_t smlad(const vec2_s16 v1, const vec2_s16 v2, const int32_t
 	return __SMLAD(v1.w, v2.w, accum);
 }
 
-#endif /* defined(LPC43XX_M4) */
+#endif /* !defined(LPC43XX_M0) */
 
 #endif/*__SIMD_H__*/
@@ -0,0 +1,323 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __SIMD_PORTABLE_H__
+#define __SIMD_PORTABLE_H__
+
+/* Plain C++ implementations of the Cortex-M4 DSP/SIMD intrinsics used by the
+ * baseband code, so DSP kernels can be compiled and exercised off-target.
+ *
+ * Each function follows the instruction pseudocode in the ARMv7-M
+ * Architecture Reference Manual, so results are bit-identical to the M4.
+ * Intermediate arithmetic is done in unsigned types where the instruction
+ * wraps modulo 2^32 (or 2^64). The Q (sticky saturation) flag is not
+ * modelled.
+ *
+ * Signatures match CMSIS core_cm4_simd.h and the additions in
+ * lpc43xx_m4.h, including the rotate argument on __SXTB16().
+ */
+
+#include <cstdint>
+
+#define __SIMD32_TYPE int32_t
+#define __SIMD32(addr)  (*(__SIMD32_TYPE **) & (addr))
+#define _SIMD32_OFFSET(addr)  (*(__SIMD32_TYPE *)  (addr))
+
+namespace simd_portable {
+
+constexpr int32_t lo(const uint32_t v) {
+	return static_cast<int16_t>(v & 0xffff);
+}
+
+constexpr int32_t hi(const uint32_t v) {
+	return static_cast<int16_t>(v >> 16);
+}
+
+constexpr uint32_t pack(const uint32_t lo, const uint32_t hi) {
+	return (lo & 0xffff) | (hi << 16);
+}
+
+constexpr uint32_t ror(const uint32_t v, const uint32_t n) {
+	return (n & 31) ? ((v >> (n & 31)) | (v << (32 - (n & 31)))) : v;
+}
+
+constexpr int32_t saturate(const int64_t v, const int32_t min, const int32_t max) {
+	return (v < min) ? min : ((v > max) ? max : static_cast<int32_t>(v));
+}
+
+constexpr int32_t saturate_s16(const int32_t v) {
+	return saturate(v, -32768, 32767);
+}
+
+} /* namespace simd_portable */
+
+/* Bit manipulation ******************************************************/
+
+static inline uint32_t __REV(const uint32_t value) {
+	return (value >> 24) | ((value >> 8) & 0x0000ff00) | ((value << 8) & 0x00ff0000) | (value << 24);
+}
+
+static inline uint32_t __REV16(const uint32_t value) {
+	return ((value >> 8) & 0x00ff00ff) | ((value << 8) & 0xff00ff00);
+}
+
+static inline int32_t __REVSH(const int32_t value) {
+	return static_cast<int16_t>(__REV16(value));
+}
+
+static inline uint32_t __RBIT(uint32_t value) {
+	value = ((value >> 1) & 0x55555555) | ((value & 0x55555555) << 1);
+	value = ((value >> 2) & 0x33333333) | ((value & 0x33333333) << 2);
+	value = ((value >> 4) & 0x0f0f0f0f) | ((value & 0x0f0f0f0f) << 4);
+	return __REV(value);
+}
+
+static inline uint8_t __CLZ(const uint32_t value) {
+	return (value == 0) ? 32 : __builtin_clz(value);
+}
+
+static inline uint32_t __ROR(const uint32_t value, const uint32_t shift) {
+	return simd_portable::ror(value, shift);
+}
+
+static inline uint32_t __BFI(uint32_t rd, const uint32_t rn, const uint32_t lsb, const uint32_t width) {
+	const uint32_t mask = ((width >= 32) ? 0xffffffffU : ((1U << width) - 1)) << lsb;
+	return (rd & ~mask) | ((rn << lsb) & mask);
+}
+
+/* Packing and extension *************************************************/
+
+#define __PKHBT(ARG1,ARG2,ARG3)          ( ((((uint32_t)(ARG1))          ) & 0x0000FFFFUL) |  \
+                                           ((((uint32_t)(ARG2)) << (ARG3)) & 0xFFFF0000UL)  )
+
+#define __PKHTB(ARG1,ARG2,ARG3)          ( ((((uint32_t)(ARG1))          ) & 0xFFFF0000UL) |  \
+                                           ((((uint32_t)(ARG2)) >> (ARG3)) & 0x0000FFFFUL)  )
+
+static inline int32_t __SXTB16(const uint32_t rm, const uint32_t ror = 0) {
+	const uint32_t r = simd_portable::ror(rm, ror);
+	const uint32_t b0 = static_cast<uint32_t>(static_cast<int8_t>(r & 0xff));
+	const uint32_t b2 = static_cast<uint32_t>(static_cast<int8_t>((r >> 16) & 0xff));
+	return simd_portable::pack(b0, b2);
+}
+
+static inline int32_t __SXTH(const uint32_t rm, const uint32_t ror) {
+	return static_cast<int16_t>(simd_portable::ror(rm, ror) & 0xffff);
+}
+
+static inline int32_t __SXTAH(const uint32_t rn, const uint32_t rm, const uint32_t ror) {
+	return rn + static_cast<uint32_t>(__SXTH(rm, ror));
+}
+
+/* Saturation ************************************************************/
+
+static inline int32_t __SSAT(const int32_t value, const uint32_t sat) {
+	const int64_t max = (static_cast<int64_t>(1) << (sat - 1)) - 1;
+	return simd_portable::saturate(value, -max - 1, max);
+}
+
+static inline uint32_t __USAT(const int32_t value, const uint32_t sat) {
+	const int64_t max = (static_cast<int64_t>(1) << sat) - 1;
+	return (value < 0) ? 0 : ((value > max) ? max : value);
+}
+
+static inline int32_t __QADD(const int32_t op1, const int32_t op2) {
+	return simd_portable::saturate(static_cast<int64_t>(op1) + op2, INT32_MIN, INT32_MAX);
+}
+
+static inline int32_t __QSUB(const int32_t op1, const int32_t op2) {
+	return simd_portable::saturate(static_cast<int64_t>(op1) - op2, INT32_MIN, INT32_MAX);
+}
+
+/* Parallel 16-bit add/subtract ******************************************/
+
+static inline uint32_t __SADD16(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return pack(lo(op1) + lo(op2), hi(op1) + hi(op2));
+}
+
+static inline uint32_t __SSUB16(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return pack(lo(op1) - lo(op2), hi(op1) - hi(op2));
+}
+
+static inline uint32_t __QADD16(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return pack(saturate_s16(lo(op1) + lo(op2)), saturate_s16(hi(op1) + hi(op2)));
+}
+
+static inline uint32_t __QSUB16(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return pack(saturate_s16(lo(op1) - lo(op2)), saturate_s16(hi(op1) - hi(op2)));
+}
+
+static inline uint32_t __SHADD16(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return pack((lo(op1) + lo(op2)) >> 1, (hi(op1) + hi(op2)) >> 1);
+}
+
+static inline uint32_t __SHSUB16(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return pack((lo(op1) - lo(op2)) >> 1, (hi(op1) - hi(op2)) >> 1);
+}
+
+static inline uint32_t __SHASX(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return pack((lo(op1) - hi(op2)) >> 1, (hi(op1) + lo(op2)) >> 1);
+}
+
+static inline uint32_t __SHSAX(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return pack((lo(op1) + hi(op2)) >> 1, (hi(op1) - lo(op2)) >> 1);
+}
+
+static inline uint32_t __QASX(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return pack(saturate_s16(lo(op1) - hi(op2)), saturate_s16(hi(op1) + lo(op2)));
+}
+
+static inline uint32_t __QSAX(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return pack(saturate_s16(lo(op1) + hi(op2)), saturate_s16(hi(op1) - lo(op2)));
+}
+
+/* Halfword multiplies ***************************************************/
+
+static inline int32_t __SMULBB(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return lo(op1) * lo(op2);
+}
+
+static inline int32_t __SMULBT(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return lo(op1) * hi(op2);
+}
+
+static inline int32_t __SMULTB(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return hi(op1) * lo(op2);
+}
+
+static inline int32_t __SMULTT(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return hi(op1) * hi(op2);
+}
+
+static inline int32_t __SMLABB(const uint32_t rm, const uint32_t rs, const uint32_t rn) {
+	return rn + static_cast<uint32_t>(__SMULBB(rm, rs));
+}
+
+static inline int32_t __SMLATB(const uint32_t rm, const uint32_t rs, const uint32_t rn) {
+	return rn + static_cast<uint32_t>(__SMULTB(rm, rs));
+}
+
+static inline int32_t __SMLABT(const uint32_t rm, const uint32_t rs, const uint32_t rn) {
+	return rn + static_cast<uint32_t>(__SMULBT(rm, rs));
+}
+
+static inline int32_t __SMLATT(const uint32_t rm, const uint32_t rs, const uint32_t rn) {
+	return rn + static_cast<uint32_t>(__SMULTT(rm, rs));
+}
+
+/* Dual 16-bit multiplies, 32-bit accumulate *****************************/
+
+/* Products of two int16_t values are formed exactly, then summed modulo 2^32,
+ * matching the 32-bit result register of the instructions.
+ */
+
+static inline uint32_t __SMUAD(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return static_cast<uint32_t>(lo(op1) * lo(op2)) + static_cast<uint32_t>(hi(op1) * hi(op2));
+}
+
+static inline uint32_t __SMUADX(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return static_cast<uint32_t>(lo(op1) * hi(op2)) + static_cast<uint32_t>(hi(op1) * lo(op2));
+}
+
+static inline uint32_t __SMUSD(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return static_cast<uint32_t>(lo(op1) * lo(op2)) - static_cast<uint32_t>(hi(op1) * hi(op2));
+}
+
+static inline uint32_t __SMUSDX(const uint32_t op1, const uint32_t op2) {
+	using namespace simd_portable;
+	return static_cast<uint32_t>(lo(op1) * hi(op2)) - static_cast<uint32_t>(hi(op1) * lo(op2));
+}
+
+static inline uint32_t __SMLAD(const uint32_t op1, const uint32_t op2, const uint32_t op3) {
+	return __SMUAD(op1, op2) + op3;
+}
+
+static inline uint32_t __SMLADX(const uint32_t op1, const uint32_t op2, const uint32_t op3) {
+	return __SMUADX(op1, op2) + op3;
+}
+
+static inline uint32_t __SMLSD(const uint32_t op1, const uint32_t op2, const uint32_t op3) {
+	return __SMUSD(op1, op2) + op3;
+}
+
+static inline uint32_t __SMLSDX(const uint32_t op1, const uint32_t op2, const uint32_t op3) {
+	return __SMUSDX(op1, op2) + op3;
+}
+
+/* Dual 16-bit multiplies, 64-bit accumulate *****************************/
+
+static inline int64_t __SMLALD(const uint32_t op1, const uint32_t op2, const int64_t acc) {
+	using namespace simd_portable;
+	return static_cast<uint64_t>(acc) + static_cast<int64_t>(lo(op1) * lo(op2)) + static_cast<int64_t>(hi(op1) * hi(op2));
+}
+
+static inline int64_t __SMLALDX(const uint32_t op1, const uint32_t op2, const int64_t acc) {
+	using namespace simd_portable;
+	return static_cast<uint64_t>(acc) + static_cast<int64_t>(lo(op1) * hi(op2)) + static_cast<int64_t>(hi(op1) * lo(op2));
+}
+
+static inline int64_t __SMLSLD(const uint32_t op1, const uint32_t op2, const int64_t acc) {
+	using namespace simd_portable;
+	return static_cast<uint64_t>(acc) + static_cast<int64_t>(lo(op1) * lo(op2)) - static_cast<int64_t>(hi(op1) * hi(op2));
+}
+
+static inline int64_t __SMLSLDX(const uint32_t op1, const uint32_t op2, const int64_t acc) {
+	using namespace simd_portable;
+	return static_cast<uint64_t>(acc) + static_cast<int64_t>(lo(op1) * hi(op2)) - static_cast<int64_t>(hi(op1) * lo(op2));
+}
+
+/* 32-bit multiplies *****************************************************/
+
+static inline int64_t __SMULL(const int32_t op1, const int32_t op2) {
+	return static_cast<int64_t>(op1) * op2;
+}
+
+static inline int32_t __SMMUL(const int32_t op1, const int32_t op2) {
+	return static_cast<int32_t>((static_cast<int64_t>(op1) * op2) >> 32);
+}
+
+static inline int32_t __SMMULR(const int32_t op1, const int32_t op2) {
+	const uint64_t product = static_cast<uint64_t>(static_cast<int64_t>(op1) * op2);
+	return static_cast<int32_t>((product + 0x80000000ULL) >> 32);
+}
+
+static inline int32_t __SMMLA(const int32_t op1, const int32_t op2, const int32_t op3) {
+	const uint64_t product = static_cast<uint64_t>(static_cast<int64_t>(op1) * op2);
+	return static_cast<int32_t>(((static_cast<uint64_t>(static_cast<int64_t>(op3)) << 32) + product) >> 32);
+}
+
+#endif/*__SIMD_PORTABLE_H__*/
@@ -151,8 +151,8 @@ size_t Packet::crc_valid_length() const {
 	}
 
 	uint32_t checksum = 0;
-	CRC<8> crc_72 { 0x01, 0x00 };
-	CRC<8> crc_80 { 0x01, 0x00 };
+	CRCTableDriven<8, 0x01> crc_72 { 0x00 };
+	CRCTableDriven<8, 0x01> crc_80 { 0x00 };
 
 	for(size_t i=0; i<bytes.size(); i++) {
 		const uint32_t byte_mask = 1 << i;
@@ -134,8 +134,8 @@ private:
 
 class Packet {
 public:
-	constexpr Packet(
-		const baseband::Packet& packet,
+	Packet(
+		const baseband::PacketView& packet,
 		const SignalType signal_type
 	) : packet_ { packet },
 		signal_type_ { signal_type },
@@ -154,7 +154,7 @@ public:
 private:
 	using Reader = FieldReader<ManchesterDecoder, BitRemapNone>;
 
-	const baseband::Packet packet_;
+	const baseband::PacketView packet_;
 	const SignalType signal_type_;
 	const ManchesterDecoder decoder_;
 
@@ -25,6 +25,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <algorithm>
+#include <utility>
 
 #include "string_format.hpp"
 
@@ -552,6 +553,12 @@ void OptionsField::set_selected_index(const size_t new_index) {
 	}
 }
 
+void OptionsField::set_options(options_t new_options) {
+	options = std::move(new_options);
+	selected_index_ = 0;
+	set_dirty();
+}
+
 void OptionsField::set_by_value(value_t v) {
 	size_t new_index { 0 };
 	for(const auto& option : options) {
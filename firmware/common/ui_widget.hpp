@@ -279,6 +279,9 @@ public:
 	size_t selected_index() const;
 	void set_selected_index(const size_t new_index);
 
+	/* Selects the first of the new options without calling on_change. */
+	void set_options(options_t new_options);
+
 	void set_by_value(value_t v);
 
 	void paint(Painter& painter) override;
@@ -0,0 +1,425 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "baseband_sim.hpp"
+
+#include "message_log.hpp"
+#include "profiles.hpp"
+
+#include "event_m4.hpp"
+#include "baseband_dma.hpp"
+#include "portapack_shared_memory.hpp"
+#include "capture_index.hpp"
+
+#include <cstdio>
+#include <array>
+#include <vector>
+#include <memory>
+#include <chrono>
+
+namespace baseband_sim {
+
+namespace {
+
+/* audio::dma transfer size, in stereo samples. */
+constexpr size_t audio_transfer_samples = 32;
+
+using File = std::unique_ptr<FILE, int(*)(FILE*)>;
+
+File open_file(const std::string& path, const char* const mode) {
+	return { path.empty() ? nullptr : fopen(path.c_str(), mode), fclose };
+}
+
+class IQReader {
+public:
+	IQReader(
+		FILE* const file,
+		const SampleFormat format
+	) : file { file },
+		format { format }
+	{
+	}
+
+	/* Returns the number of whole samples read. */
+	size_t read(complex8_t* const p, const size_t count) {
+		if( format == SampleFormat::C8 ) {
+			return fread(p, sizeof(complex8_t), count, file);
+		}
+
+		/* Keep the high byte of each component, as the radio's 8-bit ADC would
+		 * have delivered.
+		 */
+		c16.resize(count);
+		const auto samples = fread(c16.data(), sizeof(complex16_t), count, file);
+		for(size_t i=0; i<samples; i++) {
+			p[i] = { static_cast<int8_t>(c16[i].real() >> 8), static_cast<int8_t>(c16[i].imag() >> 8) };
+		}
+		return samples;
+	}
+
+private:
+	FILE* const file;
+	const SampleFormat format;
+	std::vector<complex16_t> c16 { };
+};
+
+/* 16-bit mono WAV. The sampling rate is only known once all audio is in, so
+ * the header is written last.
+ */
+class WAVWriter {
+public:
+	explicit WAVWriter(
+		File&& file
+	) : file { std::move(file) }
+	{
+		if( this->file ) {
+			write_header(0);
+		}
+	}
+
+	void write(const int16_t* const p, const size_t count) {
+		if( file ) {
+			fwrite(p, sizeof(int16_t), count, file.get());
+		}
+		samples += count;
+	}
+
+	void close(const uint32_t sampling_rate) {
+		if( file ) {
+			fseek(file.get(), 0, SEEK_SET);
+			write_header(sampling_rate);
+			file.reset();
+		}
+	}
+
+	size_t count() const {
+		return samples;
+	}
+
+private:
+	File file;
+	size_t samples { 0 };
+
+	void write_header(const uint32_t sampling_rate) {
+		const uint32_t data_bytes = samples * sizeof(int16_t);
+		const uint32_t riff_bytes = 36 + data_bytes;
+		const uint32_t fmt_bytes = 16;
+		const uint16_t format_pcm = 1;
+		const uint16_t channels = 1;
+		const uint32_t bytes_per_second = sampling_rate * sizeof(int16_t);
+		const uint16_t block_align = sizeof(int16_t);
+		const uint16_t bits_per_sample = 16;
+
+		fwrite("RIFF", 4, 1, file.get());
+		fwrite(&riff_bytes, sizeof(riff_bytes), 1, file.get());
+		fwrite("WAVEfmt ", 8, 1, file.get());
+		fwrite(&fmt_bytes, sizeof(fmt_bytes), 1, file.get());
+		fwrite(&format_pcm, sizeof(format_pcm), 1, file.get());
+		fwrite(&channels, sizeof(channels), 1, file.get());
+		fwrite(&sampling_rate, sizeof(sampling_rate), 1, file.get());
+		fwrite(&bytes_per_second, sizeof(bytes_per_second), 1, file.get());
+		fwrite(&block_align, sizeof(block_align), 1, file.get());
+		fwrite(&bits_per_sample, sizeof(bits_per_sample), 1, file.get());
+		fwrite("data", 4, 1, file.get());
+		fwrite(&data_bytes, sizeof(data_bytes), 1, file.get());
+	}
+};
+
+struct State {
+	const Options* options { nullptr };
+
+	BasebandProcessor* processor { nullptr };
+	uint32_t sampling_rate { 0 };
+
+	File input { nullptr, fclose };
+	File messages { nullptr, fclose };
+	File spectrum { nullptr, fclose };
+	File capture { nullptr, fclose };
+	File capture_index { nullptr, fclose };
+	capture_index::Tracker capture_tracker { };
+	std::unique_ptr<WAVWriter> audio { };
+
+	std::array<audio::sample_t, audio_transfer_samples> audio_tx { };
+	bool audio_tx_pending { false };
+
+	ChannelSpectrumFIFO* spectrum_fifo { nullptr };
+
+	size_t blocks { 0 };
+	uint64_t samples { 0 };
+	std::chrono::steady_clock::duration execute_time { };
+	std::array<size_t, toUType(Message::ID::MAX)> message_counts { };
+	size_t spectrum_rows { 0 };
+	uint64_t capture_bytes { 0 };
+	uint64_t capture_bytes_dropped { 0 };
+};
+
+State state;
+
+void flush_audio() {
+	if( state.audio_tx_pending ) {
+		std::array<int16_t, audio_transfer_samples> mono;
+		for(size_t i=0; i<mono.size(); i++) {
+			mono[i] = state.audio_tx[i].left;
+		}
+		state.audio->write(mono.data(), mono.size());
+		state.audio_tx_pending = false;
+	}
+}
+
+double seconds() {
+	return static_cast<double>(state.samples) / state.sampling_rate;
+}
+
+void drain_application_queue(MessageLog& log) {
+	shared_memory.application_queue.handle([&log](Message* const message) {
+		state.message_counts[toUType(message->id)]++;
+
+		if( message->id == Message::ID::ChannelSpectrumConfig ) {
+			state.spectrum_fifo = static_cast<ChannelSpectrumConfigMessage*>(message)->fifo;
+		}
+
+		log.write(seconds(), message);
+	});
+
+	if( state.spectrum_fifo ) {
+		ChannelSpectrum spectrum;
+		while( state.spectrum_fifo->out(spectrum) ) {
+			fwrite(spectrum.db.data(), spectrum.db.size(), 1, state.spectrum.get());
+			state.spectrum_rows++;
+		}
+	}
+}
+
+void write_capture_index(const void* const data, const size_t size) {
+	if( state.capture_index ) {
+		fwrite(data, size, 1, state.capture_index.get());
+	}
+}
+
+void drain_capture(CaptureConfig& config) {
+	if( config.fifo_buffers_full == nullptr ) {
+		return;
+	}
+
+	const auto blocks_per_second = std::max<size_t>(state.sampling_rate / baseband::dma::transfer_samples, 1);
+	if( (state.blocks % blocks_per_second) < state.options->capture_stall_blocks ) {
+		return;
+	}
+
+	StreamBuffer* buffer = nullptr;
+	while( config.fifo_buffers_full->out(buffer) ) {
+		capture_index::Record record;
+		const auto timestamp = buffer->timestamp();
+		if( state.capture_tracker.buffer(buffer->sequence(), timestamp.tv_date, timestamp.tv_time, buffer->stream_offset(), buffer->size(), record) ) {
+			write_capture_index(&record, sizeof(record));
+		}
+		fwrite(buffer->data(), buffer->size(), 1, state.capture.get());
+		state.capture_bytes += buffer->size();
+		buffer->empty();
+		config.fifo_buffers_empty->in(buffer);
+	}
+}
+
+void print_summary() {
+	const auto execute_seconds = std::chrono::duration<double>(state.execute_time).count();
+
+	fprintf(stderr, "%s: %zu blocks, %.3f s of input at %u Hz\n",
+		state.options->processor.c_str(), state.blocks, seconds(), state.sampling_rate
+	);
+	fprintf(stderr, "execute: %.3f s, %.1fx real time, %.1f ns/sample\n",
+		execute_seconds,
+		(execute_seconds > 0) ? seconds() / execute_seconds : 0.0,
+		(state.samples > 0) ? execute_seconds * 1e9 / state.samples : 0.0
+	);
+	for(size_t i=0; i<state.message_counts.size(); i++) {
+		if( state.message_counts[i] > 0 ) {
+			fprintf(stderr, "messages: %s %zu\n", message_name(static_cast<Message::ID>(i)), state.message_counts[i]);
+		}
+	}
+	if( state.spectrum ) {
+		fprintf(stderr, "spectrum: %zu rows\n", state.spectrum_rows);
+	}
+	if( state.capture ) {
+		fprintf(stderr, "capture: %llu bytes, %llu dropped\n",
+			static_cast<unsigned long long>(state.capture_bytes),
+			static_cast<unsigned long long>(state.capture_bytes_dropped)
+		);
+	}
+}
+
+} /* namespace */
+
+void attach(BasebandProcessor* const processor, const uint32_t sampling_rate) {
+	state.processor = processor;
+	state.sampling_rate = sampling_rate;
+}
+
+void detach() {
+	state.processor = nullptr;
+}
+
+audio::buffer_t audio_tx_empty_buffer() {
+	flush_audio();
+	state.audio_tx_pending = true;
+	return { state.audio_tx.data(), state.audio_tx.size() };
+}
+
+void run_event_loop(std::function<void()> dispatch_events) {
+	const auto& options = *state.options;
+	if( !state.processor ) {
+		fprintf(stderr, "%s: no BasebandThread, nothing to run\n", options.processor.c_str());
+		return;
+	}
+
+	MessageLog log { state.messages ? state.messages.get() : stdout };
+
+	const auto send = [&dispatch_events](const Message* const message, const size_t size) {
+		shared_memory.baseband_queue.pushS(message, size);
+		EventDispatcher::events_flag(EVT_MASK_BASEBAND);
+		dispatch_events();
+	};
+
+	configure(options.processor, options.variant, send);
+
+	const size_t capture_decimation = options.capture_raw_decimation ? options.capture_raw_decimation : 8;
+	CaptureConfig capture_config {
+		4096, 8,
+		options.capture_raw_decimation ? CaptureConfig::Format::C8 :
+			(options.capture_compressed ? CaptureConfig::Format::C16Compressed : CaptureConfig::Format::C16),
+		capture_decimation,
+		static_cast<uint32_t>(state.sampling_rate / capture_decimation)
+	};
+	if( state.capture ) {
+		const CaptureConfigMessage message { &capture_config };
+		send(&message, sizeof(message));
+
+		const capture_index::Header header {
+			capture_index::magic,
+			capture_index::version,
+			sizeof(capture_index::Record),
+			capture_config.sampling_rate,
+			static_cast<uint8_t>(
+				(capture_config.format == CaptureConfig::Format::C8) ? 2 :
+				(capture_config.format == CaptureConfig::Format::C16) ? 4 : 0
+			),
+			{ 0, 0, 0 },
+		};
+		write_capture_index(&header, sizeof(header));
+	}
+
+	if( state.spectrum ) {
+		const SpectrumStreamingConfigMessage message { SpectrumStreamingConfigMessage::Mode::Running };
+		send(&message, sizeof(message));
+	}
+
+	if( options.stage_statistics ) {
+		const StageStatisticsConfigMessage message { true };
+		send(&message, sizeof(message));
+	}
+
+	drain_application_queue(log);
+
+	IQReader reader { state.input.get(), options.input_format };
+	std::vector<complex8_t> block(baseband::dma::transfer_samples);
+
+	while( (options.blocks_max == 0) || (state.blocks < options.blocks_max) ) {
+		if( reader.read(block.data(), block.size()) < block.size() ) {
+			break;
+		}
+
+		const buffer_c8_t buffer { block.data(), block.size(), state.sampling_rate };
+
+		const auto execute_start = std::chrono::steady_clock::now();
+		state.processor->execute(buffer);
+		state.execute_time += std::chrono::steady_clock::now() - execute_start;
+
+		state.samples += buffer.count;
+		state.blocks++;
+
+		dispatch_events();
+		drain_application_queue(log);
+		drain_capture(capture_config);
+	}
+
+	if( state.spectrum ) {
+		const SpectrumStreamingConfigMessage message { SpectrumStreamingConfigMessage::Mode::Stopped };
+		send(&message, sizeof(message));
+	}
+
+	if( state.capture ) {
+		state.capture_bytes_dropped = capture_config.baseband_bytes_dropped;
+		const CaptureConfigMessage message { nullptr };
+		send(&message, sizeof(message));
+
+		const auto record = state.capture_tracker.end(0, 0, capture_config.baseband_bytes_received);
+		write_capture_index(&record, sizeof(record));
+	}
+
+	drain_application_queue(log);
+}
+
+int run(const Options& options, std::function<int()> baseband_main) {
+	state.options = &options;
+
+	state.input = open_file(options.input_path, "rb");
+	if( !state.input ) {
+		fprintf(stderr, "%s: can't open input\n", options.input_path.c_str());
+		return 1;
+	}
+
+	for(auto output : {
+		std::make_pair(&options.messages_path, &state.messages),
+		std::make_pair(&options.spectrum_path, &state.spectrum),
+		std::make_pair(&options.capture_path, &state.capture),
+		std::make_pair(&options.capture_index_path, &state.capture_index),
+	}) {
+		*output.second = open_file(*output.first, "wb");
+		if( !output.first->empty() && !*output.second ) {
+			fprintf(stderr, "%s: can't create output\n", output.first->c_str());
+			return 1;
+		}
+	}
+
+	auto audio_file = open_file(options.audio_path, "wb");
+	if( !options.audio_path.empty() && !audio_file ) {
+		fprintf(stderr, "%s: can't create output\n", options.audio_path.c_str());
+		return 1;
+	}
+	state.audio = std::make_unique<WAVWriter>(std::move(audio_file));
+
+	const auto result = baseband_main();
+
+	flush_audio();
+	if( state.samples > 0 ) {
+		/* Audio rate to the nearest 100Hz, from how much the input produced. */
+		const auto rate = (state.audio->count() * state.sampling_rate / state.samples + 50) / 100 * 100;
+		state.audio->close(rate);
+		if( !options.audio_path.empty() ) {
+			fprintf(stderr, "audio: %zu samples at %llu Hz\n", state.audio->count(), static_cast<unsigned long long>(rate));
+		}
+	}
+
+	print_summary();
+
+	return result;
+}
+
+} /* namespace baseband_sim */
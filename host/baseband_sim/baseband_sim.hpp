@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BASEBAND_SIM_H__
+#define __BASEBAND_SIM_H__
+
+#include "baseband_processor.hpp"
+#include "audio_dma.hpp"
+#include "message.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <functional>
+
+/* Runs a firmware baseband processor on the host, single-threaded and as
+ * fast as the host allows. Blocks of IQ from a file take the place of SGPIO
+ * DMA, and everything the processor sends the application goes to files.
+ *
+ * The processor's own main() builds it and an EventDispatcher as on the M4.
+ * Host versions of BasebandThread and EventDispatcher::run() hand both to
+ * this simulator, which configures the processor as the application would,
+ * then alternates execute() on each block with dispatching events.
+ */
+
+namespace baseband_sim {
+
+enum class SampleFormat {
+	C8,
+	C16,
+};
+
+struct Options {
+	/* Processor this executable runs, e.g. "nfm_audio". */
+	std::string processor { };
+	/* Configuration variant (see profiles.hpp), empty for the default. */
+	std::string variant { };
+	std::string input_path { };
+	SampleFormat input_format { SampleFormat::C8 };
+	/* Messages as text, one per line. Empty for stdout. */
+	std::string messages_path { };
+	/* Audio as 16-bit mono WAV. Empty to discard. */
+	std::string audio_path { };
+	/* Channel spectrum rows of 256 dB bytes. Empty to not stream spectrum. */
+	std::string spectrum_path { };
+	/* Data the processor streams to the application: audio, or IQ for the
+	 * capture processor. Empty to not capture.
+	 */
+	std::string capture_path { };
+	/* For the capture processor, raw C8 decimated by 1, 2, 4 or 8 in place
+	 * of the filtered C16 channel. 0 for the channel. At 1 the input is
+	 * written unchanged.
+	 */
+	size_t capture_raw_decimation { 0 };
+	/* For the capture processor, the channel compressed. */
+	bool capture_compressed { false };
+	/* Capture index (see capture_index.hpp). Empty for none. */
+	std::string capture_index_path { };
+	/* Blocks of each second of input the capture isn't written for, as if
+	 * the card stalled, so the capture drops.
+	 */
+	size_t capture_stall_blocks { 0 };
+	bool stage_statistics { false };
+	/* Stop after this many blocks, 0 for the whole input. */
+	size_t blocks_max { 0 };
+};
+
+/* Runs baseband_main, the processor's main(), against options. Returns a
+ * process exit code.
+ */
+int run(const Options& options, std::function<int()> baseband_main);
+
+/* Host platform hooks for BasebandThread, EventDispatcher and audio DMA. */
+void attach(BasebandProcessor* const processor, const uint32_t sampling_rate);
+void detach();
+void run_event_loop(std::function<void()> dispatch_events);
+audio::buffer_t audio_tx_empty_buffer();
+
+} /* namespace baseband_sim */
+
+#endif/*__BASEBAND_SIM_H__*/
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "baseband_sim.hpp"
+#include "profiles.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <getopt.h>
+
+/* The processor's main(), renamed by the build. */
+int baseband_main();
+
+static void usage(const char* const program) {
+	fprintf(stderr,
+		"usage: %s [options] <input>\n"
+		"\n"
+		"Runs the %s baseband processor on IQ from <input>, as fast as possible.\n"
+		"The input is what the processor gets from the radio: at its sampling\n"
+		"rate, and for the audio processors, with the channel at +fs/4.\n"
+		"\n"
+		"  -f c8|c16      input format, interleaved int8 or int16 I/Q (c8)\n"
+		"  -v variant     configuration: %s\n"
+		"  -m file        messages as text (stdout)\n"
+		"  -a file.wav    audio\n"
+		"  -s file        channel spectrum, 256 bytes per row\n"
+		"  -c file        data streamed to the application (audio, or IQ)\n"
+		"  -r 1|2|4|8     capture raw C8, decimated by this, not the channel\n"
+		"  -z             capture the channel compressed (see iq_decompress)\n"
+		"  -i file.IDX    capture index, where the capture dropped (see iq_timeline)\n"
+		"  -d blocks      don't write the capture for this many blocks a second\n"
+		"  -t             per-stage cycle statistics in messages\n"
+		"  -n blocks      stop after this many blocks\n",
+		program,
+		BASEBAND_SIM_PROCESSOR,
+		baseband_sim::variants(BASEBAND_SIM_PROCESSOR).empty() ? "(none)" : baseband_sim::variants(BASEBAND_SIM_PROCESSOR).c_str()
+	);
+}
+
+int main(int argc, char* argv[]) {
+	baseband_sim::Options options;
+	options.processor = BASEBAND_SIM_PROCESSOR;
+
+	int opt;
+	while( (opt = getopt(argc, argv, "f:v:m:a:s:c:r:zi:d:tn:h")) != -1 ) {
+		switch(opt) {
+		case 'f':
+			if( std::string(optarg) == "c8" ) {
+				options.input_format = baseband_sim::SampleFormat::C8;
+			} else if( std::string(optarg) == "c16" ) {
+				options.input_format = baseband_sim::SampleFormat::C16;
+			} else {
+				usage(argv[0]);
+				return 1;
+			}
+			break;
+
+		case 'v': options.variant = optarg;					break;
+		case 'm': options.messages_path = optarg;			break;
+		case 'a': options.audio_path = optarg;				break;
+		case 's': options.spectrum_path = optarg;			break;
+		case 'c': options.capture_path = optarg;			break;
+		case 'r': options.capture_raw_decimation = strtoul(optarg, nullptr, 0);	break;
+		case 'z': options.capture_compressed = true;		break;
+		case 'i': options.capture_index_path = optarg;		break;
+		case 'd': options.capture_stall_blocks = strtoul(optarg, nullptr, 0);	break;
+		case 't': options.stage_statistics = true;			break;
+		case 'n': options.blocks_max = strtoul(optarg, nullptr, 0);	break;
+
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if( optind != (argc - 1) ) {
+		usage(argv[0]);
+		return 1;
+	}
+	options.input_path = argv[optind];
+
+	if( !baseband_sim::has_variant(options.processor, options.variant) ) {
+		fprintf(stderr, "%s: unknown variant \"%s\"\n", options.processor.c_str(), options.variant.c_str());
+		return 1;
+	}
+
+	return baseband_sim::run(options, baseband_main);
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "message_log.hpp"
+
+#include "ais_packet.hpp"
+#include "ert_packet.hpp"
+#include "tpms_packet.hpp"
+
+#include "utility.hpp"
+
+namespace baseband_sim {
+
+const char* message_name(const Message::ID id) {
+	switch(id) {
+	case Message::ID::RSSIStatistics:			return "RSSIStatistics";
+	case Message::ID::BasebandStatistics:		return "BasebandStatistics";
+	case Message::ID::ChannelStatistics:		return "ChannelStatistics";
+	case Message::ID::DisplayFrameSync:			return "DisplayFrameSync";
+	case Message::ID::AudioStatistics:			return "AudioStatistics";
+	case Message::ID::TPMSPacket:				return "TPMSPacket";
+	case Message::ID::Shutdown:					return "Shutdown";
+	case Message::ID::AISPacket:				return "AISPacket";
+	case Message::ID::ERTPacket:				return "ERTPacket";
+	case Message::ID::UpdateSpectrum:			return "UpdateSpectrum";
+	case Message::ID::NBFMConfigure:			return "NBFMConfigure";
+	case Message::ID::WFMConfigure:				return "WFMConfigure";
+	case Message::ID::AMConfigure:				return "AMConfigure";
+	case Message::ID::ChannelSpectrumConfig:	return "ChannelSpectrumConfig";
+	case Message::ID::SpectrumStreamingConfig:	return "SpectrumStreamingConfig";
+	case Message::ID::DisplaySleep:				return "DisplaySleep";
+	case Message::ID::CaptureConfig:			return "CaptureConfig";
+	case Message::ID::CaptureThreadDone:		return "CaptureThreadDone";
+	case Message::ID::WidebandSpectrumConfig:	return "WidebandSpectrumConfig";
+	case Message::ID::StageStatisticsConfig:	return "StageStatisticsConfig";
+	case Message::ID::StageStatistics:			return "StageStatistics";
+	case Message::ID::ReplayConfig:				return "ReplayConfig";
+	case Message::ID::ReplayThreadDone:			return "ReplayThreadDone";
+	default:									return "Unknown";
+	}
+}
+
+MessageLog::MessageLog(
+	FILE* const file
+) : file { file }
+{
+}
+
+void MessageLog::write(const double t, const Message* const message) {
+	fprintf(file, "%.6f %s", t, message_name(message->id));
+
+	switch(message->id) {
+	case Message::ID::ChannelStatistics:
+		{
+			const auto& statistics = static_cast<const ChannelStatisticsMessage*>(message)->statistics;
+			fprintf(file, " max_db=%d count=%zu", statistics.max_db, statistics.count);
+		}
+		break;
+
+	case Message::ID::AudioStatistics:
+		{
+			const auto& statistics = static_cast<const AudioStatisticsMessage*>(message)->statistics;
+			fprintf(file, " rms_db=%d max_db=%d count=%zu", statistics.rms_db, statistics.max_db, statistics.count);
+		}
+		break;
+
+	case Message::ID::AISPacket:
+		{
+			const auto& packet = static_cast<const AISPacketMessage*>(message)->packet;
+			write_packet(packet, ais::Packet { packet }.is_valid());
+		}
+		break;
+
+	case Message::ID::ERTPacket:
+		{
+			const auto ert_message = static_cast<const ERTPacketMessage*>(message);
+			fprintf(file, " type=%u", static_cast<unsigned>(toUType(ert_message->type)));
+			write_packet(ert_message->packet, ert::Packet { ert_message->type, ert_message->packet }.crc_ok());
+		}
+		break;
+
+	case Message::ID::TPMSPacket:
+		{
+			const auto tpms_message = static_cast<const TPMSPacketMessage*>(message);
+			fprintf(file, " signal_type=%u", static_cast<unsigned>(tpms_message->signal_type));
+			const tpms::Packet packet { tpms_message->packet, tpms_message->signal_type };
+			write_packet(tpms_message->packet, packet.reading().is_valid());
+		}
+		break;
+
+	case Message::ID::StageStatistics:
+		{
+			const auto& statistics = static_cast<const StageStatisticsMessage*>(message)->statistics;
+			for(size_t i=0; i<statistics.stages.size(); i++) {
+				const auto& cycles = statistics.stages[i];
+				if( cycles.count > 0 ) {
+					fprintf(file, " %zu=%u/%u/%u", i, cycles.min, cycles.avg, cycles.max);
+				}
+			}
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	fprintf(file, "\n");
+}
+
+void MessageLog::write_packet(const baseband::Packet& packet, const bool valid) {
+	fprintf(file, " bits=%zu ", packet.size());
+	for(size_t i=0; i<packet.size(); i+=4) {
+		uint32_t nibble = 0;
+		for(size_t j=0; j<4; j++) {
+			nibble = (nibble << 1) | packet[i + j];
+		}
+		fprintf(file, "%x", nibble);
+	}
+	fprintf(file, " valid=%d", valid ? 1 : 0);
+}
+
+} /* namespace baseband_sim */
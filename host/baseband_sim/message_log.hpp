@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __MESSAGE_LOG_H__
+#define __MESSAGE_LOG_H__
+
+#include "message.hpp"
+
+#include <cstdint>
+#include <cstdio>
+
+namespace baseband_sim {
+
+/* Writes messages a processor sends to the application as text, one per
+ * line: seconds into the input, message name, then fields. Packets are
+ * written as their bit count and bits in hex, first bit in the MSB, then
+ * whether the application's decoder accepts them (valid=0/1).
+ */
+class MessageLog {
+public:
+	explicit MessageLog(FILE* const file);
+
+	void write(const double t, const Message* const message);
+
+private:
+	FILE* const file;
+
+	void write_packet(const baseband::Packet& packet, const bool valid);
+};
+
+const char* message_name(const Message::ID id);
+
+} /* namespace baseband_sim */
+
+#endif/*__MESSAGE_LOG_H__*/
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Host versions of the firmware pieces that own threads, DMA and shared
+ * memory, wired to the simulator instead.
+ */
+
+#include "baseband_sim.hpp"
+
+#include "baseband_thread.hpp"
+#include "rssi_thread.hpp"
+#include "event_m4.hpp"
+#include "audio_dma.hpp"
+#include "message_queue.hpp"
+#include "portapack_shared_memory.hpp"
+
+/* On the M4, SharedMemory is at an address both cores agree on. */
+static SharedMemory shared_memory_instance;
+SharedMemory& shared_memory = shared_memory_instance;
+
+/* The simulator drains the application queue after every block. */
+void MessageQueue::signal() {
+}
+
+/* BasebandThread ********************************************************/
+
+Thread* BasebandThread::thread = nullptr;
+
+BasebandThread::BasebandThread(
+	uint32_t sampling_rate,
+	BasebandProcessor* const baseband_processor,
+	const tprio_t,
+	baseband::Direction direction
+) : baseband_processor { baseband_processor },
+	_direction { direction },
+	sampling_rate { sampling_rate }
+{
+	baseband_sim::attach(baseband_processor, sampling_rate);
+}
+
+BasebandThread::~BasebandThread() {
+	baseband_sim::detach();
+}
+
+/* The simulator calls execute() from its event loop. */
+void BasebandThread::run() {
+}
+
+/* Samples always come from the simulator's input file. */
+void BasebandThread::set_replay(ReplayConfig* const) {
+}
+
+/* RSSIThread ************************************************************/
+
+/* No RF front end, so no RSSI. */
+
+Thread* RSSIThread::thread = nullptr;
+
+RSSIThread::RSSIThread(const tprio_t) {
+}
+
+RSSIThread::~RSSIThread() {
+}
+
+void RSSIThread::run() {
+}
+
+/* EventDispatcher *******************************************************/
+
+static Thread event_loop_thread { };
+
+void EventDispatcher::run() {
+	thread_event_loop = &event_loop_thread;
+
+	baseband_sim::run_event_loop([this]() {
+		dispatch(wait());
+	});
+
+	thread_event_loop = nullptr;
+}
+
+/* Events pending since the last wait(), without blocking. */
+eventmask_t EventDispatcher::wait() {
+	const auto events = thread_event_loop->p_epending;
+	thread_event_loop->p_epending = 0;
+	return events;
+}
+
+/* audio::dma ************************************************************/
+
+namespace audio {
+namespace dma {
+
+void init() {
+}
+
+void configure() {
+}
+
+void enable() {
+}
+
+void disable() {
+}
+
+audio::buffer_t tx_empty_buffer() {
+	return baseband_sim::audio_tx_empty_buffer();
+}
+
+audio::buffer_t rx_empty_buffer() {
+	return { };
+}
+
+} /* namespace dma */
+} /* namespace audio */
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "profiles.hpp"
+
+#include "dsp_fir_taps.hpp"
+#include "dsp_iir_config.hpp"
+
+#include <array>
+
+namespace baseband_sim {
+
+namespace {
+
+struct Profile {
+	const char* const processor;
+	const char* const variant;
+	void (*configure)(const SendMessage& send);
+};
+
+/* Same messages as baseband::AMConfig, NBFMConfig, WFMConfig and
+ * WidebandSpectrumConfig in the application, with the receiver's configs.
+ */
+
+void configure_am(
+	const fir_taps_complex<64>& channel,
+	const AMConfigureMessage::Modulation modulation,
+	const SendMessage& send
+) {
+	const AMConfigureMessage message {
+		taps_6k0_decim_0,
+		taps_6k0_decim_1,
+		taps_6k0_decim_2,
+		channel,
+		modulation,
+		audio_12k_hpf_300hz_config
+	};
+	send(&message, sizeof(message));
+}
+
+void configure_nbfm(
+	const fir_taps_real<24>& decim_0,
+	const fir_taps_real<32>& decim_1,
+	const fir_taps_real<32>& channel,
+	const size_t deviation,
+	const SendMessage& send
+) {
+	const NBFMConfigureMessage message {
+		decim_0,
+		decim_1,
+		channel,
+		2,
+		deviation,
+		audio_24k_hpf_300hz_config,
+		audio_24k_deemph_300_6_config
+	};
+	send(&message, sizeof(message));
+}
+
+void configure_wfm(
+	const WFMConfigureMessage::Spectrum spectrum,
+	const SendMessage& send
+) {
+	const WFMConfigureMessage message {
+		taps_200k_wfm_decim_0,
+		taps_200k_wfm_decim_1,
+		taps_64_lp_156_198,
+		75000,
+		audio_48k_hpf_30hz_config,
+		audio_48k_deemph_2122_6_config,
+		spectrum
+	};
+	send(&message, sizeof(message));
+}
+
+const std::array<Profile, 14> profiles { {
+	{ "am_audio", "dsb", [](const SendMessage& send) {
+		configure_am(taps_6k0_dsb_channel, AMConfigureMessage::Modulation::DSB, send);
+	} },
+	{ "am_audio", "usb", [](const SendMessage& send) {
+		configure_am(taps_2k8_usb_channel, AMConfigureMessage::Modulation::SSB, send);
+	} },
+	{ "am_audio", "lsb", [](const SendMessage& send) {
+		configure_am(taps_2k8_lsb_channel, AMConfigureMessage::Modulation::SSB, send);
+	} },
+	{ "nfm_audio", "8k5", [](const SendMessage& send) {
+		configure_nbfm(taps_4k25_decim_0, taps_4k25_decim_1, taps_4k25_channel, 2500, send);
+	} },
+	{ "nfm_audio", "11k", [](const SendMessage& send) {
+		configure_nbfm(taps_11k0_decim_0, taps_11k0_decim_1, taps_11k0_channel, 2500, send);
+	} },
+	{ "nfm_audio", "16k", [](const SendMessage& send) {
+		configure_nbfm(taps_16k0_decim_0, taps_16k0_decim_1, taps_16k0_channel, 5000, send);
+	} },
+	{ "wfm_audio", "200k", [](const SendMessage& send) {
+		configure_wfm(WFMConfigureMessage::Spectrum::Channel, send);
+	} },
+	{ "wfm_audio", "mpx", [](const SendMessage& send) {
+		configure_wfm(WFMConfigureMessage::Spectrum::MPX, send);
+	} },
+	{ "wideband_spectrum", "half", [](const SendMessage& send) {
+		const WidebandSpectrumConfigMessage message {
+			WidebandSpectrumConfigMessage::Overlap::Half,
+			WidebandSpectrumConfigMessage::Averaging::Linear
+		};
+		send(&message, sizeof(message));
+	} },
+	{ "wideband_spectrum", "peak", [](const SendMessage& send) {
+		const WidebandSpectrumConfigMessage message {
+			WidebandSpectrumConfigMessage::Overlap::Half,
+			WidebandSpectrumConfigMessage::Averaging::PeakHold
+		};
+		send(&message, sizeof(message));
+	} },
+	/* Processors that need no configuration. */
+	{ "ais", "", [](const SendMessage&) { } },
+	{ "ert", "", [](const SendMessage&) { } },
+	{ "tpms", "", [](const SendMessage&) { } },
+	{ "capture", "", [](const SendMessage&) { } },
+} };
+
+const Profile* find(const std::string& processor, const std::string& variant) {
+	for(const auto& profile : profiles) {
+		if( (processor == profile.processor) && (variant.empty() || (variant == profile.variant)) ) {
+			return &profile;
+		}
+	}
+	return nullptr;
+}
+
+} /* namespace */
+
+bool configure(const std::string& processor, const std::string& variant, SendMessage send) {
+	const auto profile = find(processor, variant);
+	if( profile ) {
+		profile->configure(send);
+	}
+	return profile != nullptr;
+}
+
+bool has_variant(const std::string& processor, const std::string& variant) {
+	return find(processor, variant) != nullptr;
+}
+
+std::string variants(const std::string& processor) {
+	std::string result;
+	for(const auto& profile : profiles) {
+		if( (processor == profile.processor) && (profile.variant[0] != 0) ) {
+			if( !result.empty() ) {
+				result += " ";
+			}
+			result += profile.variant;
+		}
+	}
+	return result;
+}
+
+} /* namespace baseband_sim */
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PROFILES_H__
+#define __PROFILES_H__
+
+#include "message.hpp"
+
+#include <cstddef>
+#include <string>
+#include <functional>
+
+namespace baseband_sim {
+
+/* Takes the message and its size, as the application queues a copy. */
+using SendMessage = std::function<void(const Message* const, const size_t)>;
+
+/* Sends the configuration messages the application sends after starting
+ * processor, for the named variant ("" for the processor's default, which
+ * matches the receiver's default). Returns false for an unknown variant.
+ */
+bool configure(const std::string& processor, const std::string& variant, SendMessage send);
+
+/* True if configure() knows processor and variant. */
+bool has_variant(const std::string& processor, const std::string& variant);
+
+/* Variants of processor, space separated, default first. */
+std::string variants(const std::string& processor);
+
+} /* namespace baseband_sim */
+
+#endif/*__PROFILES_H__*/
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Host stand-in for the part of the ChibiOS/RT API that baseband processors
+ * and the headers they include use. The simulator runs everything on one
+ * thread, so locks do nothing and events are only latched for the simulated
+ * event loop to collect.
+ */
+
+#ifndef _CH_H_
+#define _CH_H_
+
+#include <cstdint>
+
+typedef int32_t msg_t;
+typedef uint32_t systime_t;
+typedef uint32_t tprio_t;
+typedef uint32_t eventmask_t;
+
+#define LOWPRIO			1
+#define NORMALPRIO		64
+#define HIGHPRIO		127
+
+#define TIME_IMMEDIATE	((systime_t)0)
+#define TIME_INFINITE	((systime_t)-1)
+
+#define ALL_EVENTS		((eventmask_t)-1)
+#define EVENT_MASK(eid)	((eventmask_t)(1 << (eid)))
+
+struct Thread {
+	eventmask_t p_epending;
+	uint32_t total_ticks;
+};
+
+struct Mutex {
+};
+
+inline void chSysLock() { }
+inline void chSysUnlock() { }
+inline void chSysLockFromIsr() { }
+inline void chSysUnlockFromIsr() { }
+
+inline void chMtxInit(Mutex*) { }
+inline void chMtxLock(Mutex*) { }
+inline Mutex* chMtxUnlock() { return nullptr; }
+
+inline void chEvtSignal(Thread* const tp, const eventmask_t mask) {
+	if( tp ) {
+		tp->p_epending |= mask;
+	}
+}
+
+inline void chEvtSignalI(Thread* const tp, const eventmask_t mask) {
+	chEvtSignal(tp, mask);
+}
+
+#endif/*_CH_H_*/
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Host stand-in for the ChibiOS HAL: Cortex-M4 intrinsics, barriers and the
+ * DWT cycle counter.
+ */
+
+#ifndef _HAL_H_
+#define _HAL_H_
+
+#include "ch.h"
+
+#include "simd_portable.hpp"
+
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+
+inline void __DMB() {
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+typedef uint32_t halrtcnt_t;
+
+/* Host time counted at the M4's 200MHz core clock, so cycle counts read as
+ * they would on an M4 as fast as the host.
+ */
+inline halrtcnt_t halGetCounterValue() {
+	const auto now = std::chrono::steady_clock::now().time_since_epoch();
+	const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+	return static_cast<halrtcnt_t>(ns / 5);
+}
+
+#endif/*_HAL_H_*/
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Host stand-in for the LPC43xx register helpers baseband code uses. There's
+ * no M0 to signal, and no saturation flag to read.
+ */
+
+#ifndef __LPC43XX_CPP_H__
+#define __LPC43XX_CPP_H__
+
+#include <cstdint>
+
+namespace lpc43xx {
+
+namespace m4 {
+
+static inline bool flag_saturation() {
+	return false;
+}
+
+static inline void clear_flag_saturation() {
+}
+
+} /* namespace m4 */
+
+namespace creg {
+namespace m4txevent {
+
+inline void assert() {
+}
+
+} /* namespace m4txevent */
+} /* namespace creg */
+
+namespace rtc {
+
+/* Only for string_format, which the packet decoders pull in. */
+struct RTC {
+	uint32_t tv_date { 0 };
+	uint32_t tv_time { 0 };
+
+	uint16_t year() const { return (tv_date >> 16) & 0xfff; }
+	uint8_t month() const { return (tv_date >> 8) & 0x00f; }
+	uint8_t day() const { return (tv_date >> 0) & 0x01f; }
+	uint8_t hour() const { return (tv_time >> 16) & 0x01f; }
+	uint8_t minute() const { return (tv_time >> 8) & 0x03f; }
+	uint8_t second() const { return (tv_time >> 0) & 0x03f; }
+};
+
+} /* namespace rtc */
+
+} /* namespace lpc43xx */
+
+#endif/*__LPC43XX_CPP_H__*/
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+/* Checks the table-driven CRCs against the bit-at-a-time CRC, for every
+ * polynomial and configuration the firmware uses, and the deferred-modulo
+ * Adler-32 against a modulo-every-byte reference.
+ */
+
+#include "crc.hpp"
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static size_t failures = 0;
+
+static void fail(const char* const what, const size_t length, const uint32_t expected, const uint32_t actual) {
+	if( failures < 10 ) {
+		fprintf(stderr, "%s: %zu bytes: expected %08x, got %08x\n",
+			what, length, expected, actual
+		);
+	}
+	failures++;
+}
+
+static void expect(const char* const what, const size_t length, const uint32_t expected, const uint32_t actual) {
+	if( actual != expected ) {
+		fail(what, length, expected, actual);
+	}
+}
+
+/* Feeds both CRCs the same data, a byte at a time and as runs of bytes, with
+ * the odd bit or bit field mixed in the way the packet decoders do.
+ */
+template<size_t Width, uint32_t TruncatedPolynomial, bool RevIn, bool RevOut>
+static void check_crc(
+	const char* const what,
+	const uint32_t initial_remainder,
+	const uint32_t final_xor_value,
+	std::mt19937& rng
+) {
+	for(size_t trial=0; trial<500; trial++) {
+		CRC<Width, RevIn, RevOut> reference { TruncatedPolynomial, initial_remainder, final_xor_value };
+		CRCTableDriven<Width, TruncatedPolynomial, RevIn, RevOut> table_driven { initial_remainder, final_xor_value };
+
+		const size_t length = rng() % 300;
+		std::vector<uint8_t> data(length);
+		for(auto& v : data) {
+			v = rng();
+		}
+
+		const bool mixed = (trial & 1);
+		size_t i = 0;
+		while( i < length ) {
+			if( mixed && ((rng() % 8) == 0) ) {
+				const size_t bit_count = 1 + (rng() % 7);
+				const uint32_t bits = rng() & ((1U << bit_count) - 1);
+				reference.process_bits(bits, bit_count);
+				table_driven.process_bits(bits, bit_count);
+			}
+
+			const size_t run = std::min<size_t>(1 + (rng() % 32), length - i);
+			if( run == 1 ) {
+				reference.process_byte(data[i]);
+				table_driven.process_byte(data[i]);
+			} else {
+				reference.process_bytes(&data[i], run);
+				table_driven.process_bytes(&data[i], run);
+			}
+			i += run;
+		}
+
+		expect(what, length, reference.checksum(), table_driven.checksum());
+	}
+}
+
+/* Adler-32 as RFC 1950 gives it, reduced every byte. */
+static uint32_t adler32_reference(const uint8_t* const data, const size_t length) {
+	uint32_t a = 1;
+	uint32_t b = 0;
+	for(size_t i=0; i<length; i++) {
+		a = (a + data[i]) % 65521;
+		b = (b + a) % 65521;
+	}
+	return (b << 16) | a;
+}
+
+static uint32_t adler32_value(const Adler32& adler) {
+	const auto bytes = adler.bytes();
+	return (bytes[0] << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+}
+
+static void check_adler32(std::mt19937& rng) {
+	for(size_t trial=0; trial<100; trial++) {
+		/* Long enough to need several reductions; all 0xff is the worst case
+		 * for overflowing the unreduced sums.
+		 */
+		const size_t length = rng() % 40000;
+		std::vector<uint8_t> data(length);
+		const bool all_ones = (trial % 4) == 0;
+		for(auto& v : data) {
+			v = all_ones ? 0xff : rng();
+		}
+
+		Adler32 adler;
+		size_t i = 0;
+		while( i < length ) {
+			const size_t run = std::min<size_t>(rng() % 12000, length - i);
+			if( run == 1 ) {
+				adler.feed(data[i]);
+			} else {
+				adler.feed(&data[i], run);
+			}
+			i += run;
+		}
+
+		expect("Adler-32", length, adler32_reference(data.data(), length), adler32_value(adler));
+	}
+}
+
+int main() {
+	/* The standard check input, to anchor the references themselves. */
+	const char check_input[] = "123456789";
+	const size_t check_length = strlen(check_input);
+
+	CRCTableDriven<32, 0x04c11db7, true, true> crc_32 { 0xffffffff, 0xffffffff };
+	crc_32.process_bytes(check_input, check_length);
+	expect("CRC-32 check value", check_length, 0xcbf43926, crc_32.checksum());
+
+	CRCTableDriven<16, 0x1021> crc_ccitt { 0xffff };
+	crc_ccitt.process_bytes(check_input, check_length);
+	expect("CRC-16/CCITT-FALSE check value", check_length, 0x29b1, crc_ccitt.checksum());
+
+	Adler32 adler;
+	adler.feed("Wikipedia", 9);
+	expect("Adler-32 check value", 9, 0x11e60398, adler32_value(adler));
+
+	std::mt19937 rng { 1 };
+
+	/* As instantiated in ais_packet, ert_packet, tpms_packet, png_writer
+	 * and cpld_max5.
+	 */
+	check_crc<16, 0x1021, false, false>("AIS FCS", 0xffff, 0xffff, rng);
+	check_crc<16, 0x6f63, false, false>("ERT BCH", 0x0000, 0x0000, rng);
+	check_crc<16, 0x1021, false, false>("ERT CRC-CCITT", 0xffff, 0x1d0f, rng);
+	check_crc<8, 0x01, false, false>("TPMS", 0x00, 0x00, rng);
+	check_crc<32, 0x04c11db7, true, true>("CRC-32", 0xffffffff, 0xffffffff, rng);
+
+	check_adler32(rng);
+
+	if( failures ) {
+		fprintf(stderr, "%zu mismatches\n", failures);
+		return 1;
+	}
+
+	printf("table-driven CRCs and Adler-32 match their references\n");
+	return 0;
+}
@@ -0,0 +1,601 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Host benchmark for baseband DSP kernels.
+ *
+ * Every kernel is fed the same pseudo-random block (from the firmware LFSR),
+ * sized like a baseband DMA buffer. The CRC-32 of the first output block is
+ * printed alongside the timing, so results can be compared bit-for-bit with
+ * the same kernel running on the M4.
+ */
+
+#include "dsp_decimate.hpp"
+#include "dsp_pipeline.hpp"
+#include "dsp_demodulate.hpp"
+#include "dsp_magnitude.hpp"
+#include "dsp_fir_taps.hpp"
+#include "dsp_fft.hpp"
+#include "dsp_iir.hpp"
+#include "dsp_iir_config.hpp"
+#include "dsp_spectrum.hpp"
+#include "matched_filter.hpp"
+#include "ais_baseband.hpp"
+
+#include "firc_legacy.hpp"
+#include "matched_filter_legacy.hpp"
+
+#include "lfsr_random.hpp"
+#include "crc.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+constexpr size_t block_samples = 2048;
+
+constexpr uint32_t baseband_fs = 3072000;
+
+struct Stimulus {
+	std::array<complex8_t, block_samples> c8 { };
+	std::array<complex16_t, block_samples> c16 { };
+	std::array<int16_t, block_samples> s16 { };
+
+	std::array<complex16_t, block_samples> dst_c16 { };
+	std::array<int16_t, block_samples> dst_s16 { };
+
+	Stimulus() {
+		std::array<lfsr_word_t, block_samples> words;
+		lfsr_word_t v = 1;
+		lfsr_fill(v, words.data(), words.size());
+
+		for(size_t i=0; i<block_samples; i++) {
+			const auto w = words[i];
+			c8[i] = { static_cast<int8_t>(w >> 0), static_cast<int8_t>(w >> 8) };
+			/* Keep 16-bit stimulus at 12 bits, roughly the level a decimator
+			 * feeds the next stage, so accumulators behave as they do in use.
+			 */
+			c16[i] = { static_cast<int16_t>(static_cast<int16_t>(w >> 0) >> 4), static_cast<int16_t>(static_cast<int16_t>(w >> 16) >> 4) };
+			s16[i] = static_cast<int16_t>(w >> 8) >> 4;
+		}
+	}
+
+	buffer_c8_t src_c8() { return { c8.data(), c8.size(), baseband_fs }; }
+	buffer_c16_t src_c16() { return { c16.data(), c16.size(), baseband_fs }; }
+	buffer_s16_t src_s16() { return { s16.data(), s16.size(), baseband_fs }; }
+	buffer_c16_t out_c16() { return { dst_c16.data(), dst_c16.size() }; }
+	buffer_s16_t out_s16() { return { dst_s16.data(), dst_s16.size() }; }
+};
+
+class Benchmark {
+public:
+	explicit Benchmark(
+		const size_t blocks
+	) : blocks { blocks }
+	{
+		std::printf("%-40s %6s %10s %12s %10s\n", "kernel", "in/blk", "ns/sample", "Msamples/s", "crc32");
+	}
+
+	template<typename Fn>
+	void run(const char* const name, const size_t samples_per_block, Fn fn) {
+		CRC<32, true, true> crc { 0x04c11db7, 0xffffffff, 0xffffffff };
+		const auto first = fn();
+		crc.process_bytes(first.p, first.count * sizeof(*first.p));
+
+		const auto start = clock_t::now();
+		for(size_t i=1; i<blocks; i++) {
+			fn();
+		}
+		const auto end = clock_t::now();
+
+		const std::chrono::duration<double, std::nano> elapsed = end - start;
+		const double samples = static_cast<double>(samples_per_block) * (blocks - 1);
+		const double ns_per_sample = elapsed.count() / samples;
+		std::printf("%-40s %6zu %10.3f %12.2f   %08x\n",
+			name, samples_per_block, ns_per_sample, 1000.0 / ns_per_sample, crc.checksum()
+		);
+	}
+
+private:
+	using clock_t = std::chrono::steady_clock;
+
+	const size_t blocks;
+};
+
+void benchmark_decimate(Benchmark& benchmark, Stimulus& s) {
+	using namespace dsp::decimate;
+
+	{
+		Complex8DecimateBy2CIC3 k;
+		benchmark.run("Complex8DecimateBy2CIC3", block_samples, [&]() { return k.execute(s.src_c8(), s.out_c16()); });
+	}
+	{
+		TranslateByFSOver4AndDecimateBy2CIC3 k;
+		benchmark.run("TranslateByFSOver4AndDecimateBy2CIC3", block_samples, [&]() { return k.execute(s.src_c8(), s.out_c16()); });
+	}
+	{
+		DecimateBy2CIC3 k;
+		benchmark.run("DecimateBy2CIC3", block_samples, [&]() { return k.execute(s.src_c16(), s.out_c16()); });
+	}
+	{
+		FIRC8xR16x24FS4Decim4 k;
+		k.configure(taps_200k_wfm_decim_0.taps, 33554432);
+		benchmark.run("FIRC8xR16x24FS4Decim4", block_samples, [&]() { return k.execute(s.src_c8(), s.out_c16()); });
+	}
+	{
+		FIRC8xR16x24FS4Decim8 k;
+		k.configure(taps_16k0_decim_0.taps, 33554432);
+		benchmark.run("FIRC8xR16x24FS4Decim8", block_samples, [&]() { return k.execute(s.src_c8(), s.out_c16()); });
+	}
+	{
+		FIRC16xR16x16Decim2 k;
+		k.configure(taps_200k_wfm_decim_1.taps, 131072);
+		benchmark.run("FIRC16xR16x16Decim2", block_samples, [&]() { return k.execute(s.src_c16(), s.out_c16()); });
+	}
+	{
+		FIRC16xR16x32Decim8 k;
+		k.configure(taps_16k0_decim_1.taps, 131072);
+		benchmark.run("FIRC16xR16x32Decim8", block_samples, [&]() { return k.execute(s.src_c16(), s.out_c16()); });
+	}
+	{
+		FIRAndDecimateComplex k;
+		k.configure(taps_16k0_channel.taps, 1);
+		benchmark.run("FIRAndDecimateComplex (32 taps, /1)", block_samples, [&]() { return k.execute(s.src_c16(), s.out_c16()); });
+	}
+	{
+		FIRAndDecimateComplex k;
+		k.configure(taps_6k0_dsb_channel.taps, 1);
+		benchmark.run("FIRAndDecimateComplex (64 taps, /1)", block_samples, [&]() { return k.execute(s.src_c16(), s.out_c16()); });
+	}
+	{
+		/* Odd block length: decimation phase carries across blocks. */
+		FIRAndDecimateComplex k;
+		k.configure(taps_6k0_decim_2.taps, 4);
+		benchmark.run("FIRAndDecimateComplex (32 taps, /4)", block_samples - 1, [&]() { return k.execute({ s.c16.data(), block_samples - 1, baseband_fs }, s.out_c16()); });
+	}
+	{
+		FIR64AndDecimateBy2Real k;
+		k.configure(taps_64_lp_156_198.taps);
+		benchmark.run("FIR64AndDecimateBy2Real", block_samples, [&]() { return k.execute(s.src_s16(), s.out_s16()); });
+	}
+	{
+		DecimateBy2CIC4Real k;
+		benchmark.run("DecimateBy2CIC4Real", block_samples, [&]() { return k.execute(s.src_s16(), s.out_s16()); });
+	}
+	{
+		/* NBFM front end, wired by hand and as a dsp::pipeline::Chain.
+		 * crc32 should match.
+		 */
+		FIRC8xR16x24FS4Decim8 decim_0;
+		FIRC16xR16x32Decim8 decim_1;
+		FIRAndDecimateComplex channel_filter;
+		decim_0.configure(taps_11k0_decim_0.taps, 33554432);
+		decim_1.configure(taps_11k0_decim_1.taps, 131072);
+		channel_filter.configure(taps_11k0_channel.taps, 2);
+		benchmark.run("NBFM decimators (by hand)", block_samples, [&]() {
+			const auto decim_0_out = decim_0.execute(s.src_c8(), s.out_c16());
+			const auto decim_1_out = decim_1.execute(decim_0_out, s.out_c16());
+			return channel_filter.execute(decim_1_out, s.out_c16());
+		});
+
+		dsp::pipeline::Chain<
+			complex8_t, complex16_t, baseband_fs, block_samples,
+			FIRC8xR16x24FS4Decim8,
+			FIRC16xR16x32Decim8,
+			FIRAndDecimateComplex
+		> chain;
+		chain.stage<0>().configure(taps_11k0_decim_0.taps, 33554432);
+		chain.stage<1>().configure(taps_11k0_decim_1.taps, 131072);
+		chain.stage<2>().configure(taps_11k0_channel.taps, 2);
+		benchmark.run("NBFM decimators (pipeline::Chain)", block_samples, [&]() { return chain.execute(s.src_c8()); });
+	}
+}
+
+template<typename T, size_t N>
+buffer_t<T> fft_input(Stimulus& s, std::array<T, N>& dst) {
+	/* Stimulus block repeats for N > block_samples. */
+	for(size_t i=0; i<N; i++) {
+		const auto v = s.c16[i % block_samples];
+		dst[i] = { static_cast<typename T::value_type>(v.real()), static_cast<typename T::value_type>(v.imag()) };
+	}
+	return { dst.data(), dst.size() };
+}
+
+template<size_t N>
+void benchmark_fft_q15(Benchmark& benchmark, Stimulus& s, const char* const name) {
+	static std::array<complex16_t, N> data;
+	benchmark.run(name, N, [&]() { fft_input(s, data); fft_c_q15(data); return buffer_c16_t { data.data(), data.size() }; });
+}
+
+template<size_t N>
+void benchmark_fft_q31(Benchmark& benchmark, Stimulus& s, const char* const name) {
+	static std::array<complex32_t, N> data;
+	benchmark.run(name, N, [&]() { fft_input(s, data); fft_c_q31(data); return buffer_t<complex32_t> { data.data(), data.size() }; });
+}
+
+void benchmark_fft(Benchmark& benchmark, Stimulus& s) {
+	/* Input copy/conversion is included in timing. */
+	{
+		static std::array<std::complex<float>, 256> data;
+		benchmark.run("fft_c_preswapped (float, 256)", 256, [&]() { fft_swap(s.src_c16(), data); fft_c_preswapped(data); return buffer_t<std::complex<float>> { data.data(), data.size() }; });
+	}
+	benchmark_fft_q15<64>(benchmark, s, "fft_c_q15 (64)");
+	benchmark_fft_q15<256>(benchmark, s, "fft_c_q15 (256)");
+	benchmark_fft_q15<512>(benchmark, s, "fft_c_q15 (512)");
+	benchmark_fft_q15<1024>(benchmark, s, "fft_c_q15 (1024)");
+	benchmark_fft_q15<4096>(benchmark, s, "fft_c_q15 (4096)");
+	{
+		static std::array<complex16_t, 128> data;
+		benchmark.run("fft_r_q15 (256 real)", 256, [&]() { fft_swap_real(s.src_s16(), data); fft_r_q15_preswapped(data); return buffer_c16_t { data.data(), data.size() }; });
+	}
+	benchmark_fft_q31<256>(benchmark, s, "fft_c_q31 (256)");
+	benchmark_fft_q31<4096>(benchmark, s, "fft_c_q31 (4096)");
+}
+
+void benchmark_spectrum(Benchmark& benchmark, Stimulus& s) {
+	using namespace dsp::spectrum;
+
+	static frame_t frame;
+	static power_t power;
+	{
+		benchmark.run("wola_presum (1024 -> 256)", window_length, [&]() { wola_presum(s.c8.data(), frame); return buffer_c16_t { frame.data(), frame.size() }; });
+	}
+	{
+		/* One WidebandSpectrum frame: presum, FFT, linear average. */
+		benchmark.run("wola_presum + fft_c_q15 + power", window_length, [&]() {
+			wola_presum(s.c8.data(), frame);
+			fft_c_q15_preswapped(frame);
+			power_accumulate(frame, power);
+			return buffer_c16_t { frame.data(), frame.size() };
+		});
+	}
+}
+
+struct FMStimulus {
+	std::array<complex16_t, block_samples> c16 { };
+	std::array<float, block_samples> ideal { };
+	std::array<float, block_samples> dst_f32 { };
+	std::array<int16_t, block_samples> dst_s16 { };
+
+	const char* const name;
+	const float sampling_rate;
+	const float deviation_hz;
+
+	FMStimulus(
+		const char* const name,
+		const float sampling_rate,
+		const float deviation_hz
+	) : name { name },
+		sampling_rate { sampling_rate },
+		deviation_hz { deviation_hz }
+	{
+		/* Tone completes a whole number of cycles per block, so phase is
+		 * continuous when the block repeats. 12-bit amplitude, as FM
+		 * baseband processors see after decimation.
+		 */
+		constexpr size_t tone_cycles = 85;
+		const double pi2 = 2.0 * pi;
+		const double dtheta_max = pi2 * deviation_hz / sampling_rate;
+		for(size_t i=0; i<block_samples; i++) {
+			const double theta = -dtheta_max / (pi2 * tone_cycles / block_samples) * std::cos(pi2 * tone_cycles * i / block_samples);
+			c16[i] = { static_cast<int16_t>(std::lround(2047.0 * std::cos(theta))), static_cast<int16_t>(std::lround(2047.0 * std::sin(theta))) };
+		}
+		/* Reference is the exact phase difference of the quantized samples. */
+		for(size_t i=0; i<block_samples; i++) {
+			const std::complex<double> s0 { double(c16[i].real()), double(c16[i].imag()) };
+			const auto z = c16[(i + block_samples - 1) % block_samples];
+			const std::complex<double> s1 { double(z.real()), double(z.imag()) };
+			ideal[i] = std::arg(s0 * std::conj(s1)) / dtheta_max;
+		}
+	}
+
+	buffer_c16_t src() { return { c16.data(), c16.size(), static_cast<uint32_t>(sampling_rate) }; }
+	buffer_f32_t out_f32() { return { dst_f32.data(), dst_f32.size() }; }
+	buffer_s16_t out_s16() { return { dst_s16.data(), dst_s16.size() }; }
+
+	template<typename T>
+	float snr_db(const buffer_t<T>& out, const float scale) const {
+		double signal = 0;
+		double noise = 0;
+		for(size_t i=0; i<out.count; i++) {
+			const double error = out.p[i] * scale - ideal[i];
+			signal += ideal[i] * ideal[i];
+			noise += error * error;
+		}
+		return 10.0 * std::log10(signal / noise);
+	}
+};
+
+template<typename Fn>
+buffer_t<uint32_t> magnitude_c16(Stimulus& s, std::array<uint32_t, block_samples>& dst, Fn fn) {
+	for(size_t i=0; i<block_samples; i++) {
+		dst[i] = fn(*reinterpret_cast<const uint32_t*>(&s.c16[i]));
+	}
+	return { dst.data(), dst.size() };
+}
+
+void benchmark_magnitude(Benchmark& benchmark, Stimulus& s) {
+	using namespace dsp::magnitude;
+
+	static std::array<uint32_t, block_samples> mag;
+	static std::array<float, block_samples> audio;
+	{
+		dsp::demodulate::AM k;
+		benchmark.run("AM", block_samples, [&]() { return k.execute(s.src_c16(), { audio.data(), audio.size() }); });
+	}
+	benchmark.run("sqrtf (c16)", block_samples, [&]() {
+		return magnitude_c16(s, mag, [](const uint32_t iq) { return static_cast<uint32_t>(std::sqrt(static_cast<float>(__SMUAD(iq, iq))) + 0.5f); });
+	});
+	benchmark.run("alpha_max_beta_min (c16)", block_samples, [&]() { return magnitude_c16(s, mag, alpha_max_beta_min); });
+	benchmark.run("newton_sqrt (c16)", block_samples, [&]() { return magnitude_c16(s, mag, newton_sqrt); });
+	benchmark.run("log2_q8 (c16)", block_samples, [&]() { return magnitude_c16(s, mag, log2_q8); });
+	benchmark.run("alpha_max_beta_min (c8 pairs)", block_samples, [&]() {
+		const auto src = reinterpret_cast<const uint32_t*>(s.c8.data());
+		for(size_t i=0; i<block_samples/2; i++) {
+			uint32_t iq0, iq1;
+			unpack_c8_pair(src[i], iq0, iq1);
+			mag[i*2+0] = alpha_max_beta_min(iq0);
+			mag[i*2+1] = alpha_max_beta_min(iq1);
+		}
+		return buffer_t<uint32_t> { mag.data(), mag.size() };
+	});
+
+	/* Error over the c16 stimulus, excluding |s| < 64 where integer
+	 * truncation dominates.
+	 */
+	double amb_min = 0, amb_max = 0, newton_min = 0, newton_max = 0, log_max = 0;
+	for(const auto& v : s.c16) {
+		const uint32_t iq = *reinterpret_cast<const uint32_t*>(&v);
+		const double m = std::sqrt(double(v.real()) * v.real() + double(v.imag()) * v.imag());
+		if( m < 64 ) {
+			continue;
+		}
+		const double amb = alpha_max_beta_min(iq) / m - 1.0;
+		const double newton = newton_sqrt(iq) / m - 1.0;
+		const double log = std::abs(log2_q8(iq) - 256.0 * std::log2(m));
+		amb_min = std::min(amb_min, amb);
+		amb_max = std::max(amb_max, amb);
+		newton_min = std::min(newton_min, newton);
+		newton_max = std::max(newton_max, newton);
+		log_max = std::max(log_max, log);
+	}
+	std::printf("\nmagnitude error: alpha_max_beta_min %+.2f%%/%+.2f%%, newton_sqrt %+.3f%%/%+.3f%%, log2_q8 %.2f LSB\n\n",
+		amb_min * 100, amb_max * 100, newton_min * 100, newton_max * 100, log_max
+	);
+}
+
+void benchmark_iir(Benchmark& benchmark, Stimulus& s) {
+	/* AudioOutput at 48kHz: squelch's non-audio HPF, 30Hz HPF, de-emphasis. */
+	static std::array<float, block_samples> audio_f;
+	static std::array<float, block_samples> squelch_f;
+
+	IIRBiquadFilter squelch_hpf { non_audio_hpf_config };
+	IIRBiquadFilter hpf { audio_48k_hpf_30hz_config };
+	IIRBiquadFilter deemph { audio_48k_deemph_300_6_config };
+	const auto run_float = [&]() {
+		for(size_t i=0; i<block_samples; i++) {
+			audio_f[i] = s.s16[i] * (1.0f / 32768.0f);
+		}
+		const buffer_f32_t audio { audio_f.data(), audio_f.size() };
+		squelch_hpf.execute(audio, { squelch_f.data(), squelch_f.size() });
+		hpf.execute_in_place(audio);
+		deemph.execute_in_place(audio);
+		return audio;
+	};
+
+	IIRBiquadCascade<1> squelch_cascade { { { non_audio_hpf_config } } };
+	IIRBiquadCascade<2> audio_cascade { { { audio_48k_hpf_30hz_config, audio_48k_deemph_300_6_config } } };
+	int32_t squelch_max = 0;
+	const auto run_fixed = [&]() {
+		for(size_t i=0; i<block_samples; i++) {
+			const int32_t sample = s.s16[i];
+			squelch_max = std::max(squelch_max, std::abs(squelch_cascade.execute(sample)));
+			s.dst_s16[i] = __SSAT(audio_cascade.execute(sample), 16);
+		}
+		return s.out_s16();
+	};
+
+	benchmark.run("IIRBiquadFilter x3 (float, 3 passes)", block_samples, run_float);
+	benchmark.run("IIRBiquadCascade<2> + <1> (Q15, fused)", block_samples, run_fixed);
+
+	/* Filters have run the same blocks, so states match. */
+	const auto reference = run_float();
+	const auto fixed = run_fixed();
+	double signal = 0;
+	double noise = 0;
+	for(size_t i=0; i<block_samples; i++) {
+		const double r = reference.p[i] * 32768.0;
+		const double e = fixed.p[i] - r;
+		signal += r * r;
+		noise += e * e;
+	}
+	std::printf("\nIIRBiquadCascade vs float SNR: %.1f dB\n\n", 10.0 * std::log10(signal / noise));
+}
+
+template<typename Filter, typename Input>
+buffer_f32_t run_matched_filter(Filter& filter, Stimulus& s, std::array<float, block_samples>& dst) {
+	size_t count = 0;
+	for(size_t i=0; i<block_samples; i++) {
+		if( filter.execute_once(static_cast<Input>(s.c16[i])) ) {
+			dst[count++] = filter.get_output();
+		}
+	}
+	return { dst.data(), count };
+}
+
+template<typename T>
+void benchmark_matched_filter_taps(Benchmark& benchmark, Stimulus& s, const char* const name, const T& taps, const size_t decimation_factor) {
+	static std::array<float, block_samples> out;
+	static std::array<float, block_samples> out_legacy;
+	char label[64];
+
+	dsp::matched_filter::MatchedFilter mf { taps, decimation_factor };
+	std::snprintf(label, sizeof(label), "MatchedFilter (%s)", name);
+	benchmark.run(label, block_samples, [&]() { return run_matched_filter<decltype(mf), complex16_t>(mf, s, out); });
+
+	legacy::MatchedFilter mf_legacy { taps, decimation_factor };
+	std::snprintf(label, sizeof(label), "legacy::MatchedFilter (%s)", name);
+	benchmark.run(label, block_samples, [&]() { return run_matched_filter<decltype(mf_legacy), std::complex<float>>(mf_legacy, s, out_legacy); });
+
+	/* Both have seen the same blocks. Compare the sign the slicer uses. */
+	const auto a = run_matched_filter<decltype(mf), complex16_t>(mf, s, out);
+	const auto b = run_matched_filter<decltype(mf_legacy), std::complex<float>>(mf_legacy, s, out_legacy);
+	size_t agree = 0;
+	for(size_t i=0; i<a.count; i++) {
+		agree += ((a.p[i] >= 0.0f) == (b.p[i] >= 0.0f)) ? 1 : 0;
+	}
+	std::printf("%-40s sign agreement %zu/%zu\n", "", agree, a.count);
+}
+
+void benchmark_matched_filter(Benchmark& benchmark, Stimulus& s) {
+	benchmark_matched_filter_taps(benchmark, s, "AIS, 4 taps, /2", baseband::ais::square_taps_38k4_1t_p, 2);
+
+	/* As TPMS's rect_taps_307k2_38k4_1t_19k2_p: two cycles over 16 taps. */
+	std::array<std::complex<float>, 16> tpms_taps;
+	for(size_t n=0; n<tpms_taps.size(); n++) {
+		tpms_taps[n] = std::polar(0.0625f, static_cast<float>(2.0 * pi * 2 * n / tpms_taps.size()));
+	}
+	benchmark_matched_filter_taps(benchmark, s, "TPMS, 16 taps, /8", tpms_taps, 8);
+}
+
+void benchmark_fm(Benchmark& benchmark) {
+	using Discriminator = dsp::demodulate::FM::Discriminator;
+
+	struct Engine {
+		Discriminator discriminator;
+		const char* const name;
+	};
+	const std::array<Engine, 4> engines { {
+		{ Discriminator::Precise, "precise" },
+		{ Discriminator::Polynomial, "polynomial" },
+		{ Discriminator::FixedPoint, "fixedpoint" },
+		{ Discriminator::Quadricorrelator, "quadricorrelator" },
+	} };
+
+	/* "narrow" is within the quadricorrelator's range, the others fall
+	 * back to polynomial.
+	 */
+	std::array<FMStimulus, 3> stimuli { {
+		{ "nbfm", 24000, 5000 },
+		{ "wfm", 768000 / 2, 75000 },
+		{ "narrow", 192000, 5000 },
+	} };
+
+	std::array<std::array<std::array<float, 2>, engines.size()>, stimuli.size()> snr;
+
+	for(size_t j=0; j<stimuli.size(); j++) {
+		auto& s = stimuli[j];
+		for(size_t i=0; i<engines.size(); i++) {
+			const auto& engine = engines[i];
+			char name[64];
+
+			dsp::demodulate::FM demod;
+			demod.configure(s.sampling_rate, s.deviation_hz);
+			demod.set_discriminator(engine.discriminator);
+
+			/* First block primes the previous sample and block power. */
+			demod.execute(s.src(), s.out_f32());
+			snr[j][i][0] = s.snr_db(demod.execute(s.src(), s.out_f32()), 1.0f);
+			std::snprintf(name, sizeof(name), "FM %s (%s, f32)", engine.name, s.name);
+			benchmark.run(name, block_samples, [&]() { return demod.execute(s.src(), s.out_f32()); });
+
+			demod.execute(s.src(), s.out_s16());
+			snr[j][i][1] = s.snr_db(demod.execute(s.src(), s.out_s16()), 1.0f / 32767.0f);
+			std::snprintf(name, sizeof(name), "FM %s (%s, s16)", engine.name, s.name);
+			benchmark.run(name, block_samples, [&]() { return demod.execute(s.src(), s.out_s16()); });
+		}
+	}
+
+	/* Error against the exact phase difference, relative to full deviation. */
+	std::printf("\n%-40s", "FM discriminator SNR (dB)");
+	for(const auto& s : stimuli) {
+		std::printf(" %6s/f32 %6s/s16", s.name, s.name);
+	}
+	std::printf("\n");
+	for(size_t i=0; i<engines.size(); i++) {
+		std::printf("%-40s", engines[i].name);
+		for(size_t j=0; j<stimuli.size(); j++) {
+			std::printf(" %10.1f %10.1f", snr[j][i][0], snr[j][i][1]);
+		}
+		std::printf("\n");
+	}
+	std::printf("\n");
+}
+
+void benchmark_firc_legacy(Benchmark& benchmark, Stimulus& s) {
+	/* Same configurations as above, through the previous hand-unrolled code.
+	 * ns/sample and crc32 should match the template instantiations.
+	 */
+	{
+		legacy::FIRC8xR16x24FS4Decim4 k;
+		k.configure(taps_200k_wfm_decim_0.taps, 33554432);
+		benchmark.run("legacy::FIRC8xR16x24FS4Decim4", block_samples, [&]() { return k.execute(s.src_c8(), s.out_c16()); });
+	}
+	{
+		legacy::FIRC8xR16x24FS4Decim8 k;
+		k.configure(taps_16k0_decim_0.taps, 33554432);
+		benchmark.run("legacy::FIRC8xR16x24FS4Decim8", block_samples, [&]() { return k.execute(s.src_c8(), s.out_c16()); });
+	}
+	{
+		legacy::FIRC16xR16x16Decim2 k;
+		k.configure(taps_200k_wfm_decim_1.taps, 131072);
+		benchmark.run("legacy::FIRC16xR16x16Decim2", block_samples, [&]() { return k.execute(s.src_c16(), s.out_c16()); });
+	}
+	{
+		legacy::FIRC16xR16x32Decim8 k;
+		k.configure(taps_16k0_decim_1.taps, 131072);
+		benchmark.run("legacy::FIRC16xR16x32Decim8", block_samples, [&]() { return k.execute(s.src_c16(), s.out_c16()); });
+	}
+}
+
+} /* namespace */
+
+int main(int argc, char* argv[]) {
+	size_t blocks = 20000;
+	if( argc > 1 ) {
+		blocks = std::strtoul(argv[1], nullptr, 0);
+	}
+	if( blocks < 2 ) {
+		std::fprintf(stderr, "usage: %s [blocks]\n", argv[0]);
+		return 1;
+	}
+
+	Stimulus stimulus;
+	Benchmark benchmark { blocks };
+
+	benchmark_decimate(benchmark, stimulus);
+	benchmark_fft(benchmark, stimulus);
+	benchmark_spectrum(benchmark, stimulus);
+	benchmark_fm(benchmark);
+	benchmark_magnitude(benchmark, stimulus);
+	benchmark_iir(benchmark, stimulus);
+	benchmark_matched_filter(benchmark, stimulus);
+	benchmark_firc_legacy(benchmark, stimulus);
+
+	return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __FIRC_LEGACY_H__
+#define __FIRC_LEGACY_H__
+
+/* Hand-unrolled FIRC* decimators as they were before being replaced by
+ * dsp::decimate::FIRCxR16Decim. Kept only as the benchmark reference, to
+ * show the template produces identical output at no extra cost.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+#include "dsp_types.hpp"
+
+#include "simd.hpp"
+
+namespace legacy {
+
+class FIRC8xR16x24FS4Decim4 {
+public:
+	static constexpr size_t taps_count = 24;
+	static constexpr size_t decimation_factor = 4;
+
+	using sample_t = complex8_t;
+	using tap_t = int16_t;
+
+	enum class Shift : bool {
+		Down = true,
+		Up = false
+	};
+
+	void configure(
+		const std::array<tap_t, taps_count>& taps,
+		const int32_t scale,
+		const Shift shift = Shift::Down
+	);
+
+	buffer_c16_t execute(
+		const buffer_c8_t& src,
+		const buffer_c16_t& dst
+	);
+	
+private:
+	std::array<vec2_s16, taps_count - decimation_factor> z_ { };
+	std::array<tap_t, taps_count> taps_ { };
+	int32_t output_scale = 0;
+};
+
+class FIRC8xR16x24FS4Decim8 {
+public:
+	static constexpr size_t taps_count = 24;
+	static constexpr size_t decimation_factor = 8;
+
+	using sample_t = complex8_t;
+	using tap_t = int16_t;
+
+	enum class Shift : bool {
+		Down = true,
+		Up = false
+	};
+
+	void configure(
+		const std::array<tap_t, taps_count>& taps,
+		const int32_t scale,
+		const Shift shift = Shift::Down
+	);
+
+	buffer_c16_t execute(
+		const buffer_c8_t& src,
+		const buffer_c16_t& dst
+	);
+	
+private:
+	std::array<vec2_s16, taps_count - decimation_factor> z_ { };
+	std::array<tap_t, taps_count> taps_ { };
+	int32_t output_scale = 0;
+};
+
+class FIRC16xR16x16Decim2 {
+public:
+	static constexpr size_t taps_count = 16;
+	static constexpr size_t decimation_factor = 2;
+
+	using sample_t = complex16_t;
+	using tap_t = int16_t;
+
+	void configure(
+		const std::array<tap_t, taps_count>& taps,
+		const int32_t scale
+	);
+
+	buffer_c16_t execute(
+		const buffer_c16_t& src,
+		const buffer_c16_t& dst
+	);
+	
+private:
+	std::array<vec2_s16, taps_count - decimation_factor> z_ { };
+	std::array<tap_t, taps_count> taps_ { };
+	int32_t output_scale = 0;
+};
+
+class FIRC16xR16x32Decim8 {
+public:
+	static constexpr size_t taps_count = 32;
+	static constexpr size_t decimation_factor = 8;
+
+	using sample_t = complex16_t;
+	using tap_t = int16_t;
+
+	void configure(
+		const std::array<tap_t, taps_count>& taps,
+		const int32_t scale
+	);
+
+	buffer_c16_t execute(
+		const buffer_c16_t& src,
+		const buffer_c16_t& dst
+	);
+	
+private:
+	std::array<vec2_s16, taps_count - decimation_factor> z_ { };
+	std::array<tap_t, taps_count> taps_ { };
+	int32_t output_scale = 0;
+};
+
+} /* namespace legacy */
+
+#endif/*__FIRC_LEGACY_H__*/
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+/* Checks the packed FieldReader and ManchesterDecoder reads against the
+ * bit-at-a-time reads they replaced, over random packets and every field
+ * position, including fields running past the end of the packet.
+ */
+
+#include "baseband_packet.hpp"
+#include "field_reader.hpp"
+#include "manchester.hpp"
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <random>
+
+/* The bit-at-a-time FieldReader::read(). */
+template<typename BitRemap>
+static uint64_t read_bitwise(const baseband::PacketView& packet, const size_t start_bit, const size_t length) {
+	const BitRemap bit_remap { };
+	uint64_t value = 0;
+	for(size_t i=start_bit; i<(start_bit + length); i++) {
+		value = (value << 1) | packet[bit_remap(i)];
+	}
+	return value;
+}
+
+/* Symbol-at-a-time ManchesterDecoder::read(). */
+static uint32_t read_manchester_bitwise(const ManchesterDecoder& decoder, const size_t start_index, const size_t length) {
+	uint32_t value = 0;
+	for(size_t i=start_index; i<(start_index + length); i++) {
+		value = (value << 1) | decoder[i].value;
+	}
+	return value;
+}
+
+static size_t failures = 0;
+
+static void fail(const char* const what, const size_t size, const size_t start, const size_t length, const uint64_t expected, const uint64_t actual) {
+	if( failures < 10 ) {
+		fprintf(stderr, "%s: size %zu, field %zu+%zu: expected %016llx, got %016llx\n",
+			what, size, start, length,
+			static_cast<unsigned long long>(expected),
+			static_cast<unsigned long long>(actual)
+		);
+	}
+	failures++;
+}
+
+template<typename BitRemap>
+static void check_field_reader(const char* const what, const baseband::PacketView& packet) {
+	const FieldReader<baseband::PacketView, BitRemap> reader { packet };
+	for(size_t start=0; start<(packet.size() + 72); start++) {
+		for(size_t length=0; length<=64; length++) {
+			const auto expected = read_bitwise<BitRemap>(packet, start, length);
+			const auto actual = reader.read64(start, length);
+			if( actual != expected ) {
+				fail(what, packet.size(), start, length, expected, actual);
+			}
+			if( length <= 32 ) {
+				const uint32_t actual32 = reader.read(start, length);
+				if( actual32 != expected ) {
+					fail(what, packet.size(), start, length, expected, actual32);
+				}
+			}
+		}
+	}
+}
+
+static void check_manchester(const baseband::PacketView& packet, const size_t sense) {
+	const ManchesterDecoder decoder { packet, sense };
+	for(size_t start=0; start<(decoder.symbols_count() + 36); start++) {
+		for(size_t length=0; length<=32; length++) {
+			const auto expected = read_manchester_bitwise(decoder, start, length);
+			const auto actual = decoder.read(start, length);
+			if( actual != expected ) {
+				fail(sense ? "Manchester sense 1" : "Manchester sense 0", packet.size(), start, length, expected, actual);
+			}
+		}
+	}
+}
+
+int main() {
+	std::mt19937 rng { 1 };
+
+	/* Every short length, then a few up to the packet capacity. */
+	for(size_t trial=0; trial<200; trial++) {
+		const size_t size = (trial < 136) ? trial : (rng() % (baseband::Packet::capacity_bits + 1));
+
+		/* Fill the whole buffer first, so bits past the size are set too. */
+		baseband::Packet packet;
+		for(size_t i=0; i<baseband::Packet::capacity_bits; i++) {
+			packet.add(rng() & 1);
+		}
+		packet.clear();
+		for(size_t i=0; i<size; i++) {
+			packet.add(rng() & 1);
+		}
+
+		const baseband::PacketView view { packet };
+		check_field_reader<BitRemapNone>("BitRemapNone", view);
+		check_field_reader<BitRemapByteReverse>("BitRemapByteReverse", view);
+		check_manchester(view, 0);
+		check_manchester(view, 1);
+	}
+
+	if( failures ) {
+		fprintf(stderr, "%zu mismatches\n", failures);
+		return 1;
+	}
+
+	printf("packed reads match bitwise reads\n");
+	return 0;
+}
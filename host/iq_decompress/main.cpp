@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "iq_compress.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <array>
+#include <vector>
+
+#include <getopt.h>
+
+static void usage(const char* const program) {
+	fprintf(stderr,
+		"usage: %s [options] <input.Z16> <output.C16>\n"
+		"\n"
+		"Decodes a compressed capture back to interleaved int16 I/Q. Blocks the\n"
+		"capture dropped are filled with zeros, to keep the timing. A summary\n"
+		"goes to stderr.\n"
+		"\n"
+		"  -n             don't fill dropped blocks\n",
+		program
+	);
+}
+
+int main(int argc, char* argv[]) {
+	bool fill_dropped = true;
+
+	int opt;
+	while( (opt = getopt(argc, argv, "nh")) != -1 ) {
+		switch(opt) {
+		case 'n': fill_dropped = false;	break;
+
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if( optind != (argc - 2) ) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	FILE* const input = fopen(argv[optind], "rb");
+	if( input == nullptr ) {
+		perror(argv[optind]);
+		return 1;
+	}
+
+	FILE* const output = fopen(argv[optind + 1], "wb");
+	if( output == nullptr ) {
+		perror(argv[optind + 1]);
+		fclose(input);
+		return 1;
+	}
+
+	/* The input, read whole. Captures are truncated to what was written. */
+	std::vector<uint8_t> data;
+	std::array<uint8_t, 65536> chunk;
+	size_t chunk_size;
+	while( (chunk_size = fread(chunk.data(), 1, chunk.size(), input)) > 0 ) {
+		data.insert(data.end(), chunk.begin(), chunk.begin() + chunk_size);
+	}
+	fclose(input);
+
+	std::array<complex16_t, iq_compress::block_samples> samples;
+	const std::array<complex16_t, iq_compress::block_samples> zeros { };
+	uint64_t samples_written = 0;
+	size_t blocks = 0;
+	size_t blocks_dropped = 0;
+	size_t bytes_skipped = 0;
+	uint16_t sequence_next = 0;
+
+	size_t offset = 0;
+	while( (offset + sizeof(iq_compress::BlockHeader)) <= data.size() ) {
+		iq_compress::BlockHeader header;
+		memcpy(&header, &data[offset], sizeof(header));
+
+		const auto payload_offset = offset + sizeof(header);
+		const bool valid =
+			(header.sync == iq_compress::block_sync) &&
+			(header.payload_size <= (iq_compress::block_size_max - sizeof(header))) &&
+			((payload_offset + header.payload_size) <= data.size()) &&
+			iq_compress::decode(header, &data[payload_offset], samples.data());
+		if( !valid ) {
+			/* Damaged or cut short. Look for the next block. */
+			offset++;
+			bytes_skipped++;
+			continue;
+		}
+
+		/* Dropped blocks are whole DMA transfers of the channel, full size. */
+		const uint16_t dropped = header.sequence - sequence_next;
+		blocks_dropped += dropped;
+		if( fill_dropped ) {
+			for(size_t i=0; i<dropped; i++) {
+				fwrite(zeros.data(), sizeof(complex16_t), zeros.size(), output);
+				samples_written += zeros.size();
+			}
+		}
+
+		if( fwrite(samples.data(), sizeof(complex16_t), header.sample_count, output) != header.sample_count ) {
+			perror(argv[optind + 1]);
+			fclose(output);
+			return 1;
+		}
+		samples_written += header.sample_count;
+
+		sequence_next = header.sequence + 1;
+		offset = payload_offset + header.payload_size;
+		blocks++;
+	}
+	bytes_skipped += data.size() - offset;
+
+	if( fclose(output) != 0 ) {
+		perror(argv[optind + 1]);
+		return 1;
+	}
+
+	const uint64_t bytes_decoded = samples_written * sizeof(complex16_t);
+	fprintf(stderr, "blocks=%zu dropped=%zu skipped_bytes=%zu samples=%llu ratio=%.3f\n",
+		blocks, blocks_dropped, bytes_skipped,
+		static_cast<unsigned long long>(samples_written),
+		bytes_decoded ? static_cast<double>(data.size()) / bytes_decoded : 0.0
+	);
+
+	return 0;
+}
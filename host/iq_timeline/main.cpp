@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#include "capture_index.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <getopt.h>
+
+static void usage(const char* const program) {
+	fprintf(stderr,
+		"usage: %s [options] <capture.IDX> [<capture> <output>]\n"
+		"\n"
+		"Lists where a capture dropped samples, from its index. Given the capture,\n"
+		"writes it to <output> with the dropped samples put back as zeros, so\n"
+		"sample n of the output is at n / sampling_rate seconds from the start.\n"
+		"Compressed captures keep their timing with iq_decompress instead.\n"
+		"\n"
+		"  -q             only the summary\n",
+		program
+	);
+}
+
+static void print_rtc(const capture_index::Record& record) {
+	if( record.rtc_date == 0 ) {
+		printf("                   ");
+	} else {
+		printf("%04u-%02u-%02u %02u:%02u:%02u",
+			(record.rtc_date >> 16) & 0xfff, (record.rtc_date >> 8) & 0x0f, record.rtc_date & 0x1f,
+			(record.rtc_time >> 16) & 0x1f, (record.rtc_time >> 8) & 0x3f, record.rtc_time & 0x3f
+		);
+	}
+}
+
+/* Copies size bytes from input to output, or zeros if input is null. */
+static bool copy(FILE* const input, FILE* const output, uint64_t size) {
+	std::array<uint8_t, 65536> data;
+	if( input == nullptr ) {
+		data.fill(0);
+	}
+	while( size > 0 ) {
+		const size_t chunk = std::min<uint64_t>(size, data.size());
+		if( input && (fread(data.data(), 1, chunk, input) != chunk) ) {
+			return false;
+		}
+		if( fwrite(data.data(), 1, chunk, output) != chunk ) {
+			return false;
+		}
+		size -= chunk;
+	}
+	return true;
+}
+
+int main(int argc, char* argv[]) {
+	bool quiet = false;
+
+	int opt;
+	while( (opt = getopt(argc, argv, "qh")) != -1 ) {
+		switch(opt) {
+		case 'q': quiet = true;	break;
+
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	const auto arguments = argc - optind;
+	if( (arguments != 1) && (arguments != 3) ) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	FILE* const index = fopen(argv[optind], "rb");
+	if( index == nullptr ) {
+		perror(argv[optind]);
+		return 1;
+	}
+
+	capture_index::Header header;
+	if( (fread(&header, sizeof(header), 1, index) != 1) ||
+	    (header.magic != capture_index::magic) ||
+	    (header.version != capture_index::version) ||
+	    (header.record_size != sizeof(capture_index::Record)) ) {
+		fprintf(stderr, "%s: not a capture index\n", argv[optind]);
+		fclose(index);
+		return 1;
+	}
+
+	std::vector<capture_index::Record> records;
+	capture_index::Record record;
+	while( fread(&record, sizeof(record), 1, index) == 1 ) {
+		records.push_back(record);
+	}
+	fclose(index);
+
+	/* Without an end record, the capture didn't stop cleanly. Its index
+	 * holds the drops up to its last record.
+	 */
+	const bool ended = !records.empty() && (records.back().flags & capture_index::flag_end);
+
+	const auto bytes_per_sample = header.bytes_per_sample;
+	const auto samples = [bytes_per_sample](const uint64_t bytes) -> double {
+		return bytes_per_sample ? static_cast<double>(bytes) / bytes_per_sample : static_cast<double>(bytes);
+	};
+	const auto unit = bytes_per_sample ? "samples" : "bytes";
+
+	if( !quiet ) {
+		printf("%8s  %-19s  %14s  %14s  %14s  %10s\n",
+			"sequence", "rtc", "file_offset", "stream_offset", "lost_before", "at_seconds"
+		);
+	}
+
+	uint64_t lost_total = 0;
+	size_t gaps = 0;
+	for(const auto& r : records) {
+		const auto lost = (r.stream_offset - r.file_offset) - lost_total;
+		lost_total += lost;
+		gaps += (lost > 0) ? 1 : 0;
+
+		if( !quiet ) {
+			printf("%8u  ", r.sequence);
+			print_rtc(r);
+			printf("  %14.0f  %14.0f  %14.0f  %10.3f%s\n",
+				samples(r.file_offset), samples(r.stream_offset), samples(lost),
+				(bytes_per_sample && header.sampling_rate) ? samples(r.stream_offset) / header.sampling_rate : 0.0,
+				(r.flags & capture_index::flag_end) ? "  end" : ""
+			);
+		}
+	}
+
+	const uint64_t stream_size = records.empty() ? 0 : records.back().stream_offset;
+	printf("sampling_rate=%u bytes_per_sample=%u %s: stream=%.0f lost=%.0f (%.3f%%) in %zu gaps%s\n",
+		header.sampling_rate, bytes_per_sample, unit,
+		samples(stream_size), samples(lost_total),
+		stream_size ? 100.0 * lost_total / stream_size : 0.0,
+		gaps,
+		ended ? "" : ", no end record"
+	);
+
+	if( arguments == 1 ) {
+		return 0;
+	}
+
+	if( bytes_per_sample == 0 ) {
+		fprintf(stderr, "compressed capture: use iq_decompress\n");
+		return 1;
+	}
+
+	FILE* const input = fopen(argv[optind + 1], "rb");
+	if( input == nullptr ) {
+		perror(argv[optind + 1]);
+		return 1;
+	}
+	FILE* const output = fopen(argv[optind + 2], "wb");
+	if( output == nullptr ) {
+		perror(argv[optind + 2]);
+		fclose(input);
+		return 1;
+	}
+
+	/* Each record's span of the file runs to the next record's. Gaps go
+	 * in before the record they were lost before.
+	 */
+	bool ok = true;
+	uint64_t lost_written = 0;
+	for(size_t i=0; ok && (i<records.size()); i++) {
+		const auto& r = records[i];
+		const auto lost = (r.stream_offset - r.file_offset) - lost_written;
+		lost_written += lost;
+		ok = copy(nullptr, output, lost);
+
+		const uint64_t file_end = (i + 1 < records.size()) ? records[i + 1].file_offset : r.file_offset;
+		if( ok && (file_end > r.file_offset) ) {
+			ok = copy(input, output, file_end - r.file_offset);
+		}
+	}
+
+	/* Without an end record, the rest of the file follows on. */
+	if( ok && !ended ) {
+		std::array<uint8_t, 65536> data;
+		size_t n;
+		while( ok && ((n = fread(data.data(), 1, data.size(), input)) > 0) ) {
+			ok = (fwrite(data.data(), 1, n, output) == n);
+		}
+	}
+
+	fclose(input);
+	if( (fclose(output) != 0) || !ok ) {
+		fprintf(stderr, "%s: copy failed\n", argv[optind + 2]);
+		return 1;
+	}
+
+	return 0;
+}
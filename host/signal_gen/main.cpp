@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "signal_gen.hpp"
+#include "protocols.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <array>
+#include <string>
+
+#include <getopt.h>
+
+static void usage(const char* const program) {
+	std::string names;
+	for(const auto& protocol : signal_gen::protocols()) {
+		names += " " + protocol.name;
+	}
+
+	fprintf(stderr,
+		"usage: %s [options] <protocol> <output>\n"
+		"\n"
+		"Writes interleaved int8 I/Q as the radio would give it to the protocol's\n"
+		"processor, for baseband_sim_<processor>. A summary goes to stderr.\n"
+		"\n"
+		"protocols:%s\n"
+		"\n"
+		"  -d seconds     duration (10)\n"
+		"  -r rate        packets per second (10)\n"
+		"  -S dB          carrier to noise ratio in the sampled bandwidth, or inf (30)\n"
+		"  -o Hz          frequency offset from the processor's channel (0)\n"
+		"  -p ppm         transmitter symbol clock error (0)\n"
+		"  -l level       RMS of carrier plus noise, LSBs (32)\n"
+		"  -t Hz          tone frequency (1000)\n"
+		"  -k value       FM deviation in Hz (2500), or AM depth (0.5)\n"
+		"  -s seed        random seed (1)\n",
+		program, names.c_str()
+	);
+}
+
+int main(int argc, char* argv[]) {
+	signal_gen::Parameters parameters;
+	float duration = 10.0f;
+	float snr_db = 30.0f;
+	float frequency_offset = 0.0f;
+	float level = 32.0f;
+	float modulation = NAN;
+
+	int opt;
+	while( (opt = getopt(argc, argv, "d:r:S:o:p:l:t:k:s:h")) != -1 ) {
+		switch(opt) {
+		case 'd': duration = strtof(optarg, nullptr);						break;
+		case 'r': parameters.packets_per_second = strtof(optarg, nullptr);	break;
+		case 'S': snr_db = strtof(optarg, nullptr);							break;
+		case 'o': frequency_offset = strtof(optarg, nullptr);				break;
+		case 'p': parameters.clock_error_ppm = strtof(optarg, nullptr);		break;
+		case 'l': level = strtof(optarg, nullptr);							break;
+		case 't': parameters.tone_frequency = strtof(optarg, nullptr);		break;
+		case 'k': modulation = strtof(optarg, nullptr);						break;
+		case 's': parameters.seed = strtoul(optarg, nullptr, 0);			break;
+
+		default:
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if( optind != (argc - 2) ) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	const auto protocol = signal_gen::find_protocol(argv[optind]);
+	if( protocol == nullptr ) {
+		fprintf(stderr, "unknown protocol \"%s\"\n", argv[optind]);
+		return 1;
+	}
+	if( !(parameters.packets_per_second > 0.0f) || !(duration > 0.0f) ) {
+		usage(argv[0]);
+		return 1;
+	}
+	if( !std::isnan(modulation) ) {
+		parameters.fm_deviation = modulation;
+		parameters.am_depth = modulation;
+	}
+
+	FILE* const output = fopen(argv[optind + 1], "wb");
+	if( output == nullptr ) {
+		perror(argv[optind + 1]);
+		return 1;
+	}
+
+	auto signal = protocol->make_signal(parameters);
+	signal_gen::Channel channel {
+		static_cast<float>(protocol->sampling_rate),
+		protocol->channel_frequency + frequency_offset,
+		snr_db, level, parameters.seed + 1
+	};
+
+	std::array<signal_gen::sample_t, 2048> clean;
+	std::array<complex8_t, clean.size()> quantized;
+	const uint64_t samples = static_cast<uint64_t>(duration * protocol->sampling_rate);
+	for(uint64_t n=0; n<samples; n+=clean.size()) {
+		const size_t count = std::min<uint64_t>(clean.size(), samples - n);
+		signal->generate(clean.data(), count);
+		channel.process(clean.data(), quantized.data(), count);
+		if( fwrite(quantized.data(), sizeof(complex8_t), count, output) != count ) {
+			perror(argv[optind + 1]);
+			fclose(output);
+			return 1;
+		}
+	}
+	fclose(output);
+
+	const auto packet_signal = dynamic_cast<const signal_gen::PacketSignal*>(signal.get());
+	fprintf(stderr, "protocol=%s processor=%s sampling_rate=%u seconds=%.3f packets=%zu snr_db=%.1f",
+		protocol->name.c_str(), protocol->processor.c_str(), protocol->sampling_rate,
+		static_cast<double>(samples) / protocol->sampling_rate,
+		packet_signal ? packet_signal->packets() : 0,
+		snr_db
+	);
+	if( protocol->bit_rate > 0 ) {
+		fprintf(stderr, " ebn0_db=%.1f", snr_db + 10.0f * std::log10(protocol->sampling_rate / protocol->bit_rate));
+	}
+	fprintf(stderr, " clipped=%zu\n", channel.clipped());
+
+	return 0;
+}
@@ -0,0 +1,366 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "protocols.hpp"
+
+#include "crc.hpp"
+
+#include <array>
+
+namespace signal_gen {
+
+namespace {
+
+class Bits {
+public:
+	/* MSB first. */
+	void append(const uint32_t value, const size_t count) {
+		for(size_t i=count; i>0; i--) {
+			bits.push_back((value >> (i - 1)) & 1);
+		}
+	}
+
+	void append(const std::string& pattern) {
+		for(const auto c : pattern) {
+			bits.push_back((c == '1') ? 1 : 0);
+		}
+	}
+
+	void append_repeated(const std::string& pattern, const size_t count) {
+		for(size_t i=0; i<count; i++) {
+			append(pattern);
+		}
+	}
+
+	/* 1 as 10, 0 as 01, as ManchesterDecoder with sense 0 expects. */
+	void append_manchester(const std::vector<uint8_t>& data) {
+		for(const auto bit : data) {
+			bits.push_back(bit ? 1 : 0);
+			bits.push_back(bit ? 0 : 1);
+		}
+	}
+
+	template<typename T>
+	void append_bytes(const T& bytes) {
+		for(const auto byte : bytes) {
+			append(byte, 8);
+		}
+	}
+
+	const std::vector<uint8_t>& get() const {
+		return bits;
+	}
+
+	size_t size() const {
+		return bits.size();
+	}
+
+	uint8_t operator[](const size_t index) const {
+		return bits[index];
+	}
+
+private:
+	std::vector<uint8_t> bits { };
+};
+
+/* Not std::uniform_int_distribution, whose output differs between
+ * standard libraries. The modulo bias doesn't matter here.
+ */
+uint32_t random(std::mt19937& engine, const uint32_t count) {
+	return engine() % count;
+}
+
+template<size_t N>
+void random_fill(std::mt19937& engine, std::array<uint8_t, N>& bytes) {
+	for(auto& byte : bytes) {
+		byte = engine();
+	}
+}
+
+std::unique_ptr<Signal> make_packet_signal(
+	const uint32_t sampling_rate,
+	const Modem& modem,
+	Encoder encoder,
+	const Parameters& parameters
+) {
+	return std::make_unique<PacketSignal>(
+		sampling_rate, modem, encoder,
+		parameters.packets_per_second, parameters.clock_error_ppm, parameters.seed
+	);
+}
+
+} /* namespace */
+
+/* AIS *******************************************************************/
+
+std::vector<uint8_t> encode_ais_position_report(std::mt19937& engine) {
+	Bits fields;
+	fields.append(1, 6);										// Message ID
+	fields.append(0, 2);										// Repeat indicator
+	fields.append(200000000 + random(engine, 600000000), 30);	// MMSI
+	fields.append(random(engine, 9), 4);						// Navigational status
+	fields.append(0x80, 8);										// Rate of turn: not available
+	fields.append(random(engine, 1023), 10);					// Speed over ground
+	fields.append(random(engine, 2), 1);						// Position accuracy
+	fields.append(random(engine, 360 * 600000) - 180 * 600000, 28);	// Longitude, 1/10000 minute
+	fields.append(random(engine, 180 * 600000) - 90 * 600000, 27);	// Latitude
+	fields.append(random(engine, 3600), 12);					// Course over ground
+	fields.append(random(engine, 360), 9);						// True heading
+	fields.append(random(engine, 60), 6);						// Time stamp
+	fields.append(0, 2 + 3 + 1);								// Maneuver, spare, RAIM
+	fields.append(random(engine, 1 << 19), 19);					// Radio status
+
+	/* Bytes go on the air LSB first. ais::Packet reads fields through
+	 * BitRemapByteReverse, and the FCS over the bits in air order.
+	 */
+	Bits data;
+	CRC<16> fcs { 0x1021, 0xffff, 0xffff };
+	for(size_t i=0; i<fields.size(); i++) {
+		const auto bit = fields[i ^ 7];
+		data.append(bit, 1);
+		fcs.process_bit(bit);
+	}
+	data.append(fcs.checksum(), 16);
+
+	Bits frame;
+	frame.append("11111111");				// Ramp up
+	frame.append_repeated("01", 12);		// Training sequence
+	frame.append("01111110");				// Start flag
+	size_t ones = 0;
+	for(const auto bit : data.get()) {
+		frame.append(bit, 1);
+		ones = bit ? (ones + 1) : 0;
+		if( ones == 5 ) {
+			frame.append(0, 1);
+			ones = 0;
+		}
+	}
+	frame.append("01111110");				// End flag
+	frame.append("11111111");				// Buffer
+
+	/* NRZI: 0 is a change of level, 1 is no change. */
+	std::vector<uint8_t> symbols;
+	symbols.reserve(frame.size());
+	uint8_t level = 0;
+	for(const auto bit : frame.get()) {
+		level ^= bit ? 0 : 1;
+		symbols.push_back(level);
+	}
+	return symbols;
+}
+
+/* ERT *******************************************************************/
+
+std::vector<uint8_t> encode_ert_scm(std::mt19937& engine) {
+	const uint32_t id = random(engine, 1 << 26);
+
+	Bits payload;
+	payload.append(id >> 24, 2);					// ID, MSBs
+	payload.append(0, 1);							// Reserved
+	payload.append(random(engine, 4), 2);			// Physical tamper
+	payload.append(random(engine, 16), 4);			// Commodity type
+	payload.append(random(engine, 4), 2);			// Encoder tamper
+	payload.append(random(engine, 1 << 24), 24);	// Consumption
+	payload.append(id & 0xffffff, 24);				// ID, LSBs
+
+	CRC<16> bch { 0x6f63 };
+	for(const auto bit : payload.get()) {
+		bch.process_bit(bit);
+	}
+	payload.append(bch.checksum(), 16);
+
+	Bits bits;
+	bits.append(0x1f2a60, 21);						// Preamble and sync
+	for(const auto bit : payload.get()) {
+		bits.append(bit, 1);
+	}
+
+	Bits chips;
+	chips.append_manchester(bits.get());
+	return chips.get();
+}
+
+std::vector<uint8_t> encode_ert_idm(std::mt19937& engine) {
+	std::array<uint8_t, 88> bytes;
+	random_fill(engine, bytes);
+	bytes[0] = 0x1c;								// Packet type
+	bytes[1] = 0x5c;								// Packet length
+	bytes[2] = 0xc6;								// Hamming code
+	bytes[3] = 0x04;								// Application version
+	bytes[4] &= 0x0f;								// Commodity type
+
+	/* Sent complemented, so the CRC over the whole packet leaves 0x1d0f,
+	 * which ert::Packet's final XOR takes to zero.
+	 */
+	CRC<16> crc { 0x1021, 0xffff };
+	crc.process_bytes(bytes.data(), bytes.size() - 2);
+	const uint16_t fcs = ~crc.checksum();
+	bytes[86] = fcs >> 8;
+	bytes[87] = fcs & 0xff;
+
+	Bits bits;
+	bits.append(0x555516a3, 32);					// Preamble and sync
+	bits.append_bytes(bytes);
+
+	Bits chips;
+	chips.append_manchester(bits.get());
+	return chips.get();
+}
+
+/* TPMS ******************************************************************/
+
+std::vector<uint8_t> encode_tpms_fsk_19k2_schrader(std::mt19937& engine) {
+	/* FLM_80: ID in bytes 1-4, pressure in 6, temperature in 7, and a CRC
+	 * over bytes 1-8 in 9.
+	 */
+	std::array<uint8_t, 10> bytes;
+	random_fill(engine, bytes);
+
+	CRC<8> crc { 0x01, 0x00 };
+	crc.process_bytes(&bytes[1], 8);
+	bytes[9] = crc.checksum();
+
+	Bits data;
+	data.append_bytes(bytes);
+
+	Bits chips;
+	chips.append_repeated("01", 20);				// Preamble
+	chips.append("10");
+	chips.append_manchester(data.get());
+	return chips.get();
+}
+
+std::vector<uint8_t> encode_tpms_ook_8k192_schrader(std::mt19937& engine) {
+	Bits data;
+	data.append(random(engine, 8), 3);				// Function code
+	data.append(random(engine, 1 << 24), 24);		// ID
+	data.append(random(engine, 256), 8);			// Pressure
+
+	/* 2 LSBs of the first bit plus each following pair of bits, this
+	 * checksum included, are 0b11.
+	 */
+	uint32_t sum = data[0];
+	for(size_t i=1; i<data.size(); i+=2) {
+		sum += (data[i] << 1) | data[i + 1];
+	}
+	data.append((3 - sum) & 3, 2);
+
+	Bits chips;
+	chips.append("0000");
+	chips.append_repeated("11", 2);					// Preamble
+	chips.append_repeated("01", 14);
+	chips.append("1110");
+	chips.append_manchester(data.get());
+	return chips.get();
+}
+
+std::vector<uint8_t> encode_tpms_ook_8k4_schrader(std::mt19937& engine) {
+	/* Nibble 0x4 ends the preamble, so the byte checksum starts with it. */
+	std::array<uint8_t, 9> bytes;
+	random_fill(engine, bytes);
+	bytes[0] = (bytes[0] & 0x0f) | 0x40;
+
+	uint8_t checksum = 0;
+	for(const auto byte : bytes) {
+		checksum += byte;
+	}
+
+	Bits data;
+	data.append(bytes[0], 4);
+	for(size_t i=1; i<bytes.size(); i++) {
+		data.append(bytes[i], 8);
+	}
+	data.append(checksum, 8);
+
+	Bits chips;
+	chips.append("0000");
+	chips.append_repeated("01", 40);				// Preamble
+	chips.append("01100101");
+	chips.append_manchester(data.get());
+	return chips.get();
+}
+
+/* Protocols *************************************************************/
+
+const std::vector<Protocol>& protocols() {
+	static const std::vector<Protocol> table {
+		{
+			"ais", "ais", 2457600, 2457600 / 4, 9600,
+			[](const Parameters& p) {
+				return make_packet_signal(2457600, { Modulation::GMSK, 9600, 2400, 0.4f }, encode_ais_position_report, p);
+			}
+		},
+		{
+			"ert_scm", "ert", 4194304, 0, 16384,
+			[](const Parameters& p) {
+				return make_packet_signal(4194304, { Modulation::OOK, 32768, 0, 0 }, encode_ert_scm, p);
+			}
+		},
+		{
+			"ert_idm", "ert", 4194304, 0, 16384,
+			[](const Parameters& p) {
+				return make_packet_signal(4194304, { Modulation::OOK, 32768, 0, 0 }, encode_ert_idm, p);
+			}
+		},
+		{
+			"tpms_fsk_19k2", "tpms", 2457600, 2457600 / 4, 9600,
+			[](const Parameters& p) {
+				return make_packet_signal(2457600, { Modulation::FSK, 19200, 38400, 0 }, encode_tpms_fsk_19k2_schrader, p);
+			}
+		},
+		{
+			"tpms_ook_8k192", "tpms", 2457600, 2457600 / 4, 4096,
+			[](const Parameters& p) {
+				return make_packet_signal(2457600, { Modulation::OOK, 8192, 0, 0 }, encode_tpms_ook_8k192_schrader, p);
+			}
+		},
+		{
+			"tpms_ook_8k4", "tpms", 2457600, 2457600 / 4, 4200,
+			[](const Parameters& p) {
+				return make_packet_signal(2457600, { Modulation::OOK, 8400, 0, 0 }, encode_tpms_ook_8k4_schrader, p);
+			}
+		},
+		{
+			"nbfm", "nfm_audio", 3072000, 3072000 / 4, 0,
+			[](const Parameters& p) -> std::unique_ptr<Signal> {
+				return std::make_unique<ToneFM>(3072000, p.tone_frequency, p.fm_deviation);
+			}
+		},
+		{
+			"am", "am_audio", 3072000, 3072000 / 4, 0,
+			[](const Parameters& p) -> std::unique_ptr<Signal> {
+				return std::make_unique<ToneAM>(3072000, p.tone_frequency, p.am_depth);
+			}
+		},
+	};
+	return table;
+}
+
+const Protocol* find_protocol(const std::string& name) {
+	for(const auto& protocol : protocols()) {
+		if( protocol.name == name ) {
+			return &protocol;
+		}
+	}
+	return nullptr;
+}
+
+} /* namespace signal_gen */
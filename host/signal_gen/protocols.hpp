@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PROTOCOLS_H__
+#define __PROTOCOLS_H__
+
+#include "signal_gen.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace signal_gen {
+
+struct Parameters {
+	float packets_per_second { 10.0f };
+	/* Transmitter symbol clock error. */
+	float clock_error_ppm { 0.0f };
+	float tone_frequency { 1000.0f };
+	float fm_deviation { 2500.0f };
+	float am_depth { 0.5f };
+	uint32_t seed { 1 };
+};
+
+/* A transmission one of the receive processors decodes. */
+struct Protocol {
+	std::string name;
+	/* Processor that receives it: baseband/proc_<processor>.cpp. */
+	std::string processor;
+	uint32_t sampling_rate;
+	/* Where the processor expects the channel, relative to the center of
+	 * the sampled band: +fs/4 after an FS4 decimator, otherwise 0.
+	 */
+	float channel_frequency;
+	/* Information bits per second, for Eb/N0. 0 for tones. */
+	float bit_rate;
+	std::function<std::unique_ptr<Signal>(const Parameters&)> make_signal;
+};
+
+const std::vector<Protocol>& protocols();
+const Protocol* find_protocol(const std::string& name);
+
+/* Packet encoders, each giving the symbols of one packet, lead-in to
+ * trailer, as the protocol's modulator takes them.
+ */
+
+/* Type 1 position report. NRZI symbols for the GMSK modulator. */
+std::vector<uint8_t> encode_ais_position_report(std::mt19937& engine);
+
+/* Manchester chips, 1 for carrier on. */
+std::vector<uint8_t> encode_ert_scm(std::mt19937& engine);
+std::vector<uint8_t> encode_ert_idm(std::mt19937& engine);
+
+/* Manchester chips, 1 for the upper tone. 80-bit FLM packet with CRC. */
+std::vector<uint8_t> encode_tpms_fsk_19k2_schrader(std::mt19937& engine);
+
+/* Manchester chips, 1 for carrier on. */
+std::vector<uint8_t> encode_tpms_ook_8k192_schrader(std::mt19937& engine);
+std::vector<uint8_t> encode_tpms_ook_8k4_schrader(std::mt19937& engine);
+
+} /* namespace signal_gen */
+
+#endif/*__PROTOCOLS_H__*/
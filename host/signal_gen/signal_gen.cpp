@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "signal_gen.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+namespace signal_gen {
+
+constexpr double pi = 3.14159265358979323846;
+constexpr double two_pi = 2.0 * pi;
+
+/* GaussianNoise *********************************************************/
+
+GaussianNoise::GaussianNoise(
+	const uint32_t seed
+) : engine { seed }
+{
+}
+
+double GaussianNoise::uniform() {
+	/* (0, 1], so log() below is finite. */
+	return (static_cast<double>(engine()) + 1.0) / 4294967296.0;
+}
+
+float GaussianNoise::operator()() {
+	if( have_spare ) {
+		have_spare = false;
+		return spare;
+	}
+
+	const double r = std::sqrt(-2.0 * std::log(uniform()));
+	const double theta = two_pi * uniform();
+	spare = r * std::sin(theta);
+	have_spare = true;
+	return r * std::cos(theta);
+}
+
+/* ToneFM ****************************************************************/
+
+ToneFM::ToneFM(
+	const float sampling_rate,
+	const float tone_frequency,
+	const float deviation
+) : tone_increment { two_pi * tone_frequency / sampling_rate },
+	deviation_increment { two_pi * deviation / sampling_rate }
+{
+}
+
+void ToneFM::generate(sample_t* const p, const size_t count) {
+	for(size_t i=0; i<count; i++) {
+		carrier_phase = std::fmod(carrier_phase + deviation_increment * std::sin(tone_phase), two_pi);
+		tone_phase = std::fmod(tone_phase + tone_increment, two_pi);
+		p[i] = std::polar(1.0f, static_cast<float>(carrier_phase));
+	}
+}
+
+/* ToneAM ****************************************************************/
+
+ToneAM::ToneAM(
+	const float sampling_rate,
+	const float tone_frequency,
+	const float depth
+) : tone_increment { two_pi * tone_frequency / sampling_rate },
+	depth { depth }
+{
+}
+
+void ToneAM::generate(sample_t* const p, const size_t count) {
+	for(size_t i=0; i<count; i++) {
+		p[i] = { 1.0f + depth * static_cast<float>(std::sin(tone_phase)), 0.0f };
+		tone_phase = std::fmod(tone_phase + tone_increment, two_pi);
+	}
+}
+
+/* PacketSignal **********************************************************/
+
+PacketSignal::PacketSignal(
+	const float sampling_rate,
+	const Modem& modem,
+	Encoder encoder,
+	const float packets_per_second,
+	const float clock_error_ppm,
+	const uint32_t seed
+) : sampling_rate { sampling_rate },
+	modem(modem),
+	encoder { encoder },
+	samples_per_symbol { sampling_rate / (modem.symbol_rate * (1.0 + clock_error_ppm * 1e-6)) },
+	packet_interval { sampling_rate / packets_per_second },
+	engine { seed },
+	next_start { packet_interval / 2 }
+{
+}
+
+void PacketSignal::start_burst() {
+	symbols = encoder(engine);
+	burst_start = sample_index;
+	burst_end = burst_start + static_cast<uint64_t>(std::ceil(symbols.size() * samples_per_symbol));
+	next_start = std::max(next_start + packet_interval, static_cast<double>(burst_end));
+	phase = two_pi * (engine() / 4294967296.0);
+	packets_++;
+}
+
+float PacketSignal::frequency(const double t) const {
+	const int64_t n = static_cast<int64_t>(t);
+	const int64_t symbols_count = symbols.size();
+
+	if( modem.modulation == Modulation::FSK ) {
+		return symbols[n] ? modem.deviation : -modem.deviation;
+	}
+
+	/* Gaussian filtered rectangular pulse of one symbol centered on 0:
+	 * 0.5 * (erf(k * (t + 0.5)) - erf(k * (t - 0.5))), which is within 0.3%
+	 * of zero two symbols out at BT >= 0.3.
+	 */
+	const double k = pi * modem.bt * std::sqrt(2.0 / std::log(2.0));
+	double sum = 0.0;
+	for(int64_t j=std::max<int64_t>(n - 2, 0); j<=std::min(n + 2, symbols_count - 1); j++) {
+		const double x = t - j - 0.5;
+		const double pulse = 0.5 * (std::erf(k * (x + 0.5)) - std::erf(k * (x - 0.5)));
+		sum += symbols[j] ? pulse : -pulse;
+	}
+	return modem.deviation * sum;
+}
+
+void PacketSignal::generate(sample_t* const p, const size_t count) {
+	for(size_t i=0; i<count; i++, sample_index++) {
+		if( (sample_index >= burst_end) && (sample_index >= next_start) ) {
+			start_burst();
+		}
+
+		if( sample_index >= burst_end ) {
+			p[i] = { 0.0f, 0.0f };
+			continue;
+		}
+
+		const double t = (sample_index - burst_start) / samples_per_symbol;
+		if( modem.modulation == Modulation::OOK ) {
+			p[i] = symbols[static_cast<size_t>(t)] ? std::polar(1.0f, static_cast<float>(phase)) : sample_t { 0.0f, 0.0f };
+		} else {
+			phase = std::fmod(phase + two_pi * frequency(t) / sampling_rate, two_pi);
+			p[i] = std::polar(1.0f, static_cast<float>(phase));
+		}
+	}
+}
+
+/* Channel ***************************************************************/
+
+Channel::Channel(
+	const float sampling_rate,
+	const float frequency,
+	const float snr_db,
+	const float level,
+	const uint32_t seed
+) : phase_increment { two_pi * frequency / sampling_rate },
+	noise { seed }
+{
+	/* level^2 = carrier^2 + 2 * sigma^2, snr = carrier^2 / (2 * sigma^2) */
+	if( std::isinf(snr_db) ) {
+		carrier_amplitude = level;
+		noise_sigma = 0.0f;
+	} else {
+		const float snr = std::pow(10.0f, snr_db / 10.0f);
+		carrier_amplitude = level * std::sqrt(snr / (1.0f + snr));
+		noise_sigma = level / std::sqrt(2.0f * (1.0f + snr));
+	}
+}
+
+int8_t Channel::quantize(const float value) {
+	const float rounded = std::round(value);
+	if( rounded > std::numeric_limits<int8_t>::max() ) {
+		clipped_++;
+		return std::numeric_limits<int8_t>::max();
+	}
+	if( rounded < std::numeric_limits<int8_t>::min() ) {
+		clipped_++;
+		return std::numeric_limits<int8_t>::min();
+	}
+	return static_cast<int8_t>(rounded);
+}
+
+void Channel::process(const sample_t* const src, complex8_t* const dst, const size_t count) {
+	for(size_t i=0; i<count; i++) {
+		const auto rotation = std::polar(carrier_amplitude, static_cast<float>(phase));
+		phase = std::fmod(phase + phase_increment, two_pi);
+
+		const auto s = src[i] * rotation;
+		dst[i] = {
+			quantize(s.real() + noise_sigma * noise()),
+			quantize(s.imag() + noise_sigma * noise())
+		};
+	}
+}
+
+} /* namespace signal_gen */
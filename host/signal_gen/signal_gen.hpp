@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2014 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __SIGNAL_GEN_H__
+#define __SIGNAL_GEN_H__
+
+#include "complex.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <complex>
+#include <functional>
+#include <random>
+#include <vector>
+
+/* Synthetic baseband for running the receive processors on the host.
+ *
+ * A Signal is a transmitter's complex envelope at unit carrier amplitude,
+ * centered on 0Hz. A Channel moves it to the frequency the processor
+ * expects plus an offset, adds white Gaussian noise at a carrier to noise
+ * ratio, and quantizes it to complex8_t as the radio would.
+ *
+ * Everything random comes from seeded mt19937 engines, and the Gaussian
+ * draws don't depend on the standard library's distributions, so the same
+ * arguments give the same samples on every host.
+ */
+
+namespace signal_gen {
+
+using sample_t = std::complex<float>;
+
+class Signal {
+public:
+	virtual ~Signal() = default;
+
+	virtual void generate(sample_t* const p, const size_t count) = 0;
+};
+
+/* Zero-mean, unit-variance Gaussian values (Box-Muller). */
+class GaussianNoise {
+public:
+	explicit GaussianNoise(const uint32_t seed);
+
+	float operator()();
+
+private:
+	std::mt19937 engine;
+	float spare { 0.0f };
+	bool have_spare { false };
+
+	double uniform();
+};
+
+/* Carrier frequency modulated by a sine tone. */
+class ToneFM : public Signal {
+public:
+	ToneFM(
+		const float sampling_rate,
+		const float tone_frequency,
+		const float deviation
+	);
+
+	void generate(sample_t* const p, const size_t count) override;
+
+private:
+	const double tone_increment;
+	const double deviation_increment;
+	double tone_phase { 0.0 };
+	double carrier_phase { 0.0 };
+};
+
+/* Carrier amplitude modulated by a sine tone, with depth in 0..1. */
+class ToneAM : public Signal {
+public:
+	ToneAM(
+		const float sampling_rate,
+		const float tone_frequency,
+		const float depth
+	);
+
+	void generate(sample_t* const p, const size_t count) override;
+
+private:
+	const double tone_increment;
+	const float depth;
+	double tone_phase { 0.0 };
+};
+
+enum class Modulation {
+	/* Gaussian filtered frequency pulses, e.g. AIS. */
+	GMSK,
+	/* Rectangular frequency pulses. */
+	FSK,
+	/* Carrier on for 1, off for 0. */
+	OOK,
+};
+
+struct Modem {
+	Modulation modulation;
+	float symbol_rate;
+	/* GMSK and FSK peak deviation, Hz. Symbol 1 is above the carrier. */
+	float deviation;
+	/* GMSK bandwidth-time product. */
+	float bt;
+};
+
+/* Symbols (one per element, 0 or 1) for one packet, content drawn from
+ * the engine.
+ */
+using Encoder = std::function<std::vector<uint8_t>(std::mt19937& engine)>;
+
+/* Packets from an Encoder as evenly spaced bursts, with nothing between
+ * them. Each burst starts at a random carrier phase. A packet due while the
+ * previous one is still on the air waits for it to finish.
+ */
+class PacketSignal : public Signal {
+public:
+	PacketSignal(
+		const float sampling_rate,
+		const Modem& modem,
+		Encoder encoder,
+		const float packets_per_second,
+		const float clock_error_ppm,
+		const uint32_t seed
+	);
+
+	void generate(sample_t* const p, const size_t count) override;
+
+	/* Packets started so far. */
+	size_t packets() const {
+		return packets_;
+	}
+
+private:
+	const float sampling_rate;
+	const Modem modem;
+	const Encoder encoder;
+	const double samples_per_symbol;
+	const double packet_interval;
+	std::mt19937 engine;
+
+	std::vector<uint8_t> symbols { };
+	double next_start;
+	uint64_t sample_index { 0 };
+	uint64_t burst_start { 0 };
+	uint64_t burst_end { 0 };
+	double phase { 0.0 };
+	size_t packets_ { 0 };
+
+	void start_burst();
+	float frequency(const double t) const;
+};
+
+/* What the radio does to a Signal: frequency translation, AWGN and
+ * quantization. The carrier and noise share a total RMS level, in LSBs, so
+ * the ADC range is used the same way at any SNR, as with AGC.
+ */
+class Channel {
+public:
+	Channel(
+		const float sampling_rate,
+		const float frequency,
+		const float snr_db,
+		const float level,
+		const uint32_t seed
+	);
+
+	void process(const sample_t* const src, complex8_t* const dst, const size_t count);
+
+	/* Sample components that hit the int8_t limits. */
+	size_t clipped() const {
+		return clipped_;
+	}
+
+private:
+	const double phase_increment;
+	float carrier_amplitude;
+	float noise_sigma;
+	GaussianNoise noise;
+	double phase { 0.0 };
+	size_t clipped_ { 0 };
+
+	int8_t quantize(const float value);
+};
+
+} /* namespace signal_gen */
+
+#endif/*__SIGNAL_GEN_H__*/